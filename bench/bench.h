@@ -0,0 +1,162 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <chrono>
+#include <cstdio>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <cstring>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Minimal timing helpers shared by the benchmark programs in this folder.
+ * Every benchmark is a standalone program: g++ -O2 -std=c++17 -I../include file.cpp
+ * (or bench_<file> in a CMake build).
+ */
+namespace sc_bench {
+
+	/**
+	 * runs setup() then fn() reps times and returns the best wall time of fn(), in nanoseconds.
+	 * Only fn() is timed, so setup() can rebuild the input that fn() consumes.
+	*/
+	template< typename Setup, typename Fn >
+	double best_of( int reps, Setup setup, Fn fn )
+	{
+		double best = 0;
+		for( int r = 0; r < reps; r++ )
+		{
+			setup();
+			auto start = std::chrono::steady_clock::now();
+			fn();
+			auto stop = std::chrono::steady_clock::now();
+			double ns = std::chrono::duration<double, std::nano>( stop - start ).count();
+			if( r == 0 || ns < best )
+				best = ns;
+		}
+		return best;
+	}
+
+	/**
+	 * prints one result line: name, total time and time per element.
+	*/
+	inline void report( const char* name, std::size_t n, double ns )
+	{
+		std::printf( "%-40s n=%-10zu %12.0f ns  %8.2f ns/op\n", name, n, ns, ns / n );
+	}
+
+	/// Number of calls to the global operator new (see SC_BENCH_COUNT_ALLOCATIONS).
+	inline std::size_t allocations = 0;
+
+	/**
+	 * One hardware event of the calling thread, read with perf_event_open (user space only). Opening fails
+	 * when the kernel does not allow it (kernel.perf_event_paranoid > 2, containers, other systems);
+	 * available() is then false and stop() returns -1.
+	*/
+	class perf_counter{
+		public:
+			perf_counter( unsigned type, unsigned long long config )
+			{
+#ifdef __linux__
+				perf_event_attr attr;
+				std::memset( &attr, 0, sizeof attr );
+				attr.size = sizeof attr;
+				attr.type = type;
+				attr.config = config;
+				attr.disabled = 1;
+				attr.exclude_kernel = 1;
+				attr.exclude_hv = 1;
+				m_fd = static_cast<int>( ::syscall( SYS_perf_event_open, &attr, 0, -1, -1, 0 ) );
+#else
+				(void) type;
+				(void) config;
+#endif
+			}
+
+			perf_counter( const perf_counter& ) = delete;
+			perf_counter& operator=( const perf_counter& ) = delete;
+
+			~perf_counter()
+			{
+#ifdef __linux__
+				if( m_fd >= 0 ) ::close( m_fd );
+#endif
+			}
+
+			bool available( void )const { return m_fd >= 0; }
+
+			void start( void )
+			{
+#ifdef __linux__
+				if( m_fd < 0 ) return;
+				::ioctl( m_fd, PERF_EVENT_IOC_RESET, 0 );
+				::ioctl( m_fd, PERF_EVENT_IOC_ENABLE, 0 );
+#endif
+			}
+
+			long long stop( void )
+			{
+				long long count = -1;
+#ifdef __linux__
+				if( m_fd < 0 ) return -1;
+				::ioctl( m_fd, PERF_EVENT_IOC_DISABLE, 0 );
+				if( ::read( m_fd, &count, sizeof count ) != sizeof count )
+					count = -1;
+#endif
+				return count;
+			}
+
+		private:
+			int m_fd = -1;
+	};
+
+	/**
+	 * keeps the compiler from optimizing away a value that is never read.
+	*/
+	template< typename T >
+	inline void do_not_optimize( const T& value )
+	{ asm volatile( "" : : "r,m"( value ) : "memory" ); }
+}
+
+/**
+ * A benchmark that defines SC_BENCH_COUNT_ALLOCATIONS before including this header replaces the global
+ * operator new/delete (plain, array and aligned forms) with versions that count into
+ * sc_bench::allocations. They all go through the two non-inlined functions below, so the compiler never
+ * sees a malloc'd pointer reach operator delete or a new'd one reach free (-Wmismatched-new-delete).
+*/
+#ifdef SC_BENCH_COUNT_ALLOCATIONS
+namespace sc_bench{
+	__attribute__(( noinline )) inline void* counted_alloc( std::size_t n, std::size_t align )
+	{
+		++allocations;
+		n = n ? n : 1;
+		void* p = ( align <= alignof(std::max_align_t) ) ? std::malloc( n )
+		                                                  : std::aligned_alloc( align, ( n + align - 1 ) / align * align );
+		if( p == nullptr )
+			throw std::bad_alloc();
+		return p;
+	}
+
+	__attribute__(( noinline )) inline void counted_free( void* p ) noexcept { std::free( p ); }
+}
+
+void* operator new( std::size_t n ) { return sc_bench::counted_alloc( n, 0 ); }
+void* operator new[]( std::size_t n ) { return sc_bench::counted_alloc( n, 0 ); }
+void* operator new( std::size_t n, std::align_val_t a ) { return sc_bench::counted_alloc( n, std::size_t( a ) ); }
+void* operator new[]( std::size_t n, std::align_val_t a ) { return sc_bench::counted_alloc( n, std::size_t( a ) ); }
+void operator delete( void* p ) noexcept { sc_bench::counted_free( p ); }
+void operator delete[]( void* p ) noexcept { sc_bench::counted_free( p ); }
+void operator delete( void* p, std::size_t ) noexcept { sc_bench::counted_free( p ); }
+void operator delete[]( void* p, std::size_t ) noexcept { sc_bench::counted_free( p ); }
+void operator delete( void* p, std::align_val_t ) noexcept { sc_bench::counted_free( p ); }
+void operator delete[]( void* p, std::align_val_t ) noexcept { sc_bench::counted_free( p ); }
+void operator delete( void* p, std::size_t, std::align_val_t ) noexcept { sc_bench::counted_free( p ); }
+void operator delete[]( void* p, std::size_t, std::align_val_t ) noexcept { sc_bench::counted_free( p ); }
+#endif
+
+#endif
@@ -0,0 +1,116 @@
+#include "bench.h"
+#include "vector.h"
+#include "bit_vector.h"
+#include "packed_vector.h"
+#include <cstdint>
+#include <random>
+
+/**
+ * 4M 20-bit IDs and 4M flags, stored plainly (sc::vector of uint32_t / bool) and packed
+ * (sc::packed_vector<20>, sc::bit_vector): bytes held, a full scan through operator[] and through
+ * unpack(), random reads, and the bit_vector queries (count, rank, select, with and without
+ * sc::rank_select).
+*/
+
+constexpr std::size_t n = 1 << 22;
+constexpr std::size_t probes = 1 << 16;
+
+int main()
+{
+	std::mt19937_64 rng( 42 );
+	sc::vector<std::uint32_t> ids;
+	sc::vector<bool> flags;
+	ids.reserve( n );
+	flags.reserve( n );
+	sc::packed_vector<20> packed;
+	sc::bit_vector<> bits;
+	for( std::size_t i = 0; i < n; i++ )
+	{
+		std::uint32_t id = static_cast<std::uint32_t>( rng() & 0xFFFFF );
+		bool flag = rng() % 3 == 0;
+		ids.push_back( id );
+		packed.push_back( id );
+		flags.push_back( flag );
+		bits.push_back( flag );
+	}
+	sc::vector<std::size_t> at;
+	at.reserve( probes );
+	for( std::size_t k = 0; k < probes; k++ )
+		at.push_back( rng() % n );
+
+	std::printf( "%-40s %10.2f MiB\n", "sc::vector<uint32_t> ids", ids.size() * 4 / 1048576.0 );
+	std::printf( "%-40s %10.2f MiB\n", "sc::packed_vector<20> ids", packed.size_in_bytes() / 1048576.0 );
+	std::printf( "%-40s %10.2f MiB\n", "sc::vector<bool> flags", flags.size() / 1048576.0 );
+	std::printf( "%-40s %10.2f MiB\n", "sc::bit_vector flags", bits.size_in_bytes() / 1048576.0 );
+
+	// Varredura completa.
+	sc_bench::report( "scan sc::vector<uint32_t>", n, sc_bench::best_of( 5, []{}, [&]{
+		std::uint64_t sum = 0;
+		for( std::size_t i = 0; i < n; i++ ) sum += ids[i];
+		sc_bench::do_not_optimize( sum );
+	} ) );
+	sc_bench::report( "scan packed_vector<20> operator[]", n, sc_bench::best_of( 5, []{}, [&]{
+		std::uint64_t sum = 0;
+		for( std::size_t i = 0; i < n; i++ ) sum += packed[i];
+		sc_bench::do_not_optimize( sum );
+	} ) );
+	sc_bench::report( "scan packed_vector<20> unpack (4096)", n, sc_bench::best_of( 5, []{}, [&]{
+		static std::uint32_t block[4096];
+		std::uint64_t sum = 0;
+		for( std::size_t i = 0; i < n; i += 4096 )
+		{
+			packed.unpack( i, 4096, block );
+			for( std::size_t j = 0; j < 4096; j++ ) sum += block[j];
+		}
+		sc_bench::do_not_optimize( sum );
+	} ) );
+	sc_bench::report( "unpack packed_vector<20> to sc::vector", n, sc_bench::best_of( 5, []{}, [&]{
+		sc::vector<std::uint32_t> out;
+		packed.unpack( out );
+		sc_bench::do_not_optimize( out.data() );
+	} ) );
+
+	// Leituras aleatórias.
+	sc_bench::report( "random reads sc::vector<uint32_t>", probes, sc_bench::best_of( 5, []{}, [&]{
+		std::uint64_t sum = 0;
+		for( std::size_t k = 0; k < probes; k++ ) sum += ids[at[k]];
+		sc_bench::do_not_optimize( sum );
+	} ) );
+	sc_bench::report( "random reads packed_vector<20>", probes, sc_bench::best_of( 5, []{}, [&]{
+		std::uint64_t sum = 0;
+		for( std::size_t k = 0; k < probes; k++ ) sum += packed[at[k]];
+		sc_bench::do_not_optimize( sum );
+	} ) );
+
+	// Consultas sobre os bits.
+	sc_bench::report( "count sc::vector<bool>", n, sc_bench::best_of( 5, []{}, [&]{
+		std::size_t c = 0;
+		for( std::size_t i = 0; i < n; i++ ) c += flags[i];
+		sc_bench::do_not_optimize( c );
+	} ) );
+	sc_bench::report( "count sc::bit_vector", n, sc_bench::best_of( 5, []{}, [&]{
+		sc_bench::do_not_optimize( bits.count() );
+	} ) );
+	sc_bench::report( "rank sc::bit_vector (scan)", 256, sc_bench::best_of( 3, []{}, [&]{
+		std::size_t r = 0;
+		for( std::size_t k = 0; k < 256; k++ ) r += bits.rank( at[k] );
+		sc_bench::do_not_optimize( r );
+	} ) );
+	sc::rank_select index( bits );
+	sc_bench::report( "rank sc::rank_select", probes, sc_bench::best_of( 5, []{}, [&]{
+		std::size_t r = 0;
+		for( std::size_t k = 0; k < probes; k++ ) r += index.rank( at[k] );
+		sc_bench::do_not_optimize( r );
+	} ) );
+	sc_bench::report( "select sc::bit_vector (scan)", 256, sc_bench::best_of( 3, []{}, [&]{
+		std::size_t r = 0;
+		for( std::size_t k = 0; k < 256; k++ ) r += bits.select( at[k] / 4 );
+		sc_bench::do_not_optimize( r );
+	} ) );
+	sc_bench::report( "select sc::rank_select", probes, sc_bench::best_of( 5, []{}, [&]{
+		std::size_t r = 0;
+		for( std::size_t k = 0; k < probes; k++ ) r += index.select( at[k] / 4 );
+		sc_bench::do_not_optimize( r );
+	} ) );
+	return 0;
+}
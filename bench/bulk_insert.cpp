@@ -0,0 +1,98 @@
+#include "bench.h"
+#include "vector.h"
+#include <algorithm>
+#include <list>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Batch merges: a sorted batch of 1K or 1M values is merged into a sorted list of 1M values.
+ * "insert loop" calls insert() once per value (every call shifts the tail; ints, 1K only), "inplace_merge" appends
+ * the batch and merges, and sc::vector::insert_at moves each old element once.
+ * The second group inserts a 1K/1M range from a std::list (forward iterators) in the middle.
+*/
+template< typename T, typename Make >
+void merge( std::size_t batch, Make make )
+{
+	const std::size_t n = 1000000;
+	std::mt19937 rng( 42 );
+	std::vector<T> base, add;
+	for( std::size_t i = 0; i < n; i++ )
+		base.push_back( make( rng() ) );
+	for( std::size_t i = 0; i < batch; i++ )
+		add.push_back( make( rng() ) );
+	std::sort( base.begin(), base.end() );
+	std::sort( add.begin(), add.end() );
+
+	char name[64];
+	sc::vector<T> v;
+	std::vector<T> sv;
+	if( batch <= 1000 && std::is_trivially_copyable<T>::value )
+	{
+		double ns = sc_bench::best_of( 3, [&]{ v.assign( base.begin(), base.end() ); },
+			[&]{
+				for( const T& x : add )
+					v.insert( std::upper_bound( v.cbegin(), v.cend(), x ), x );
+				sc_bench::do_not_optimize( v.size() );
+			} );
+		std::snprintf( name, sizeof name, "merge %zu insert loop", batch );
+		sc_bench::report( name, batch, ns );
+	}
+	double ns = sc_bench::best_of( 3, [&]{ sv.assign( base.begin(), base.end() ); },
+		[&]{
+			std::size_t mid = sv.size();
+			sv.insert( sv.end(), add.begin(), add.end() );
+			std::inplace_merge( sv.begin(), sv.begin() + mid, sv.end() );
+			sc_bench::do_not_optimize( sv.size() );
+		} );
+	std::snprintf( name, sizeof name, "merge %zu std inplace_merge", batch );
+	sc_bench::report( name, batch, ns );
+
+	std::vector<std::size_t> idx( batch );
+	ns = sc_bench::best_of( 3, [&]{ v.assign( base.begin(), base.end() ); },
+		[&]{
+			// Busca exponencial a partir do índice anterior: O(log gap) por valor.
+			std::size_t prev = 0;
+			for( std::size_t j = 0; j < batch; j++ )
+			{
+				std::size_t step = 1;
+				while( prev + step < v.size() && !( add[j] < v[prev + step] ) )
+					step *= 2;
+				prev = std::upper_bound( v.cbegin() + prev + step / 2, v.cbegin() + std::min( prev + step, v.size() ), add[j] ) - v.cbegin();
+				idx[j] = prev;
+			}
+			v.insert_at( idx.begin(), idx.end(), add.begin() );
+			sc_bench::do_not_optimize( v.size() );
+		} );
+	std::snprintf( name, sizeof name, "merge %zu sc insert_at", batch );
+	sc_bench::report( name, batch, ns );
+}
+
+template< typename V >
+void range_insert( const char* name, std::size_t batch )
+{
+	std::list<int> add;
+	for( std::size_t i = 0; i < batch; i++ )
+		add.push_back( static_cast<int>( i ) );
+	V v;
+	double ns = sc_bench::best_of( 5, [&]{ v = V(); for( int i = 0; i < 1000000; i++ ) v.push_back( i ); },
+		[&]{
+			v.insert( v.begin() + v.size() / 2, add.begin(), add.end() );
+			sc_bench::do_not_optimize( v.size() );
+		} );
+	sc_bench::report( name, batch, ns );
+}
+
+int main()
+{
+	for( std::size_t batch : { 1000u, 1000000u } )
+	{
+		merge<int>( batch, []( unsigned x ){ return static_cast<int>( x ); } );
+		merge<std::string>( batch, []( unsigned x ){ return std::to_string( x ); } );
+		range_insert< std::vector<int> >( "range insert std::vector", batch );
+		range_insert< sc::vector<int> >( "range insert sc::vector", batch );
+	}
+	return 0;
+}
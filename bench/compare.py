@@ -0,0 +1,84 @@
+#!/usr/bin/env python3
+"""Compares a run of bench_vector_vs_std (--json) against a stored baseline.
+
+    python3 bench/compare.py baseline.json current.json [--threshold 0.10] [--container sc::vector]
+
+A benchmark regresses when its ns/op grew by more than the threshold (10% by default) or when it now
+allocates more per op. Benchmarks missing from either file are listed but never fail the check.
+Exit status: 0 without regressions, 1 with regressions, 2 on bad input.
+"""
+import argparse
+import json
+import sys
+
+
+def fail(message):
+    print("compare.py: " + message, file=sys.stderr)
+    sys.exit(2)
+
+
+def load(path):
+    try:
+        with open(path) as f:
+            data = json.load(f)
+    except (OSError, ValueError) as e:
+        fail("cannot read %s: %s" % (path, e))
+    benchmarks = data.get("benchmarks") if isinstance(data, dict) else None
+    if not isinstance(benchmarks, list):
+        fail("%s: no \"benchmarks\" list" % path)
+    results = {}
+    for i, b in enumerate(benchmarks):
+        if not isinstance(b, dict):
+            fail("%s: benchmarks[%d] is not an object" % (path, i))
+        for field in ("name", "container"):
+            if not isinstance(b.get(field), str):
+                fail("%s: benchmarks[%d] has no string \"%s\"" % (path, i, field))
+        for field in ("ns_per_op", "allocations_per_op"):
+            value = b.get(field)
+            if isinstance(value, bool) or not isinstance(value, (int, float)):
+                fail("%s: benchmarks[%d] (%s) has no number \"%s\"" % (path, i, b["name"], field))
+        results[(b["name"], b["container"])] = b
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=0.10, help="allowed ns/op growth, as a fraction (default 0.10)")
+    parser.add_argument("--container", default=None, help="only compare this container (e.g. sc::vector)")
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    current = load(args.current)
+    regressions = []
+    improvements = []
+    for key in sorted(current):
+        if args.container and key[1] != args.container:
+            continue
+        if key not in baseline:
+            print("new       %-32s %-12s" % key)
+            continue
+        old, new = baseline[key], current[key]
+        ratio = new["ns_per_op"] / old["ns_per_op"] if old["ns_per_op"] > 0 else 1.0
+        line = "%-32s %-12s %10.2f -> %10.2f ns/op (%+6.1f%%)" % (key[0], key[1], old["ns_per_op"], new["ns_per_op"], (ratio - 1) * 100)
+        if new["allocations_per_op"] > old["allocations_per_op"] + 1e-9:
+            regressions.append(line + "  allocations/op %.3f -> %.3f" % (old["allocations_per_op"], new["allocations_per_op"]))
+        elif ratio > 1 + args.threshold:
+            regressions.append(line)
+        elif ratio < 1 - args.threshold:
+            improvements.append(line)
+    for key in sorted(set(baseline) - set(current)):
+        if not args.container or key[1] == args.container:
+            print("missing   %-32s %-12s" % key)
+
+    for line in improvements:
+        print("faster    " + line)
+    for line in regressions:
+        print("SLOWER    " + line)
+    print("%d regressions, %d improvements beyond %.0f%%" % (len(regressions), len(improvements), args.threshold * 100))
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,62 @@
+#include "bench.h"
+#include "vector.h"
+#include "concurrent_vector.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Multi-producer appends: every thread pushes n / threads results into one shared list, either a
+ * sc::vector behind a std::mutex or a sc::concurrent_vector. Every run starts from an empty list with
+ * no storage, so growth is timed too. Build with -pthread.
+*/
+struct result{
+	std::uint64_t key;
+	double value;
+};
+
+template< typename Reset, typename Push >
+double produce( unsigned threads, std::size_t n, Reset reset, Push push )
+{
+	return sc_bench::best_of( 3, reset,
+		[&]{
+			std::vector<std::thread> pool;
+			for( unsigned t = 0; t < threads; t++ )
+				pool.emplace_back( [&, t]{
+					for( std::size_t i = t; i < n; i += threads )
+						push( result{ i, double( i ) * 0.5 } );
+				} );
+			for( std::thread& th : pool )
+				th.join();
+		} );
+}
+
+int main()
+{
+	const std::size_t n = 4000000;
+	unsigned hw = std::max( 1u, std::thread::hardware_concurrency() );
+	for( unsigned threads : { 1u, 2u, 4u, 8u, hw } )
+	{
+		char label[64];
+		{
+			sc::vector<result> v;
+			std::mutex lock;
+			double ns = produce( threads, n, [&]{ v.clear(); v.shrink_to_fit(); }, [&]( const result& r ){
+				std::lock_guard<std::mutex> guard( lock );
+				v.push_back( r );
+			} );
+			std::snprintf( label, sizeof label, "mutex + sc::vector x%u", threads );
+			sc_bench::report( label, n, ns );
+		}
+		{
+			sc::concurrent_vector<result> v;
+			double ns = produce( threads, n, [&]{ v.clear(); }, [&]( const result& r ){ v.push_back( r ); } );
+			std::snprintf( label, sizeof label, "sc::concurrent_vector x%u", threads );
+			sc_bench::report( label, n, ns );
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,82 @@
+#include "bench.h"
+#include "vector.h"
+#include "cow_vector.h"
+#include <cstdint>
+#include <thread>
+
+/**
+ * A 1M-int table handed to 64 readers (one per request, worker or cached view), each reading it once:
+ * deep sc::vector copies against sc::cow_vector copies and snapshots, which share one buffer. Reports the
+ * time per fan-out and the bytes the readers' copies keep alive; then one writer updates the table while
+ * reader threads keep working on snapshots taken before the update.
+*/
+
+/// Bytes currently held through counting_allocator.
+static std::size_t live_bytes = 0;
+
+template< typename T >
+struct counting_allocator{
+	typedef T value_type;
+	counting_allocator( void ) = default;
+	template< typename U > counting_allocator( const counting_allocator<U>& ) {}
+	T* allocate( std::size_t n ) { live_bytes += n * sizeof(T); return std::allocator<T>().allocate( n ); }
+	void deallocate( T* p, std::size_t n ) { live_bytes -= n * sizeof(T); std::allocator<T>().deallocate( p, n ); }
+	friend bool operator==( const counting_allocator&, const counting_allocator& ) { return true; }
+	friend bool operator!=( const counting_allocator&, const counting_allocator& ) { return false; }
+};
+
+constexpr std::size_t n = 1000000;
+constexpr std::size_t readers = 64;
+
+template< typename Source, typename Copy, typename Take >
+void fan_out( const char* name, const Source& source, Take take )
+{
+	std::size_t held = 0;
+	double ns = sc_bench::best_of( 5, []{},
+		[&]{
+			sc::vector<Copy> copies;
+			copies.reserve( readers );
+			std::size_t before = live_bytes;
+			for( std::size_t r = 0; r < readers; r++ )
+				copies.push_back( take( source ) );
+			held = live_bytes - before;
+			std::uint64_t sum = 0;
+			for( std::size_t r = 0; r < readers; r++ )
+				sum += copies[r][( r * 7919 ) % n];
+			sc_bench::do_not_optimize( sum );
+		} );
+	std::printf( "%-34s %10.0f ns/fan-out  %8.2f MiB held by %zu readers\n", name, ns, held / 1048576.0, readers );
+}
+
+int main()
+{
+	typedef sc::vector<int, counting_allocator<int>> vec;
+	typedef sc::cow_vector<int, counting_allocator<int>> cow;
+
+	vec table;
+	table.assign( n, 1 );
+	cow shared( table.begin(), table.end() );
+
+	fan_out<vec, vec>( "sc::vector deep copies", table, []( const vec& v ) { return v; } );
+	fan_out<cow, cow>( "sc::cow_vector copies", shared, []( const cow& v ) { return v; } );
+	fan_out<cow, cow::snapshot>( "sc::cow_vector snapshots", shared, []( const cow& v ) { return v.get_snapshot(); } );
+
+	// Leitores em threads com snapshots, enquanto o escritor atualiza a tabela.
+	unsigned threads = std::max( 2u, std::thread::hardware_concurrency() );
+	double ns = sc_bench::best_of( 3, []{},
+		[&]{
+			sc::vector<std::thread> pool;
+			pool.reserve( threads );
+			for( unsigned t = 0; t < threads; t++ )
+				pool.emplace_back( [view = shared.get_snapshot()]{
+					std::uint64_t sum = 0;
+					for( int x : view ) sum += x;
+					sc_bench::do_not_optimize( sum );
+				} );
+			for( std::size_t i = 0; i < n; i += 4096 )
+				shared.edit( i ) += 1; // a primeira escrita copia uma vez; as demais são no lugar.
+			for( auto& t : pool ) t.join();
+		} );
+	std::printf( "%-34s %10.0f ns/round (%u reader threads, 1 writer)\n", "snapshot readers + writer", ns, threads );
+	return 0;
+}
@@ -0,0 +1,62 @@
+#include "bench.h"
+#include "vector.h"
+#include "devector.h"
+#include <deque>
+
+/**
+ * Work-queue patterns: push n items at the front, and a FIFO that pops
+ * the front and pushes the back n times on a queue holding n items.
+ * sc::vector::push_front/pop_front shift the whole array on every call.
+*/
+template< typename Q >
+void push_front( const char* name, std::size_t n )
+{
+	double ns = sc_bench::best_of( 3, []{},
+		[&]{
+			Q q;
+			for( std::size_t i = 0; i < n; i++ )
+				q.push_front( static_cast<int>( i ) );
+			sc_bench::do_not_optimize( q.front() );
+		} );
+	sc_bench::report( name, n, ns );
+}
+
+template< typename Q >
+void fifo( const char* name, std::size_t n )
+{
+	Q q;
+	for( std::size_t i = 0; i < n; i++ )
+		q.push_back( static_cast<int>( i ) );
+	double ns = sc_bench::best_of( 3, []{},
+		[&]{
+			for( std::size_t i = 0; i < n; i++ )
+			{
+				int v = q.front();
+				q.pop_front();
+				q.push_back( v + 1 );
+			}
+			sc_bench::do_not_optimize( q.back() );
+		} );
+	sc_bench::report( name, n, ns );
+}
+
+int main()
+{
+	for( std::size_t n : { 1000u, 100000u } )
+	{
+		push_front< sc::vector<int> >( "push_front sc::vector", n );
+		push_front< std::deque<int> >( "push_front std::deque", n );
+		push_front< sc::devector<int> >( "push_front sc::devector", n );
+		fifo< sc::vector<int> >( "fifo sc::vector", n );
+		fifo< std::deque<int> >( "fifo std::deque", n );
+		fifo< sc::devector<int> >( "fifo sc::devector", n );
+	}
+	for( std::size_t n : { 10000000u } )
+	{
+		push_front< std::deque<int> >( "push_front std::deque", n );
+		push_front< sc::devector<int> >( "push_front sc::devector", n );
+		fifo< std::deque<int> >( "fifo std::deque", n );
+		fifo< sc::devector<int> >( "fifo sc::devector", n );
+	}
+	return 0;
+}
@@ -0,0 +1,63 @@
+#include "bench.h"
+#include "vector.h"
+#include <algorithm>
+#include <string>
+
+/**
+ * Removes every 10th element of 10M ints (and of 1M short strings): sc::erase_if, erase_indices with the
+ * sorted positions, std::remove_if + erase(first, last), and an erase(pos) loop, which shifts the whole tail
+ * on every call and is therefore only run on 100k elements.
+*/
+template< typename T, typename Make >
+void run( const char* type, std::size_t n, Make make )
+{
+	sc::vector<T> v;
+	sc::vector<std::size_t> positions;
+	for( std::size_t i = 0; i < n; i += 10 )
+		positions.push_back( i );
+	auto fill = [&]( std::size_t count ){
+		v.clear();
+		for( std::size_t i = 0; i < count; i++ )
+			v.push_back( make( i ) );
+	};
+	char label[64];
+
+	std::snprintf( label, sizeof label, "sc::erase_if %s", type );
+	sc_bench::report( label, n, sc_bench::best_of( 5, [&]{ fill( n ); },
+		[&]{
+			std::size_t i = 0;
+			sc::erase_if( v, [&i]( const T& ){ return i++ % 10 == 0; } );
+			sc_bench::do_not_optimize( v.size() );
+		} ) );
+
+	std::snprintf( label, sizeof label, "erase_indices %s", type );
+	sc_bench::report( label, n, sc_bench::best_of( 5, [&]{ fill( n ); },
+		[&]{
+			v.erase_indices( positions.begin(), positions.end() );
+			sc_bench::do_not_optimize( v.size() );
+		} ) );
+
+	std::snprintf( label, sizeof label, "std::remove_if + erase %s", type );
+	sc_bench::report( label, n, sc_bench::best_of( 5, [&]{ fill( n ); },
+		[&]{
+			std::size_t i = 0;
+			v.erase( std::remove_if( v.begin(), v.end(), [&i]( const T& ){ return i++ % 10 == 0; } ), v.end() );
+			sc_bench::do_not_optimize( v.size() );
+		} ) );
+
+	const std::size_t small = 100000;
+	std::snprintf( label, sizeof label, "erase(pos) loop %s", type );
+	sc_bench::report( label, small, sc_bench::best_of( 3, [&]{ fill( small ); },
+		[&]{
+			for( std::size_t i = small; i > 0; i -= 10 )
+				v.erase( v.begin() + ( i - 10 ) );
+			sc_bench::do_not_optimize( v.size() );
+		} ) );
+}
+
+int main()
+{
+	run<int>( "int", 10000000, []( std::size_t i ){ return static_cast<int>( i ); } );
+	run<std::string>( "string", 1000000, []( std::size_t i ){ return std::to_string( i ); } );
+	return 0;
+}
@@ -0,0 +1,114 @@
+#define SC_BENCH_COUNT_ALLOCATIONS
+#include "bench.h"
+#include "vector.h"
+#include "expr.h"
+#include <cmath>
+#include <type_traits>
+#include <utility>
+
+/**
+ * r = a * b + c, r = sqrt( abs( a - b ) ) * 0.5 and dot( a, b ) on sc::vector<double>, for a list that
+ * fits in L1 (4096 elements) and one that does not (1M):
+ *   - temporaries: each operation writes a new list, as a naive operator* / operator+ would;
+ *   - hand-written loop into r;
+ *   - expr.h, at each instruction set level (r is reused, so no allocation at all).
+*/
+typedef sc::vector<double> vec;
+
+/// true if a * b compiles.
+template< typename A, typename B, typename = void >
+struct can_multiply : std::false_type { /* empty */ };
+
+template< typename A, typename B >
+struct can_multiply< A, B, std::void_t< decltype( std::declval<const A&>() * std::declval<const B&>() ) > > : std::true_type { /* empty */ };
+
+// Um escalar que não cabe no tipo dos elementos é rejeitado: int * 0.5 daria 0.
+static_assert( !can_multiply< sc::vector<int>, double >::value, "sc::vector<int> * double must not compile" );
+static_assert( can_multiply< vec, int >::value && can_multiply< sc::vector<int>, int >::value, "fitting scalars are accepted" );
+
+/// one operation with its own result list, like a naive operator returning by value.
+template< typename F >
+vec map( const vec& x, const vec& y, F f )
+{
+	vec out( x.size() );
+	for( std::size_t i = 0; i < x.size(); i++ )
+		out.push_back( f( x[i], y[i] ) );
+	return out;
+}
+
+template< typename Fn >
+void run( const char* name, std::size_t n, std::size_t rounds, Fn fn )
+{
+	std::size_t allocs = sc_bench::allocations;
+	double ns = sc_bench::best_of( 5, []{}, [&]{ for( std::size_t r = 0; r < rounds; r++ ) fn(); } );
+	allocs = sc_bench::allocations - allocs;
+	std::printf( "%-44s n=%-8zu %8.3f ns/element  %5.2f allocations/eval\n", name, n, ns / ( n * rounds ),
+	             double( allocs ) / ( 5 * rounds ) );
+}
+
+int main()
+{
+	const char* isa_names[] = { "scalar", "sse2", "avx2", "avx512" };
+	for( std::size_t n : { std::size_t( 4096 ), std::size_t( 1000000 ) } )
+	{
+		std::size_t rounds = 16000000 / n;
+		vec a, b, c, r;
+		for( std::size_t i = 0; i < n; i++ )
+		{
+			a.push_back( 0.5 * double( i % 97 ) );
+			b.push_back( 1.0 + double( i % 13 ) );
+			c.push_back( double( i % 7 ) );
+		}
+		r.assign( n, 0.0 );
+
+		std::printf( "-- r = a * b + c\n" );
+		run( "temporaries", n, rounds, [&]{
+			vec t = map( a, b, []( double x, double y ){ return x * y; } );
+			r = map( t, c, []( double x, double y ){ return x + y; } );
+			sc_bench::do_not_optimize( r[n-1] );
+		} );
+		run( "hand-written loop", n, rounds, [&]{
+			for( std::size_t i = 0; i < n; i++ )
+				r[i] = a[i] * b[i] + c[i];
+			sc_bench::do_not_optimize( r[n-1] );
+		} );
+		for( int level = 0; level <= int( sc::simd::detected_isa() ); level++ )
+		{
+			sc::simd::isa_limit() = sc::simd::isa( level );
+			char name[64];
+			std::snprintf( name, sizeof name, "expr.h (%s)", isa_names[level] );
+			run( name, n, rounds, [&]{ r = a * b + c; sc_bench::do_not_optimize( r[n-1] ); } );
+		}
+		sc::simd::isa_limit() = sc::simd::isa::avx512;
+
+		std::printf( "-- r = sqrt( abs( a - b ) ) * 0.5\n" );
+		run( "temporaries", n, rounds, [&]{
+			vec t = map( a, b, []( double x, double y ){ return std::fabs( x - y ); } );
+			t = map( t, t, []( double x, double ){ return std::sqrt( x ); } );
+			r = map( t, t, []( double x, double ){ return x * 0.5; } );
+			sc_bench::do_not_optimize( r[n-1] );
+		} );
+		run( "hand-written loop", n, rounds, [&]{
+			for( std::size_t i = 0; i < n; i++ )
+				r[i] = std::sqrt( std::fabs( a[i] - b[i] ) ) * 0.5;
+			sc_bench::do_not_optimize( r[n-1] );
+		} );
+		run( "expr.h", n, rounds, [&]{ r = sc::sqrt( sc::abs( a - b ) ) * 0.5; sc_bench::do_not_optimize( r[n-1] ); } );
+
+		std::printf( "-- dot( a, b )\n" );
+		run( "temporary + sum", n, rounds, [&]{
+			vec t = map( a, b, []( double x, double y ){ return x * y; } );
+			double s = 0;
+			for( double x : t ) s += x;
+			sc_bench::do_not_optimize( s );
+		} );
+		run( "hand-written loop", n, rounds, [&]{
+			double s = 0;
+			for( std::size_t i = 0; i < n; i++ )
+				s += a[i] * b[i];
+			sc_bench::do_not_optimize( s );
+		} );
+		run( "sc::dot", n, rounds, [&]{ sc_bench::do_not_optimize( sc::dot( a, b ) ); } );
+	}
+	return 0;
+}
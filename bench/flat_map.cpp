@@ -0,0 +1,108 @@
+#include "bench.h"
+#include "vector.h"
+#include "flat_map.h"
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <unordered_map>
+
+/**
+ * int -> int maps with random keys.
+ * 1) Build: std::map, std::unordered_map, sc::flat_map filled one insert at a time (every insert shifts
+ *    the tail) and with the bulk insert( first, last ).
+ * 2) Lookup of random present keys, for a table that fits in L1/L2 and ones that do not: std::map,
+ *    std::unordered_map, std::lower_bound on the sorted keys, and sc::flat_map with the branchless
+ *    binary search and with the Eytzinger index.
+*/
+typedef std::pair<std::uint32_t, std::uint32_t> entry;
+
+sc::vector<entry> make_entries( std::size_t n, unsigned seed )
+{
+	std::mt19937 gen( seed );
+	sc::vector<entry> v( n );
+	for( std::size_t i = 0; i < n; i++ )
+		v.push_back( entry( static_cast<std::uint32_t>( gen() ), static_cast<std::uint32_t>( i ) ) );
+	return v;
+}
+
+void build( std::size_t n, bool one_by_one )
+{
+	sc::vector<entry> in = make_entries( n, 1 );
+	const entry* first = in.data();
+	const entry* last = in.data() + n;
+	std::printf( "-- build, n=%zu\n", n );
+	sc_bench::report( "std::map", n, sc_bench::best_of( 3, []{}, [&]{
+		std::map<std::uint32_t, std::uint32_t> m( first, last );
+		sc_bench::do_not_optimize( m.size() );
+	} ) );
+	sc_bench::report( "std::unordered_map (reserved)", n, sc_bench::best_of( 3, []{}, [&]{
+		std::unordered_map<std::uint32_t, std::uint32_t> m;
+		m.reserve( n );
+		m.insert( first, last );
+		sc_bench::do_not_optimize( m.size() );
+	} ) );
+	if( one_by_one )
+		sc_bench::report( "sc::flat_map one insert at a time", n, sc_bench::best_of( 3, []{}, [&]{
+			sc::flat_map<std::uint32_t, std::uint32_t> m;
+			m.reserve( n );
+			for( const entry* p = first; p != last; ++p )
+				m.insert( *p );
+			sc_bench::do_not_optimize( m.size() );
+		} ) );
+	sc_bench::report( "sc::flat_map bulk insert", n, sc_bench::best_of( 3, []{}, [&]{
+		sc::flat_map<std::uint32_t, std::uint32_t> m( first, last );
+		sc_bench::do_not_optimize( m.size() );
+	} ) );
+	sc_bench::report( "sc::flat_map bulk insert (eytzinger)", n, sc_bench::best_of( 3, []{}, [&]{
+		sc::flat_map<std::uint32_t, std::uint32_t, std::less<std::uint32_t>, std::allocator<std::uint32_t>,
+		             std::allocator<std::uint32_t>, sc::eytzinger_search> m( first, last );
+		sc_bench::do_not_optimize( m.size() );
+	} ) );
+}
+
+template< typename Find >
+void lookup( const char* name, const sc::vector<std::uint32_t>& queries, Find find )
+{
+	double ns = sc_bench::best_of( 5, []{}, [&]{
+		std::uint64_t total = 0;
+		for( std::uint32_t q : queries )
+			total += find( q );
+		sc_bench::do_not_optimize( total );
+	} );
+	sc_bench::report( name, queries.size(), ns );
+}
+
+void lookups( std::size_t n )
+{
+	sc::vector<entry> in = make_entries( n, 2 );
+	std::map<std::uint32_t, std::uint32_t> tree( in.begin(), in.end() );
+	std::unordered_map<std::uint32_t, std::uint32_t> hash( in.begin(), in.end() );
+	sc::flat_map<std::uint32_t, std::uint32_t> flat( in.begin(), in.end() );
+	sc::flat_map<std::uint32_t, std::uint32_t, std::less<std::uint32_t>, std::allocator<std::uint32_t>,
+	             std::allocator<std::uint32_t>, sc::eytzinger_search> eytz( in.begin(), in.end() );
+	const sc::vector<std::uint32_t>& keys = flat.keys();
+
+	std::mt19937 gen( 3 );
+	sc::vector<std::uint32_t> queries( 1000000 );
+	for( std::size_t i = 0; i < 1000000; i++ )
+		queries.push_back( in[gen() % n].first );
+
+	std::printf( "-- lookup, n=%zu (%zu KiB of keys)\n", n, n * sizeof(std::uint32_t) / 1024 );
+	lookup( "std::map::find", queries, [&]( std::uint32_t q ){ return tree.find( q )->second; } );
+	lookup( "std::unordered_map::find", queries, [&]( std::uint32_t q ){ return hash.find( q )->second; } );
+	lookup( "std::lower_bound on sorted keys", queries, [&]( std::uint32_t q ){
+		return static_cast<std::uint32_t>( std::lower_bound( keys.data(), keys.data() + keys.size(), q ) - keys.data() );
+	} );
+	lookup( "sc::flat_map::find (branchless)", queries, [&]( std::uint32_t q ){ return flat.find( q )->second; } );
+	lookup( "sc::flat_map::find (eytzinger)", queries, [&]( std::uint32_t q ){ return eytz.find( q )->second; } );
+}
+
+int main()
+{
+	build( 50000, true );
+	build( 1000000, false );
+	for( std::size_t n : { std::size_t( 1000 ), std::size_t( 64000 ), std::size_t( 1000000 ), std::size_t( 8000000 ) } )
+		lookups( n );
+	return 0;
+}
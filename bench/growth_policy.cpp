@@ -0,0 +1,48 @@
+#include "bench.h"
+#include "vector.h"
+#include <cstdint>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/**
+ * Appends n uint64_t one by one with each growth policy / allocator pair.
+ * Each run happens in a child process so that its peak resident memory
+ * (ru_maxrss) can be reported next to the time per append.
+*/
+template< typename V >
+void run( const char* name, std::size_t n )
+{
+	std::fflush( stdout );
+	pid_t pid = fork();
+	if( pid == 0 )
+	{
+		auto start = std::chrono::steady_clock::now();
+		V v;
+		for( std::size_t i = 0; i < n; i++ )
+			v.push_back( i );
+		auto stop = std::chrono::steady_clock::now();
+		sc_bench::do_not_optimize( v[n-1] );
+		double ns = std::chrono::duration<double, std::nano>( stop - start ).count();
+		std::printf( "%-44s n=%-10zu %8.2f ns/op", name, n, ns / n );
+		std::fflush( stdout );
+		_exit( 0 );
+	}
+	int status = 0;
+	struct rusage usage;
+	wait4( pid, &status, 0, &usage );
+	double live_mb = n * sizeof(std::uint64_t) / 1048576.0;
+	std::printf( "  peak %8.1f MiB (%.2fx live data)\n", usage.ru_maxrss / 1024.0, usage.ru_maxrss / 1024.0 / live_mb );
+}
+
+int main()
+{
+	typedef std::uint64_t u64;
+	const std::size_t n = 100000000; // 800 MB of live data.
+	run< sc::vector<u64> >( "doubling, std::allocator", n );
+	run< sc::vector<u64, std::allocator<u64>, sc::half_growth> >( "1.5x, std::allocator", n );
+	run< sc::vector<u64, sc::realloc_allocator<u64>> >( "doubling, realloc_allocator (mremap)", n );
+	run< sc::vector<u64, sc::realloc_allocator<u64>, sc::half_growth> >( "1.5x, realloc_allocator (mremap)", n );
+	run< sc::vector<u64, sc::realloc_allocator<u64>, sc::chunk_growth<(1u << 24)>> >( "+128 MiB chunks, realloc_allocator (mremap)", n );
+	return 0;
+}
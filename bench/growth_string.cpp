@@ -0,0 +1,45 @@
+#include "bench.h"
+#include "vector.h"
+#include <string>
+#include <utility>
+
+/**
+ * Cost of one reallocation of a vector of heap-allocated strings.
+ * copy_string has a move constructor that may throw, so move_if_noexcept
+ * falls back to copying: this is what every growth cost before sc::vector
+ * supported move semantics.
+*/
+struct copy_string
+{
+	std::string s;
+	copy_string( const std::string& v ) : s( v ) {}
+	copy_string( const copy_string& ) = default;
+	copy_string( copy_string&& o ) noexcept( false ) : s( std::move( o.s ) ) {}
+};
+
+template< typename T >
+void run( const char* name, std::size_t n )
+{
+	const std::string value( 1024, 'x' ); // a heap buffer, far longer than any SSO buffer.
+	sc::vector<T> v;
+	double ns = sc_bench::best_of( 5,
+		[&]{
+			v = sc::vector<T>();
+			v.reserve( n );
+			for( std::size_t i = 0; i < n; i++ )
+				v.push_back( T( value ) );
+		},
+		[&]{ v.reserve( 2 * n ); } );
+	sc_bench::do_not_optimize( v.size() );
+	sc_bench::report( name, n, ns );
+}
+
+int main()
+{
+	for( std::size_t n : { 1000u, 100000u, 1000000u } )
+	{
+		run<copy_string>( "reserve growth, copy relocation", n );
+		run<std::string>( "reserve growth, move relocation", n );
+	}
+	return 0;
+}
@@ -0,0 +1,73 @@
+#include "bench.h"
+#include "aligned_allocator.h"
+#include <cstdint>
+#include <cstdlib>
+
+/**
+ * Reduction over a 1 GiB array (or argv[1] MiB) of uint64_t with std::allocator, a page-aligned
+ * sc::aligned_vector and a sc::huge_page_vector. Two passes: a sequential sum, and a sum that strides
+ * one page plus one line at a time, where every load needs a new TLB entry. dTLB misses are read with
+ * perf_event_open when the kernel allows it (kernel.perf_event_paranoid <= 2); otherwise only times are shown.
+*/
+template< typename Vector >
+void run( const char* name, std::size_t n, sc_bench::perf_counter& tlb )
+{
+	Vector v;
+	v.assign( n, 1 ); // também faz o primeiro toque em todas as páginas.
+
+	long long misses = 0;
+	double ns = sc_bench::best_of( 3, []{},
+		[&]{
+			tlb.start();
+			std::uint64_t sum = 0;
+			for( std::size_t i = 0; i < n; i++ )
+				sum += v[i];
+			misses = tlb.stop();
+			sc_bench::do_not_optimize( sum );
+		} );
+	char label[64];
+	std::snprintf( label, sizeof label, "sequential sum %s", name );
+	sc_bench::report( label, n, ns );
+	if( tlb.available() )
+		std::printf( "%-40s dTLB misses %lld\n", "", misses );
+
+	// Um acesso por página (+ uma linha, para variar o conjunto de cache): cada load pede uma entrada nova na TLB.
+	const std::size_t stride = ( 4096 + 64 ) / sizeof(std::uint64_t);
+	std::size_t loads = 0;
+	ns = sc_bench::best_of( 3, []{},
+		[&]{
+			tlb.start();
+			std::uint64_t sum = 0;
+			loads = 0;
+			for( std::size_t start = 0; start < stride; start += 64 / sizeof(std::uint64_t) )
+				for( std::size_t i = start; i < n; i += stride, loads++ )
+					sum += v[i];
+			misses = tlb.stop();
+			sc_bench::do_not_optimize( sum );
+		} );
+	std::snprintf( label, sizeof label, "page-strided sum %s", name );
+	sc_bench::report( label, loads, ns );
+	if( tlb.available() )
+		std::printf( "%-40s dTLB misses %lld\n", "", misses );
+}
+
+int main( int argc, char* argv[] )
+{
+	std::size_t mib = ( argc > 1 ) ? std::strtoull( argv[1], nullptr, 10 ) : 1024;
+	std::size_t n = mib * ( std::size_t( 1 ) << 20 ) / sizeof(std::uint64_t);
+#ifdef __linux__
+	sc_bench::perf_counter tlb( PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB | ( PERF_COUNT_HW_CACHE_OP_READ << 8 ) | ( PERF_COUNT_HW_CACHE_RESULT_MISS << 16 ) );
+#else
+	sc_bench::perf_counter tlb( 0, 0 );
+#endif
+	if( !tlb.available() )
+		std::printf( "perf_event_open unavailable: dTLB misses not shown\n" );
+
+	run< sc::vector<std::uint64_t> >( "std::allocator", n, tlb );
+	run< sc::aligned_vector<std::uint64_t, 4096> >( "aligned 4 KiB", n, tlb );
+	run< sc::huge_page_vector<std::uint64_t> >( "huge pages", n, tlb );
+	std::printf( "huge page blocks: %zu hugetlbfs, %zu transparent, %zu fell back to 4 KiB pages\n",
+	             sc::huge_page_stats::explicit_pages().load(), sc::huge_page_stats::transparent().load(),
+	             sc::huge_page_stats::small_pages().load() );
+	return 0;
+}
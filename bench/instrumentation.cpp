@@ -0,0 +1,63 @@
+#include "bench.h"
+#include "vector.h"
+#include <iostream>
+
+/**
+ * Cost of sc::instrumented next to the default sc::no_instrumentation (which must match a plain
+ * sc::vector), then the registry of a small program with a reserve that is too small and one that
+ * is too large, dumped as JSON.
+*/
+template< typename Instrument >
+using list = sc::vector< int, std::allocator<int>, sc::doubling_growth, Instrument >;
+
+template< typename Instrument >
+void run( const char* name, std::size_t n )
+{
+	char label[64];
+	std::snprintf( label, sizeof label, "push_back %s", name );
+	sc_bench::report( label, n, sc_bench::best_of( 5, []{},
+		[&]{
+			list<Instrument> v;
+			for( std::size_t i = 0; i < n; i++ )
+				v.push_back( int( i ) );
+			sc_bench::do_not_optimize( v.data() );
+		} ) );
+
+	std::snprintf( label, sizeof label, "insert/erase front %s", name );
+	list<Instrument> w;
+	w.assign( 1000, 7 );
+	sc_bench::report( label, n / 100, sc_bench::best_of( 5, []{},
+		[&]{
+			for( std::size_t i = 0; i < n / 100; i++ )
+			{
+				w.insert( w.begin(), int( i ) );
+				w.erase( w.begin() );
+			}
+			sc_bench::do_not_optimize( w.data() );
+		} ) );
+}
+
+int main()
+{
+	const std::size_t n = 10000000;
+	run< sc::no_instrumentation >( "no_instrumentation", n );
+	run< sc::instrumented >( "instrumented", n );
+
+	sc::instrument_registry::global().reset();
+	for( int request = 0; request < 100; request++ )
+	{
+		list<sc::instrumented> small;
+		small.instrumentation().tag( "parse/tokens" );
+		small.reserve( 16 ); // pequeno demais: cresce de novo em todo pedido.
+		for( int i = 0; i < 40; i++ )
+			small.push_back( i );
+
+		list<sc::instrumented> big;
+		big.instrumentation().tag( "parse/headers" );
+		big.reserve( 4096 ); // grande demais: quase tudo fica sem uso.
+		for( int i = 0; i < 8; i++ )
+			big.push_back( i );
+	}
+	sc::instrument_registry::global().write_json( std::cout );
+	return 0;
+}
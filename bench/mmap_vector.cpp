@@ -0,0 +1,69 @@
+#include "bench.h"
+#include "vector.h"
+#include "mmap_vector.h"
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+
+/**
+ * Opening a dataset of 16-byte records: reading the whole file into a sc::vector against mapping it
+ * with sc::mmap_vector, then a full scan and a handful of random lookups on each.
+ * Usage: ./a.out [MiB] [path]   (default 512 MiB in /tmp/sc_mmap_bench.bin; the file is removed at the end)
+ * The file is written just before, so it is in the page cache: the read time is a lower bound.
+*/
+struct record{
+	std::uint64_t key;
+	std::uint64_t value;
+};
+
+int main( int argc, char* argv[] )
+{
+	std::size_t mib = ( argc > 1 ) ? std::strtoul( argv[1], nullptr, 10 ) : 512;
+	std::string path = ( argc > 2 ) ? argv[2] : "/tmp/sc_mmap_bench.bin";
+	std::size_t n = mib * 1048576 / sizeof(record);
+
+	double ns = sc_bench::best_of( 1, []{},
+		[&]{
+			sc::mmap_vector<record> out( path, sc::mmap_mode::truncate );
+			out.reserve( n );
+			for( std::size_t i = 0; i < n; i++ )
+				out.push_back( record{ i, i * 7 } );
+		} );
+	sc_bench::report( "write with mmap_vector", n, ns );
+
+	std::uint64_t sum = 0;
+	sc::vector<record> loaded;
+	ns = sc_bench::best_of( 1, []{},
+		[&]{
+			std::ifstream in( path, std::ios::binary );
+			sc::vector<record> v( n );
+			record r;
+			while( in.read( reinterpret_cast<char*>( &r ), sizeof r ) )
+				v.push_back( r );
+			loaded = std::move( v );
+		} );
+	sc_bench::report( "open: read into sc::vector", n, ns );
+
+	sc::mmap_vector<record> mapped;
+	ns = sc_bench::best_of( 1, []{}, [&]{ mapped.open( path, sc::mmap_mode::read_only ); } );
+	sc_bench::report( "open: sc::mmap_vector", n, ns );
+
+	ns = sc_bench::best_of( 1, []{},
+		[&]{
+			for( std::size_t i = 0; i < 1000; i++ )
+				sum += mapped[ ( i * 2654435761u ) % n ].value;
+		} );
+	sc_bench::report( "1000 random lookups mmap_vector", 1000, ns );
+
+	ns = sc_bench::best_of( 3, []{}, [&]{ for( const record& r : loaded ) sum += r.value; } );
+	sc_bench::report( "scan sc::vector", n, ns );
+
+	mapped.advise( sc::mmap_advice::sequential );
+	ns = sc_bench::best_of( 3, []{}, [&]{ for( const record& r : mapped ) sum += r.value; } );
+	sc_bench::report( "scan mmap_vector (sequential)", n, ns );
+
+	sc_bench::do_not_optimize( sum );
+	mapped.close();
+	std::remove( path.c_str() );
+	return 0;
+}
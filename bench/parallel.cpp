@@ -0,0 +1,68 @@
+#include "bench.h"
+#include "vector.h"
+#include "parallel.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <numeric>
+#include <thread>
+
+/**
+ * Scaling of the sc::parallel algorithms over a sc::vector<double> of n elements (100M by default,
+ * or argv[1]) on pools of 1, 2, 4, ... threads up to the number of cores, next to the sequential
+ * std algorithm. Build with -pthread; 100M doubles need about 1.6 GB.
+*/
+static void fill_random( sc::vector<double>& v )
+{
+	std::uint64_t seed = 88172645463325252ull;
+	for( double& x : v )
+	{
+		seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17;
+		x = double( seed >> 11 ) * ( 1.0 / 9007199254740992.0 );
+	}
+}
+
+int main( int argc, char* argv[] )
+{
+	std::size_t n = ( argc > 1 ) ? std::strtoull( argv[1], nullptr, 10 ) : 100000000;
+	unsigned hw = std::max( 1u, std::thread::hardware_concurrency() );
+	sc::vector<double> in, out;
+	in.assign( n, 0.0 );
+	out.assign( n, 0.0 );
+	fill_random( in );
+
+	sc_bench::report( "std::fill", n, sc_bench::best_of( 3, []{}, [&]{ std::fill( out.begin(), out.end(), 1.5 ); } ) );
+	sc_bench::report( "std::transform", n, sc_bench::best_of( 3, []{},
+		[&]{ std::transform( in.begin(), in.end(), out.begin(), []( double x ){ return x * x + 1; } ); } ) );
+	sc_bench::report( "std::accumulate", n, sc_bench::best_of( 3, []{},
+		[&]{ sc_bench::do_not_optimize( std::accumulate( in.begin(), in.end(), 0.0 ) ); } ) );
+	sc_bench::report( "std::inclusive_scan", n, sc_bench::best_of( 3, []{},
+		[&]{ std::inclusive_scan( in.begin(), in.end(), out.begin() ); } ) );
+	sc_bench::report( "std::sort", n, sc_bench::best_of( 3, [&]{ std::copy( in.begin(), in.end(), out.begin() ); },
+		[&]{ std::sort( out.begin(), out.end() ); } ) );
+
+	for( unsigned threads = 1; ; threads = std::min( threads * 2, hw ) )
+	{
+		sc::parallel::thread_pool pool( threads );
+		sc::parallel::options opt{ &pool };
+		char label[64];
+
+		std::snprintf( label, sizeof label, "parallel::fill x%u", threads );
+		sc_bench::report( label, n, sc_bench::best_of( 3, []{}, [&]{ sc::parallel::fill( out, 1.5, opt ); } ) );
+		std::snprintf( label, sizeof label, "parallel::transform x%u", threads );
+		sc_bench::report( label, n, sc_bench::best_of( 3, []{},
+			[&]{ sc::parallel::transform( in, out, []( double x ){ return x * x + 1; }, opt ); } ) );
+		std::snprintf( label, sizeof label, "parallel::reduce x%u", threads );
+		sc_bench::report( label, n, sc_bench::best_of( 3, []{},
+			[&]{ sc_bench::do_not_optimize( sc::parallel::reduce( in, 0.0, std::plus<>(), opt ) ); } ) );
+		std::snprintf( label, sizeof label, "parallel::inclusive_scan x%u", threads );
+		sc_bench::report( label, n, sc_bench::best_of( 3, []{},
+			[&]{ sc::parallel::inclusive_scan( in, out, std::plus<>(), opt ); } ) );
+		std::snprintf( label, sizeof label, "parallel::sort x%u", threads );
+		sc_bench::report( label, n, sc_bench::best_of( 3, [&]{ std::copy( in.begin(), in.end(), out.begin() ); },
+			[&]{ sc::parallel::sort( out, std::less<>(), opt ); } ) );
+
+		if( threads == hw ) break;
+	}
+	return 0;
+}
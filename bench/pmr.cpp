@@ -0,0 +1,93 @@
+#include "bench.h"
+#include "vector.h"
+#include "pmr_vector.h"
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Request simulation: every request builds 48 short-lived lists (ints of 1..64 elements and a few
+ * short strings), reads them and drops them. Each thread serves its share of the requests with
+ * malloc-backed sc::vector, or with sc::pmr::vector on a per-thread arena (reset after every
+ * request) or pool. Build with -pthread.
+*/
+struct malloc_backed{
+	template< typename T > using list = sc::vector<T>;
+	template< typename T > static list<T> make( void ) { return list<T>(); }
+	void end_request( void ) { }
+};
+
+struct arena_backed{
+	sc::pmr::arena_resource arena{ 64 * 1024 };
+	template< typename T > using list = sc::pmr::vector<T>;
+	template< typename T > list<T> make( void ) { return list<T>( &arena ); }
+	void end_request( void ) { arena.reset(); }
+};
+
+struct pool_backed{
+	sc::pmr::pool_resource pool;
+	template< typename T > using list = sc::pmr::vector<T>;
+	template< typename T > list<T> make( void ) { return list<T>( &pool ); }
+	void end_request( void ) { }
+};
+
+template< typename Backend >
+std::uint64_t serve( std::size_t requests, std::uint32_t seed )
+{
+	Backend backend;
+	std::uint64_t sum = 0;
+	for( std::size_t r = 0; r < requests; r++ )
+	{
+		{
+			auto names = backend.template make<std::string>();
+			for( int l = 0; l < 48; l++ )
+			{
+				seed = seed * 1664525u + 1013904223u;
+				auto v = backend.template make<std::uint32_t>();
+				std::uint32_t len = 1 + ( seed >> 8 ) % 64;
+				for( std::uint32_t i = 0; i < len; i++ )
+					v.push_back( seed ^ i );
+				for( std::uint32_t x : v )
+					sum += x;
+				if( l % 8 == 0 )
+					names.push_back( "header-" + std::to_string( l ) );
+			}
+			sum += names.size();
+		}
+		backend.end_request();
+	}
+	return sum;
+}
+
+template< typename Backend >
+void run( const char* name, unsigned threads, std::size_t requests )
+{
+	double ns = sc_bench::best_of( 3, []{},
+		[&]{
+			std::atomic<std::uint64_t> total{ 0 };
+			std::vector<std::thread> pool;
+			for( unsigned t = 0; t < threads; t++ )
+				pool.emplace_back( [&, t]{ total += serve<Backend>( requests / threads, t + 1 ); } );
+			for( std::thread& th : pool )
+				th.join();
+			sc_bench::do_not_optimize( total.load() );
+		} );
+	char label[64];
+	std::snprintf( label, sizeof label, "%s x%u threads", name, threads );
+	sc_bench::report( label, requests, ns );
+}
+
+int main()
+{
+	const std::size_t requests = 100000;
+	unsigned hw = std::max( 1u, std::thread::hardware_concurrency() );
+	for( unsigned threads : { 1u, 4u, hw } )
+	{
+		run< malloc_backed >( "requests malloc", threads, requests );
+		run< arena_backed >( "requests arena", threads, requests );
+		run< pool_backed >( "requests pool", threads, requests );
+	}
+	return 0;
+}
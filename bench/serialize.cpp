@@ -0,0 +1,98 @@
+#include "bench.h"
+#include "vector.h"
+#include "serialize.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+/**
+ * Checkpoint/restore of a list of uint64_t: text through operator<< and operator>> (the only I/O
+ * sc::vector had), one fwrite/fread per element, sc::save/sc::load (one writev / one read) and
+ * sc::stream_writer with 1 MiB batches.
+ * Usage: ./a.out [elements] [path]   (default 32M elements = 256 MiB in /tmp/sc_serialize_bench.bin)
+*/
+int main( int argc, char* argv[] )
+{
+	std::size_t n = ( argc > 1 ) ? std::strtoul( argv[1], nullptr, 10 ) : std::size_t( 32 ) << 20;
+	std::string path = ( argc > 2 ) ? argv[2] : "/tmp/sc_serialize_bench.bin";
+	sc::vector<std::uint64_t> v( n );
+	for( std::size_t i = 0; i < n; i++ )
+		v.push_back( i * 2654435761u );
+	sc::vector<std::uint64_t> back;
+
+	std::size_t text_n = std::min( n, std::size_t( 4 ) << 20 );
+	double ns = sc_bench::best_of( 1, []{},
+		[&]{
+			std::ofstream out( path );
+			out << "[ ";
+			for( std::size_t i = 0; i < text_n; i++ )
+				out << v[i] << ' ';
+			out << "]";
+		} );
+	sc_bench::report( "save text (operator<<)", text_n, ns );
+	ns = sc_bench::best_of( 1, []{},
+		[&]{
+			std::ifstream in( path );
+			std::string bracket;
+			in >> bracket;
+			back.clear();
+			std::uint64_t x;
+			while( in >> x )
+				back.push_back( x );
+		} );
+	sc_bench::report( "load text (operator>>)", text_n, ns );
+
+	ns = sc_bench::best_of( 1, []{},
+		[&]{
+			std::FILE* f = std::fopen( path.c_str(), "wb" );
+			for( std::size_t i = 0; i < n; i++ )
+				std::fwrite( &v[i], sizeof v[i], 1, f );
+			std::fclose( f );
+		} );
+	sc_bench::report( "save fwrite per element", n, ns );
+	ns = sc_bench::best_of( 1, []{},
+		[&]{
+			std::FILE* f = std::fopen( path.c_str(), "rb" );
+			back.clear();
+			std::uint64_t x;
+			while( std::fread( &x, sizeof x, 1, f ) == 1 )
+				back.push_back( x );
+			std::fclose( f );
+		} );
+	sc_bench::report( "load fread per element", n, ns );
+
+	ns = sc_bench::best_of( 3, []{}, [&]{ sc::save( path, v ); } );
+	sc_bench::report( "sc::save", n, ns );
+	ns = sc_bench::best_of( 3, []{}, [&]{ sc::load( path, back ); } );
+	sc_bench::report( "sc::load", n, ns );
+	if( back != v )
+		std::printf( "sc::load returned different data\n" );
+
+	ns = sc_bench::best_of( 3, []{},
+		[&]{
+			sc::io::file f( path, O_WRONLY | O_CREAT | O_TRUNC );
+			sc::stream_writer<std::uint64_t> out( f.fd() );
+			for( std::uint64_t x : v )
+				out.push_back( x );
+			out.close();
+		} );
+	sc_bench::report( "sc::stream_writer push_back", n, ns );
+	ns = sc_bench::best_of( 3, []{},
+		[&]{
+			sc::io::file f( path, O_RDONLY );
+			sc::stream_reader<std::uint64_t> in( f.fd() );
+			sc::vector<std::uint64_t> batch( 1 << 16 );
+			std::uint64_t sum = 0;
+			while( in.read( batch, 1 << 16 ) != 0 )
+			{
+				for( std::uint64_t x : batch )
+					sum += x;
+				batch.clear();
+			}
+			sc_bench::do_not_optimize( sum );
+		} );
+	sc_bench::report( "sc::stream_reader 64K batches", n, ns );
+
+	std::remove( path.c_str() );
+	return 0;
+}
@@ -0,0 +1,67 @@
+#include "bench.h"
+#include "vector.h"
+#include <algorithm>
+#include <cstdint>
+
+/**
+ * Comparison and search over 1M-element vectors: the element-by-element loops that sc::vector used
+ * before (and the std algorithms) against the sc:: kernels at each instruction set level.
+*/
+template< typename T >
+void run( const char* type )
+{
+	const std::size_t n = 1000000;
+	sc::vector<T> a, b;
+	for( std::size_t i = 0; i < n; i++ )
+	{
+		a.push_back( static_cast<T>( i % 100 ) );
+		b.push_back( static_cast<T>( i % 100 ) );
+	}
+	const T missing = static_cast<T>( 101 );
+	char name[64];
+
+	double ns = sc_bench::best_of( 10, []{}, [&]{
+		bool eq = true;
+		for( auto l = a.cbegin(), r = b.cbegin(); l != a.cend(); ++l, ++r )
+			if( *l != *r ) { eq = false; break; }
+		sc_bench::do_not_optimize( eq );
+	} );
+	std::snprintf( name, sizeof name, "%s == (element loop)", type );
+	sc_bench::report( name, n, ns );
+	ns = sc_bench::best_of( 10, []{}, [&]{ sc_bench::do_not_optimize( std::find( a.cbegin(), a.cend(), missing ) ); } );
+	std::snprintf( name, sizeof name, "%s std::find", type );
+	sc_bench::report( name, n, ns );
+	ns = sc_bench::best_of( 10, []{}, [&]{ sc_bench::do_not_optimize( std::count( a.cbegin(), a.cend(), T( 7 ) ) ); } );
+	std::snprintf( name, sizeof name, "%s std::count", type );
+	sc_bench::report( name, n, ns );
+	ns = sc_bench::best_of( 10, []{}, [&]{ sc_bench::do_not_optimize( std::min_element( a.cbegin(), a.cend() ) ); } );
+	std::snprintf( name, sizeof name, "%s std::min_element", type );
+	sc_bench::report( name, n, ns );
+
+	const char* levels[] = { "scalar", "sse2", "avx2", "avx512" };
+	for( int level = 0; level <= static_cast<int>( sc::simd::detected_isa() ); level++ )
+	{
+		sc::simd::isa_limit() = static_cast<sc::simd::isa>( level );
+		ns = sc_bench::best_of( 10, []{}, [&]{ sc_bench::do_not_optimize( a == b ); } );
+		std::snprintf( name, sizeof name, "%s == [%s]", type, levels[level] );
+		sc_bench::report( name, n, ns );
+		ns = sc_bench::best_of( 10, []{}, [&]{ sc_bench::do_not_optimize( sc::find( a, missing ) ); } );
+		std::snprintf( name, sizeof name, "%s sc::find [%s]", type, levels[level] );
+		sc_bench::report( name, n, ns );
+		ns = sc_bench::best_of( 10, []{}, [&]{ sc_bench::do_not_optimize( sc::count( a, T( 7 ) ) ); } );
+		std::snprintf( name, sizeof name, "%s sc::count [%s]", type, levels[level] );
+		sc_bench::report( name, n, ns );
+		ns = sc_bench::best_of( 10, []{}, [&]{ sc_bench::do_not_optimize( sc::min_element( a ) ); } );
+		std::snprintf( name, sizeof name, "%s sc::min_element [%s]", type, levels[level] );
+		sc_bench::report( name, n, ns );
+	}
+	sc::simd::isa_limit() = sc::simd::isa::avx512;
+}
+
+int main()
+{
+	run<std::int32_t>( "int32" );
+	run<std::uint8_t>( "uint8" );
+	run<double>( "double" );
+	return 0;
+}
@@ -0,0 +1,38 @@
+#define SC_BENCH_COUNT_ALLOCATIONS
+#include "bench.h"
+#include "vector.h"
+#include "small_vector.h"
+
+/**
+ * Create, fill with n ints and destroy a short list, many times.
+ * sc::small_vector<int, 16> never touches the heap for n <= 16.
+*/
+template< typename V >
+void run( const char* name, std::size_t n )
+{
+	const std::size_t rounds = 1000000;
+	std::size_t allocs = 0;
+	double ns = sc_bench::best_of( 5,
+		[&]{ allocs = sc_bench::allocations; },
+		[&]{
+			for( std::size_t r = 0; r < rounds; r++ )
+			{
+				V v;
+				for( std::size_t i = 0; i < n; i++ )
+					v.push_back( static_cast<int>( i + r ) );
+				sc_bench::do_not_optimize( v[n-1] );
+			}
+		} );
+	allocs = sc_bench::allocations - allocs;
+	std::printf( "%-28s n=%-3zu %8.2f ns/list  %6.2f allocations/list\n", name, n, ns / rounds, double( allocs ) / rounds );
+}
+
+int main()
+{
+	for( std::size_t n : { 1u, 4u, 8u, 16u, 32u } )
+	{
+		run< sc::vector<int> >( "sc::vector<int>", n );
+		run< sc::small_vector<int, 16> >( "sc::small_vector<int, 16>", n );
+	}
+	return 0;
+}
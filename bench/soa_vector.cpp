@@ -0,0 +1,84 @@
+#include "bench.h"
+#include "vector.h"
+#include "soa_vector.h"
+#include <cstdint>
+
+/**
+ * Single-field and two-field scans over 10M records of 8 fields (48 bytes), stored as a sc::vector of
+ * structs (AoS) or as a sc::soa_vector with one column per field (SoA).
+*/
+struct record{
+	std::uint64_t id;
+	double price;
+	double quantity;
+	std::uint32_t flags;
+	std::uint32_t region;
+	std::uint64_t timestamp;
+	float score;
+	std::uint32_t owner;
+};
+
+typedef sc::soa_vector< std::uint64_t, double, double, std::uint32_t, std::uint32_t, std::uint64_t, float, std::uint32_t > record_columns;
+
+int main()
+{
+	const std::size_t n = 10000000;
+	sc::vector<record> aos;
+	record_columns soa;
+	aos.reserve( n );
+	soa.reserve( n );
+	for( std::size_t i = 0; i < n; i++ )
+	{
+		record r{ i, double( i % 1000 ) * 0.25, double( i % 7 ), std::uint32_t( i ), std::uint32_t( i % 16 ), i * 3, float( i % 100 ), std::uint32_t( i % 97 ) };
+		aos.push_back( r );
+		soa.push_back( r.id, r.price, r.quantity, r.flags, r.region, r.timestamp, r.score, r.owner );
+	}
+
+	sc_bench::report( "sum(price) AoS", n, sc_bench::best_of( 5, []{},
+		[&]{
+			double total = 0;
+			for( const record& r : aos )
+				total += r.price;
+			sc_bench::do_not_optimize( total );
+		} ) );
+	sc_bench::report( "sum(price) SoA column", n, sc_bench::best_of( 5, []{},
+		[&]{
+			double total = 0;
+			for( double p : soa.column<1>() )
+				total += p;
+			sc_bench::do_not_optimize( total );
+		} ) );
+
+	sc_bench::report( "sum(price * quantity) AoS", n, sc_bench::best_of( 5, []{},
+		[&]{
+			double total = 0;
+			for( const record& r : aos )
+				total += r.price * r.quantity;
+			sc_bench::do_not_optimize( total );
+		} ) );
+	sc_bench::report( "sum(price * quantity) SoA columns", n, sc_bench::best_of( 5, []{},
+		[&]{
+			const double* price = soa.data<1>();
+			const double* quantity = soa.data<2>();
+			double total = 0;
+			for( std::size_t i = 0; i < n; i++ )
+				total += price[i] * quantity[i];
+			sc_bench::do_not_optimize( total );
+		} ) );
+
+	sc_bench::report( "count(region == 3) AoS", n, sc_bench::best_of( 5, []{},
+		[&]{
+			std::size_t hits = 0;
+			for( const record& r : aos )
+				hits += ( r.region == 3 );
+			sc_bench::do_not_optimize( hits );
+		} ) );
+	sc_bench::report( "count(region == 3) SoA proxy iteration", n, sc_bench::best_of( 5, []{},
+		[&]{
+			std::size_t hits = 0;
+			for( auto row : soa )
+				hits += ( std::get<4>( row ) == 3 );
+			sc_bench::do_not_optimize( hits );
+		} ) );
+	return 0;
+}
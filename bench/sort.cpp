@@ -0,0 +1,49 @@
+#include "bench.h"
+#include "vector.h"
+#include "sort.h"
+#include "parallel.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+
+/**
+ * sc::sort (LSD radix sort) and sc::parallel::sort against std::sort on n uniformly random uint32_t,
+ * uint64_t and float keys (10M by default, or argv[1]), and on uint64_t keys below 2^20, where the radix
+ * sort skips the passes of the zero bytes. 1B uint64_t keys need 16 GB: the input and the sort buffer.
+*/
+
+template< typename T, typename Gen >
+void run( const char* type, std::size_t n, Gen gen )
+{
+	sc::vector<T> in, work;
+	in.reserve( n );
+	for( std::size_t i = 0; i < n; i++ )
+		in.push_back( gen() );
+	work.assign( n, T() );
+	auto reset = [&]{ std::copy( in.begin(), in.end(), work.begin() ); };
+	char label[64];
+
+	std::snprintf( label, sizeof label, "std::sort %s", type );
+	sc_bench::report( label, n, sc_bench::best_of( 3, reset, [&]{ std::sort( work.begin(), work.end() ); } ) );
+	std::snprintf( label, sizeof label, "sc::sort %s", type );
+	sc_bench::report( label, n, sc_bench::best_of( 3, reset, [&]{ sc::sort( work ); } ) );
+	std::snprintf( label, sizeof label, "sc::parallel::sort %s", type );
+	sc_bench::report( label, n, sc_bench::best_of( 3, reset, [&]{ sc::parallel::sort( work ); } ) );
+	if( !std::is_sorted( work.begin(), work.end() ) )
+		std::printf( "%s: not sorted\n", type );
+}
+
+int main( int argc, char* argv[] )
+{
+	std::size_t n = ( argc > 1 ) ? std::strtoull( argv[1], nullptr, 10 ) : 10000000;
+	std::mt19937_64 rng( 7 );
+	std::uniform_real_distribution<float> real( -1e6f, 1e6f );
+
+	run<std::uint32_t>( "uint32", n, [&]{ return static_cast<std::uint32_t>( rng() ); } );
+	run<std::uint64_t>( "uint64", n, [&]{ return rng(); } );
+	run<float>( "float", n, [&]{ return real( rng ); } );
+	run<std::uint64_t>( "uint64 < 2^20", n, [&]{ return rng() & 0xFFFFF; } );
+	sc::release_sort_buffer();
+	return 0;
+}
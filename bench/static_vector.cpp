@@ -0,0 +1,69 @@
+#define SC_BENCH_COUNT_ALLOCATIONS
+#include "bench.h"
+#include "vector.h"
+#include "small_vector.h"
+#include "static_vector.h"
+#include <cstdint>
+
+/**
+ * 1) Create, fill with n ints and destroy a short list, many times: sc::static_vector<int, 32> never
+ *    allocates and has no heap branch at all.
+ * 2) A 4096-entry CRC-style lookup table built at startup with sc::vector, against the same table computed
+ *    at compile time (C++20: g++ -O2 -std=c++20 -I../include static_vector.cpp), which costs nothing at run time.
+*/
+template< typename V >
+void run( const char* name, std::size_t n )
+{
+	const std::size_t rounds = 1000000;
+	std::size_t allocs = 0;
+	double ns = sc_bench::best_of( 5,
+		[&]{ allocs = sc_bench::allocations; },
+		[&]{
+			for( std::size_t r = 0; r < rounds; r++ )
+			{
+				V v;
+				for( std::size_t i = 0; i < n; i++ )
+					v.push_back( static_cast<int>( i + r ) );
+				sc_bench::do_not_optimize( v[n-1] );
+			}
+		} );
+	allocs = sc_bench::allocations - allocs;
+	std::printf( "%-28s n=%-3zu %8.2f ns/list  %6.2f allocations/list\n", name, n, ns / rounds, double( allocs ) / rounds );
+}
+
+SC_CONSTEXPR20 sc::vector<std::uint32_t> make_table( void )
+{
+	sc::vector<std::uint32_t> table;
+	for( std::uint32_t i = 0; i < 4096; i++ )
+	{
+		std::uint32_t c = i;
+		for( int k = 0; k < 12; k++ )
+			c = ( c & 1 ) ? ( c >> 1 ) ^ 0xEDB88320u : c >> 1;
+		table.push_back( c );
+	}
+	return table;
+}
+
+int main()
+{
+	for( std::size_t n : { 1u, 4u, 16u, 32u } )
+	{
+		run< sc::vector<int> >( "sc::vector<int>", n );
+		run< sc::small_vector<int, 32> >( "sc::small_vector<int, 32>", n );
+		run< sc::static_vector<int, 32> >( "sc::static_vector<int, 32>", n );
+	}
+
+	sc_bench::report( "table built at startup", 4096, sc_bench::best_of( 5, []{},
+		[]{
+			sc::vector<std::uint32_t> table = make_table();
+			sc_bench::do_not_optimize( table[4095] );
+		} ) );
+#if SC_HAS_CONSTEXPR_ALLOCATION
+	static constexpr auto table = sc::to_static_vector< 4096 >( make_table );
+	sc_bench::report( "table computed at compile time", 4096, sc_bench::best_of( 5, []{},
+		[]{ sc_bench::do_not_optimize( table[4095] ); } ) );
+#else
+	std::printf( "compile-time table needs C++20 constexpr allocation\n" );
+#endif
+	return 0;
+}
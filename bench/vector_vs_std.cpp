@@ -0,0 +1,327 @@
+#define SC_BENCH_COUNT_ALLOCATIONS
+#include "bench.h"
+#include "vector.h"
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * sc::vector against std::vector, operation by operation, for int, a 64-byte POD and std::string, at
+ * sizes from 16 up to --max-size (default 1M; pass 100000000 for the full 100M sweep). Prints ns/op,
+ * allocations/op and, when perf_event_open is allowed, cycles, instructions and cache misses per op.
+ *
+ *     bench_vector_vs_std [--max-size N] [--filter text] [--json file] [--reps R]
+ *
+ * The JSON file is what bench/compare.py checks against a stored baseline.
+ *
+ * Operations on a list of n elements (one op = one element or one call):
+ *   push_back, emplace_back, reserve (reserve(n) then n push_back), assign (n copies), copy (copy constructor),
+ *   iterate (read every element), equal (operator== on equal lists) cost O(1) per element;
+ *   insert_front, insert_middle, insert_end, erase_middle, push_front/pop_front are up to 1000 single-element
+ *   calls on a list of n elements; the ones that shift O(n) elements make fewer calls on large lists and are
+ *   only run while n <= 1M. std::vector has no push_front/pop_front:
+ *   insert( begin() ) and erase( begin() ) stand in for them.
+ * Small sizes run on a batch of lists so that every measurement covers at least 64K elements.
+*/
+struct pod64{
+	std::uint64_t key;
+	std::uint64_t payload[7];
+
+	friend bool operator==( const pod64& a, const pod64& b )
+	{ return a.key == b.key && std::equal( a.payload, a.payload + 7, b.payload ); }
+};
+
+template< typename T > T make_value( std::size_t i );
+template<> int make_value<int>( std::size_t i ) { return static_cast<int>( i * 2654435761u ); }
+template<> pod64 make_value<pod64>( std::size_t i ) { return pod64{ i, { i, i + 1, i + 2, i + 3, i + 4, i + 5, i + 6 } }; }
+template<> std::string make_value<std::string>( std::size_t i ) { return "element number " + std::to_string( i ); } // fora do SSO.
+
+/// emplace_back with constructor arguments other than a T.
+template< typename V >
+void emplace_one( V& v, std::size_t i )
+{
+	typedef typename V::value_type T;
+	if constexpr ( std::is_same< T, std::string >::value )
+		v.emplace_back( 20, static_cast<char>( 'a' + i % 26 ) );
+	else if constexpr ( std::is_same< T, pod64 >::value )
+		v.emplace_back( pod64{ i, { 0, 0, 0, 0, 0, 0, 0 } } );
+	else
+		v.emplace_back( static_cast<T>( i ) );
+}
+
+template< typename T > void push_front( sc::vector<T>& v, const T& x ) { v.push_front( x ); }
+template< typename T > void push_front( std::vector<T>& v, const T& x ) { v.insert( v.begin(), x ); }
+template< typename T > void pop_front( sc::vector<T>& v ) { v.pop_front(); }
+template< typename T > void pop_front( std::vector<T>& v ) { v.erase( v.begin() ); }
+
+inline std::size_t weight( int x ) { return static_cast<std::size_t>( x ); }
+inline std::size_t weight( const pod64& x ) { return x.key; }
+inline std::size_t weight( const std::string& x ) { return x.size(); }
+
+/// One measurement: best wall time of several repetitions, with the counters of that repetition.
+struct result{
+	double ns_per_op = 0;
+	double allocations_per_op = 0;
+	double cycles_per_op = -1; //!< -1 when the counter is unavailable.
+	double instructions_per_op = -1;
+	double cache_misses_per_op = -1;
+};
+
+struct record{
+	std::string op;
+	std::string type;
+	std::size_t size;
+	const char* container;
+	result r;
+};
+
+class suite{
+	public:
+		int reps = 5;
+		std::size_t max_size = 1000000;
+		std::string filter;
+
+#ifdef __linux__
+		suite( void ):
+			m_cycles( PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES ),
+			m_instructions( PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS ),
+			m_cache_misses( PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES )
+		{ /* empty */ }
+#else
+		suite( void ): m_cycles( 0, 0 ), m_instructions( 0, 0 ), m_cache_misses( 0, 0 )
+		{ /* empty */ }
+#endif
+
+		bool counters( void )const { return m_cycles.available(); }
+
+		bool selected( const std::string& op, const char* type )const
+		{ return filter.empty() || ( op + "/" + type ).find( filter ) != std::string::npos; }
+
+		/**
+		 * runs setup() then fn() reps times; fn() performs ops operations.
+		*/
+		template< typename Setup, typename Fn >
+		result measure( std::size_t ops, Setup setup, Fn fn )
+		{
+			result best;
+			for( int r = 0; r < reps; r++ )
+			{
+				setup();
+				std::size_t allocs = sc_bench::allocations;
+				m_cycles.start();
+				m_instructions.start();
+				m_cache_misses.start();
+				double ns = sc_bench::best_of( 1, []{}, fn );
+				long long cache_misses = m_cache_misses.stop();
+				long long instructions = m_instructions.stop();
+				long long cycles = m_cycles.stop();
+				allocs = sc_bench::allocations - allocs;
+				if( r == 0 || ns / ops < best.ns_per_op )
+				{
+					best.ns_per_op = ns / ops;
+					best.allocations_per_op = double( allocs ) / ops;
+					best.cycles_per_op = ( cycles < 0 ) ? -1 : double( cycles ) / ops;
+					best.instructions_per_op = ( instructions < 0 ) ? -1 : double( instructions ) / ops;
+					best.cache_misses_per_op = ( cache_misses < 0 ) ? -1 : double( cache_misses ) / ops;
+				}
+			}
+			return best;
+		}
+
+		void add( const std::string& op, const char* type, std::size_t n, const result& sc, const result& std )
+		{
+			std::printf( "%-14s %-7s n=%-10zu sc %9.2f ns  std %9.2f ns  ratio %5.2f  allocs/op sc %.3f std %.3f",
+			             op.c_str(), type, n, sc.ns_per_op, std.ns_per_op, sc.ns_per_op / std.ns_per_op,
+			             sc.allocations_per_op, std.allocations_per_op );
+			if( sc.cycles_per_op >= 0 )
+				std::printf( "  cyc/op sc %.1f std %.1f", sc.cycles_per_op, std.cycles_per_op );
+			std::printf( "\n" );
+			m_records.push_back( record{ op, type, n, "sc::vector", sc } );
+			m_records.push_back( record{ op, type, n, "std::vector", std } );
+		}
+
+		/**
+		 * writes every record as JSON (see bench/compare.py).
+		*/
+		bool write_json( const char* path )const
+		{
+			std::FILE* out = std::fopen( path, "w" );
+			if( out == nullptr )
+				return false;
+			std::fprintf( out, "{\n  \"context\": { \"compiler\": \"%s\", \"cplusplus\": %ld, \"counters\": %s },\n  \"benchmarks\": [\n",
+			              __VERSION__, long( __cplusplus ), counters() ? "true" : "false" );
+			for( std::size_t i = 0; i < m_records.size(); i++ )
+			{
+				const record& rec = m_records[i];
+				std::fprintf( out, "    { \"name\": \"%s/%s/%zu\", \"op\": \"%s\", \"type\": \"%s\", \"size\": %zu, \"container\": \"%s\", "
+				                   "\"ns_per_op\": %.4f, \"allocations_per_op\": %.6f",
+				              rec.op.c_str(), rec.type.c_str(), rec.size, rec.op.c_str(), rec.type.c_str(), rec.size, rec.container,
+				              rec.r.ns_per_op, rec.r.allocations_per_op );
+				print_counter( out, "cycles_per_op", rec.r.cycles_per_op );
+				print_counter( out, "instructions_per_op", rec.r.instructions_per_op );
+				print_counter( out, "cache_misses_per_op", rec.r.cache_misses_per_op );
+				std::fprintf( out, " }%s\n", ( i + 1 < m_records.size() ) ? "," : "" );
+			}
+			std::fprintf( out, "  ]\n}\n" );
+			return std::fclose( out ) == 0;
+		}
+
+	private:
+		static void print_counter( std::FILE* out, const char* name, double value )
+		{
+			if( value < 0 )
+				std::fprintf( out, ", \"%s\": null", name );
+			else
+				std::fprintf( out, ", \"%s\": %.3f", name, value );
+		}
+
+		sc_bench::perf_counter m_cycles;
+		sc_bench::perf_counter m_instructions;
+		sc_bench::perf_counter m_cache_misses;
+		std::vector<record> m_records;
+};
+
+/**
+ * measures operation op on containers V (sc::vector<T> or std::vector<T>) of n elements.
+*/
+template< typename V >
+result run_op( suite& s, const std::string& op, std::size_t n, const std::vector<typename V::value_type>& values )
+{
+	typedef typename V::value_type T;
+	const std::size_t batch = std::max<std::size_t>( 1, ( std::size_t( 1 ) << 16 ) / n );
+	// Chamadas por lista nas operações pontuais; as que deslocam a lista param em ~64 MiB movidos por repetição.
+	std::size_t k = std::min<std::size_t>( n, 1000 );
+	if( op != "insert_end" )
+		k = std::min( k, std::max<std::size_t>( 16, ( std::size_t( 64 ) << 20 ) / ( n * sizeof(T) ) ) );
+	std::vector<V> pool( batch );
+	auto empty = [&]{ for( V& v : pool ) v = V(); };
+	auto full = [&]{
+		for( V& v : pool )
+		{
+			v = V();
+			for( std::size_t i = 0; i < n; i++ )
+				v.push_back( values[i] );
+		}
+	};
+	std::size_t sink = 0;
+	result r;
+
+	if( op == "push_back" )
+		r = s.measure( batch * n, empty, [&]{ for( V& v : pool ) for( std::size_t i = 0; i < n; i++ ) v.push_back( values[i] ); } );
+	else if( op == "emplace_back" )
+		r = s.measure( batch * n, empty, [&]{ for( V& v : pool ) for( std::size_t i = 0; i < n; i++ ) emplace_one( v, i ); } );
+	else if( op == "reserve" )
+		r = s.measure( batch * n, empty, [&]{
+			for( V& v : pool )
+			{
+				v.reserve( n );
+				for( std::size_t i = 0; i < n; i++ )
+					v.push_back( values[i] );
+			} } );
+	else if( op == "assign" )
+		r = s.measure( batch * n, empty, [&]{ for( V& v : pool ) v.assign( n, values[0] ); } );
+	else if( op == "copy" )
+	{
+		V src( values.begin(), values.end() );
+		std::vector< std::optional<V> > copies( batch );
+		r = s.measure( batch * n, [&]{ for( auto& c : copies ) c.reset(); }, [&]{ for( auto& c : copies ) c.emplace( src ); } );
+	}
+	else if( op == "iterate" )
+		r = s.measure( batch * n, full, [&]{
+			for( const V& v : pool )
+				for( const T& x : v )
+					sink += weight( x ); } );
+	else if( op == "equal" )
+	{
+		std::vector<V> other( batch, V( values.begin(), values.end() ) );
+		r = s.measure( batch * n, full, [&]{
+			for( std::size_t b = 0; b < batch; b++ )
+				sink += ( pool[b] == other[b] ); } );
+	}
+	else if( op == "insert_front" || op == "insert_middle" || op == "insert_end" )
+	{
+		const int where = ( op == "insert_front" ) ? 0 : ( op == "insert_end" ) ? 2 : 1;
+		r = s.measure( batch * k, full, [&]{
+			for( V& v : pool )
+				for( std::size_t i = 0; i < k; i++ )
+					v.insert( v.begin() + v.size() * where / 2, values[i] ); } );
+	}
+	else if( op == "erase_middle" )
+		r = s.measure( batch * k, full, [&]{
+			for( V& v : pool )
+				for( std::size_t i = 0; i < k; i++ )
+					v.erase( v.begin() + v.size() / 2 ); } );
+	else if( op == "push_pop_front" )
+		r = s.measure( 2 * batch * k, full, [&]{
+			for( V& v : pool )
+			{
+				for( std::size_t i = 0; i < k; i++ )
+					push_front( v, values[i] );
+				for( std::size_t i = 0; i < k; i++ )
+					pop_front( v );
+			} } );
+	sc_bench::do_not_optimize( sink );
+	return r;
+}
+
+template< typename T >
+void run_type( suite& s, const char* type )
+{
+	static const char* const linear_ops[] = { "push_back", "emplace_back", "reserve", "assign", "copy", "iterate", "equal", "insert_end" };
+	static const char* const shifting_ops[] = { "insert_front", "insert_middle", "erase_middle", "push_pop_front" };
+	static const std::size_t sizes[] = { 16, 1024, 65536, 1000000, 16000000, 100000000 };
+	for( std::size_t n : sizes )
+	{
+		if( n > s.max_size )
+			break;
+		std::vector<T> values( n );
+		for( std::size_t i = 0; i < n; i++ )
+			values[i] = make_value<T>( i );
+		for( const char* op : linear_ops )
+			if( s.selected( op, type ) )
+				s.add( op, type, n, run_op< sc::vector<T> >( s, op, n, values ), run_op< std::vector<T> >( s, op, n, values ) );
+		if( n > 1000000 )
+			continue; // cada chamada desloca O(n) elementos.
+		for( const char* op : shifting_ops )
+			if( s.selected( op, type ) )
+				s.add( op, type, n, run_op< sc::vector<T> >( s, op, n, values ), run_op< std::vector<T> >( s, op, n, values ) );
+	}
+}
+
+int main( int argc, char* argv[] )
+{
+	suite s;
+	const char* json = nullptr;
+	for( int i = 1; i < argc; i++ )
+	{
+		std::string arg = argv[i];
+		if( arg == "--json" && i + 1 < argc )
+			json = argv[++i];
+		else if( arg == "--max-size" && i + 1 < argc )
+			s.max_size = std::strtoull( argv[++i], nullptr, 10 );
+		else if( arg == "--filter" && i + 1 < argc )
+			s.filter = argv[++i];
+		else if( arg == "--reps" && i + 1 < argc )
+			s.reps = std::max( 1, std::atoi( argv[++i] ) );
+		else
+		{
+			std::fprintf( stderr, "usage: %s [--max-size N] [--filter text] [--json file] [--reps R]\n", argv[0] );
+			return 2;
+		}
+	}
+	if( !s.counters() )
+		std::printf( "perf_event_open unavailable: hardware counters not shown\n" );
+
+	run_type<int>( s, "int" );
+	run_type<pod64>( s, "pod64" );
+	run_type<std::string>( s, "string" );
+
+	if( json != nullptr && !s.write_json( json ) )
+	{
+		std::fprintf( stderr, "cannot write %s\n", json );
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,188 @@
+#ifndef ALIGNED_ALLOCATOR_H
+#define ALIGNED_ALLOCATOR_H
+#include "vector.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint> // std::uintptr_t
+#include <new> // operator new( size, align_val_t ), std::bad_alloc
+#include <type_traits>
+#ifdef __linux__
+#include <sys/mman.h> // mmap, munmap, madvise
+#endif
+
+namespace sc{
+	/**
+	 * Stateless allocator whose blocks start at a multiple of Alignment bytes: 64 puts every block on a
+	 * cache line (so a SIMD loop over data() never splits a load across lines and needs no peeling),
+	 * 4096 on a page.
+	*/
+	template < typename T, std::size_t Alignment = 64 >
+	class aligned_allocator{
+		static_assert( Alignment != 0 && ( Alignment & ( Alignment - 1 ) ) == 0, "sc::aligned_allocator: Alignment must be a power of two" );
+		static_assert( Alignment >= alignof(T), "sc::aligned_allocator: Alignment is smaller than alignof(T)" );
+		public:
+			typedef T value_type;
+			typedef std::true_type is_always_equal;
+			static constexpr std::size_t alignment = Alignment;
+
+			template < typename U >
+			struct rebind{ typedef aligned_allocator< U, ( Alignment > alignof(U) ) ? Alignment : alignof(U) > other; };
+
+			aligned_allocator( void ) = default;
+
+			template < typename U, std::size_t A >
+			aligned_allocator( const aligned_allocator< U, A >& )
+			{ /* empty */ }
+
+			/**
+			 * obtains raw storage for n objects, aligned to Alignment bytes.
+			*/
+			T* allocate( std::size_t n )
+			{
+				if( n > std::size_t( -1 ) / sizeof(T) )
+					throw std::bad_alloc();
+				return static_cast<T*>( ::operator new( n * sizeof(T), std::align_val_t( Alignment ) ) );
+			}
+
+			/**
+			 * returns storage obtained by allocate().
+			*/
+			void deallocate( T* p, std::size_t n )
+			{ ::operator delete( static_cast<void*>( p ), n * sizeof(T), std::align_val_t( Alignment ) ); }
+
+			friend bool operator==( const aligned_allocator&, const aligned_allocator& )
+			{ return true; }
+
+			friend bool operator!=( const aligned_allocator&, const aligned_allocator& )
+			{ return false; }
+	};
+
+	/// How the blocks of sc::huge_page_allocator were obtained so far (process-wide counters).
+	struct huge_page_stats{
+		static std::atomic<std::size_t>& explicit_pages( void ) //!< Blocks from the hugetlbfs pool (MAP_HUGETLB).
+		{ static std::atomic<std::size_t> n{ 0 }; return n; }
+		static std::atomic<std::size_t>& transparent( void ) //!< Blocks mapped with madvise( MADV_HUGEPAGE ) accepted.
+		{ static std::atomic<std::size_t> n{ 0 }; return n; }
+		static std::atomic<std::size_t>& small_pages( void ) //!< Large blocks that only got ordinary pages.
+		{ static std::atomic<std::size_t> n{ 0 }; return n; }
+	};
+
+	/**
+	 * Allocator for large arrays that are streamed over: blocks of at least Threshold bytes are backed by
+	 * 2 MiB huge pages, so a 1 GiB array needs 512 TLB entries instead of 262144. Small blocks come from
+	 * aligned_allocator<T, Alignment>.
+	 *
+	 * A large block is rounded up to whole huge pages and mapped with MAP_HUGETLB, which succeeds only
+	 * when the administrator reserved pages (vm.nr_hugepages). Otherwise it is mapped normally at a
+	 * 2 MiB boundary and madvise( MADV_HUGEPAGE ) asks for transparent huge pages; if that is refused
+	 * too, the block simply keeps 4 KiB pages. Allocation never fails because huge pages are missing.
+	 * Off Linux every block comes from aligned_allocator.
+	*/
+	template < typename T, std::size_t Threshold = std::size_t( 4 ) << 20, std::size_t Alignment = 64 >
+	class huge_page_allocator{
+		public:
+			typedef T value_type;
+			typedef std::true_type is_always_equal;
+			static constexpr std::size_t huge_page = std::size_t( 2 ) << 20;
+
+			template < typename U >
+			struct rebind{ typedef huge_page_allocator< U, Threshold, ( Alignment > alignof(U) ) ? Alignment : alignof(U) > other; };
+
+			huge_page_allocator( void ) = default;
+
+			template < typename U, std::size_t A >
+			huge_page_allocator( const huge_page_allocator< U, Threshold, A >& )
+			{ /* empty */ }
+
+			/**
+			 * obtains raw storage for n objects.
+			*/
+			T* allocate( std::size_t n )
+			{
+				if( n > ( std::size_t( -1 ) - 2 * huge_page ) / sizeof(T) )
+					throw std::bad_alloc();
+				std::size_t bytes = n * sizeof(T);
+				if( !is_mapped( bytes ) )
+					return small().allocate( n );
+#ifdef __linux__
+				std::size_t length = round_up( bytes );
+				void* p = ::mmap( nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0 );
+				if( p != MAP_FAILED )
+				{
+					huge_page_stats::explicit_pages().fetch_add( 1, std::memory_order_relaxed );
+					return static_cast<T*>( p );
+				}
+				// Sem páginas reservadas: mapear com folga para alinhar em 2 MiB e cortar as sobras.
+				char* raw = static_cast<char*>( ::mmap( nullptr, length + huge_page, PROT_READ | PROT_WRITE,
+				                                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 ) );
+				if( raw == MAP_FAILED )
+					throw std::bad_alloc();
+				std::uintptr_t at = reinterpret_cast<std::uintptr_t>( raw );
+				char* aligned = raw + ( ( huge_page - at % huge_page ) % huge_page );
+				if( aligned != raw )
+					::munmap( raw, aligned - raw );
+				if( aligned + length != raw + length + huge_page )
+					::munmap( aligned + length, ( raw + length + huge_page ) - ( aligned + length ) );
+				if( ::madvise( aligned, length, MADV_HUGEPAGE ) == 0 )
+					huge_page_stats::transparent().fetch_add( 1, std::memory_order_relaxed );
+				else
+					huge_page_stats::small_pages().fetch_add( 1, std::memory_order_relaxed );
+				return reinterpret_cast<T*>( aligned );
+#else
+				return small().allocate( n );
+#endif
+			}
+
+			/**
+			 * returns storage obtained by allocate().
+			*/
+			void deallocate( T* p, std::size_t n )
+			{
+				std::size_t bytes = n * sizeof(T);
+				if( !is_mapped( bytes ) )
+				{
+					small().deallocate( p, n );
+					return;
+				}
+#ifdef __linux__
+				::munmap( static_cast<void*>( p ), round_up( bytes ) );
+#endif
+			}
+
+			friend bool operator==( const huge_page_allocator&, const huge_page_allocator& )
+			{ return true; }
+
+			friend bool operator!=( const huge_page_allocator&, const huge_page_allocator& )
+			{ return false; }
+
+		private:
+			static aligned_allocator<T, Alignment> small( void )
+			{ return aligned_allocator<T, Alignment>(); }
+
+			static std::size_t round_up( std::size_t bytes )
+			{ return ( bytes + huge_page - 1 ) / huge_page * huge_page; }
+
+			static bool is_mapped( std::size_t bytes )
+			{
+#ifdef __linux__
+				return bytes >= Threshold;
+#else
+				(void) bytes;
+				return false;
+#endif
+			}
+	};
+
+	/**
+	 * sc::vector whose data() is aligned to Alignment bytes (a cache line by default).
+	*/
+	template < typename T, std::size_t Alignment = 64, typename GrowthPolicy = sc::doubling_growth >
+	using aligned_vector = sc::vector< T, sc::aligned_allocator<T, Alignment>, GrowthPolicy >;
+
+	/**
+	 * sc::vector that moves to huge pages once its block reaches Threshold bytes.
+	*/
+	template < typename T, std::size_t Threshold = std::size_t( 4 ) << 20, typename GrowthPolicy = sc::doubling_growth >
+	using huge_page_vector = sc::vector< T, sc::huge_page_allocator<T, Threshold>, GrowthPolicy >;
+}// namespace sc
+#endif
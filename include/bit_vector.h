@@ -0,0 +1,539 @@
+#ifndef BIT_VECTOR_H
+#define BIT_VECTOR_H
+#include "packed_vector.h"
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory> // std::allocator
+#include <stdexcept> // std::out_of_range, std::length_error
+
+#if defined(__GNUC__) && !defined(__clang__) && ( defined(__x86_64__) || defined(__i386__) )
+#define SC_BITS_POPCNT_DISPATCH 1
+#endif
+
+namespace sc{
+namespace detail{
+	/// number of set bits in each byte of w, byte by byte.
+	inline std::uint64_t byte_counts( std::uint64_t w )
+	{
+		w = w - ( ( w >> 1 ) & 0x5555555555555555ULL );
+		w = ( w & 0x3333333333333333ULL ) + ( ( w >> 2 ) & 0x3333333333333333ULL );
+		return ( w + ( w >> 4 ) ) & 0x0F0F0F0F0F0F0F0FULL;
+	}
+
+	/**
+	 * number of set bits of w. Without -mpopcnt, __builtin_popcountll is a library call; the bit tricks
+	 * below are inlined and several times faster.
+	*/
+	inline unsigned popcount64( std::uint64_t w )
+	{
+#ifdef __POPCNT__
+		return static_cast<unsigned>( __builtin_popcountll( w ) );
+#else
+		return static_cast<unsigned>( ( byte_counts( w ) * 0x0101010101010101ULL ) >> 56 );
+#endif
+	}
+
+	/**
+	 * position of the (k+1)-th set bit of w (k < popcount64( w )): finds the byte through the running
+	 * byte counts, then clears the lower set bits of that byte.
+	*/
+	inline unsigned select64( std::uint64_t w, unsigned k )
+	{
+		std::uint64_t prefix = byte_counts( w ) * 0x0101010101010101ULL; // byte b: bits 1 nos bytes 0 a b.
+		unsigned shift = 0, before = 0;
+		for( ; shift < 56; shift += 8 )
+		{
+			unsigned upto = static_cast<unsigned>( ( prefix >> shift ) & 0xFF );
+			if( upto > k ) break;
+			before = upto;
+		}
+		unsigned byte = static_cast<unsigned>( ( w >> shift ) & 0xFF );
+		for( k -= before; k > 0; k-- )
+			byte &= byte - 1; // apaga o bit 1 mais baixo.
+		return shift + static_cast<unsigned>( __builtin_ctz( byte ) );
+	}
+
+	inline std::size_t count_ones_generic( const std::uint64_t* words, std::size_t n )
+	{
+		std::size_t total = 0;
+		for( std::size_t i = 0; i < n; i++ )
+			total += popcount64( words[i] );
+		return total;
+	}
+
+#ifdef SC_BITS_POPCNT_DISPATCH
+#pragma GCC push_options
+#pragma GCC target("popcnt")
+	/// same as count_ones_generic, with the popcnt instruction and four counters.
+	inline std::size_t count_ones_popcnt( const std::uint64_t* words, std::size_t n )
+	{
+		std::size_t c0 = 0, c1 = 0, c2 = 0, c3 = 0, i = 0;
+		for( ; i + 4 <= n; i += 4 )
+		{
+			c0 += __builtin_popcountll( words[i] );
+			c1 += __builtin_popcountll( words[i + 1] );
+			c2 += __builtin_popcountll( words[i + 2] );
+			c3 += __builtin_popcountll( words[i + 3] );
+		}
+		for( ; i < n; i++ )
+			c0 += __builtin_popcountll( words[i] );
+		return ( c0 + c1 ) + ( c2 + c3 );
+	}
+#pragma GCC pop_options
+#endif
+
+	/**
+	 * number of set bits in words[0, n). Uses the popcnt instruction when the CPU has it (checked once),
+	 * popcount64 word by word otherwise.
+	*/
+	inline std::size_t count_ones( const std::uint64_t* words, std::size_t n )
+	{
+#ifdef SC_BITS_POPCNT_DISPATCH
+		static const bool has_popcnt = __builtin_cpu_supports( "popcnt" );
+		if( has_popcnt )
+			return count_ones_popcnt( words, n );
+#endif
+		return count_ones_generic( words, n );
+	}
+}// namespace detail
+
+/**
+ * Dynamic list of bits, 64 to a word. Unlike std::vector<bool> it is not a specialization of
+ * sc::vector, and it adds whole-list operations that work a word at a time: &=, |=, ^=, flip(),
+ * count(), and the rank()/select() queries. For repeated rank/select on a list that does not change,
+ * build a sc::rank_select over it.
+ *
+ * Bits past size() in the last word are always zero, so word operations need no masking.
+ *  @tparam Allocator  allocator of the 64-bit words.
+*/
+template< typename Allocator = std::allocator<std::uint64_t> >
+class bit_vector{
+	typedef detail::packed_bits<1> bits;
+
+	public:
+		typedef bool value_type;
+		typedef Allocator allocator_type;
+		typedef std::size_t size_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef detail::packed_reference<1, bool> reference;
+		typedef bool const_reference;
+		typedef detail::packed_iterator<1, bool, false> iterator;
+		typedef detail::packed_iterator<1, bool, true> const_iterator;
+		typedef std::reverse_iterator<iterator> reverse_iterator;
+		typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+		typedef sc::vector<std::uint64_t, Allocator> word_container;
+
+		static constexpr size_t npos = static_cast<size_t>( -1 ); //!< Returned by select() and find_*() when there is no such bit.
+
+	private:
+		word_container m_words; //!< ( m_size + 63 ) / 64 words.
+		size_t m_size;
+
+		static size_t words_for( size_t n ) { return ( n + 63 ) / 64; }
+
+		/// zeroes the bits of the last word past m_size.
+		void trim( void )
+		{
+			if( m_size % 64 != 0 )
+				m_words.back() &= ( std::uint64_t( 1 ) << ( m_size % 64 ) ) - 1;
+		}
+
+		void check_same_size( const bit_vector& other )const
+		{
+			if( other.m_size != m_size )
+				throw std::length_error( "sc::bit_vector: operands of different sizes" );
+		}
+
+	public:
+		//=== [I] SPECIAL MEMBERS
+
+		/**
+		 * Constructs an empty list.
+		*/
+		explicit bit_vector( const Allocator& alloc = Allocator() ): m_words( alloc ), m_size{ 0 }
+		{ /* empty */ }
+
+		/**
+		 * Constructs the list with count bits equal to value.
+		*/
+		bit_vector( size_t count, bool value, const Allocator& alloc = Allocator() ): bit_vector( alloc )
+		{ resize( count, value ); }
+
+		/**
+		 * Constructs the list with the bits of the range [first, last).
+		*/
+		template< typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category >
+		bit_vector( InputIt first, InputIt last, const Allocator& alloc = Allocator() ): bit_vector( alloc )
+		{
+			for( ; first != last; ++first )
+				push_back( static_cast<bool>( *first ) );
+		}
+
+		/**
+		 * Constructs the list with the bits of ilist.
+		*/
+		bit_vector( std::initializer_list<bool> ilist, const Allocator& alloc = Allocator() ):
+			bit_vector( ilist.begin(), ilist.end(), alloc )
+		{ /* empty */ }
+
+		//=== [II] ITERATORS
+
+		iterator begin( void ) { return iterator( m_words.data(), 0 ); }
+		iterator end( void ) { return iterator( m_words.data(), m_size ); }
+		const_iterator begin( void )const { return const_iterator( m_words.data(), 0 ); }
+		const_iterator end( void )const { return const_iterator( m_words.data(), m_size ); }
+		const_iterator cbegin( void )const { return begin(); }
+		const_iterator cend( void )const { return end(); }
+		reverse_iterator rbegin( void ) { return reverse_iterator( end() ); }
+		reverse_iterator rend( void ) { return reverse_iterator( begin() ); }
+		const_reverse_iterator rbegin( void )const { return const_reverse_iterator( end() ); }
+		const_reverse_iterator rend( void )const { return const_reverse_iterator( begin() ); }
+
+		//=== [III] Capacity
+
+		size_t size( void )const { return m_size; }
+		bool empty( void )const { return m_size == 0; }
+		size_t capacity( void )const { return m_words.capacity() * 64; }
+		void reserve( size_t new_cap ) { m_words.reserve( words_for( new_cap ) ); }
+		void shrink_to_fit( void ) { m_words.shrink_to_fit(); }
+
+		/**
+		 * bytes of storage in use (the words holding size() bits).
+		*/
+		size_t size_in_bytes( void )const { return m_words.size() * sizeof(std::uint64_t); }
+
+		//=== [IV] Modifiers
+
+		void clear( void )
+		{
+			m_words.clear();
+			m_size = 0;
+		}
+
+		void push_back( bool value )
+		{
+			if( m_size % 64 == 0 )
+				m_words.push_back( 0 );
+			m_words.back() |= std::uint64_t( value ) << ( m_size % 64 );
+			m_size++;
+		}
+
+		void pop_back( void )
+		{
+			if( m_size != 0 )
+				resize( m_size - 1 );
+		}
+
+		/**
+		 * changes the size to count; new bits are equal to value.
+		*/
+		void resize( size_t count, bool value = false )
+		{
+			if( count > m_size && value )
+			{
+				// completa a última palavra e depois acrescenta palavras cheias.
+				if( m_size % 64 != 0 )
+					m_words.back() |= ~std::uint64_t( 0 ) << ( m_size % 64 );
+				m_words.reserve( words_for( count ) );
+				while( m_words.size() < words_for( count ) )
+					m_words.push_back( ~std::uint64_t( 0 ) );
+			}
+			else
+			{
+				m_words.reserve( words_for( count ) );
+				while( m_words.size() < words_for( count ) )
+					m_words.push_back( 0 );
+				while( m_words.size() > words_for( count ) )
+					m_words.pop_back();
+			}
+			m_size = count;
+			trim();
+		}
+
+		/**
+		 * sets the bit at pos to value, with no bounds-checking.
+		*/
+		void set( size_t pos, bool value = true )
+		{
+			std::uint64_t mask = std::uint64_t( 1 ) << ( pos % 64 );
+			std::uint64_t& w = m_words[pos / 64];
+			w = ( w & ~mask ) | ( -std::uint64_t( value ) & mask );
+		}
+
+		void reset( size_t pos ) { m_words[pos / 64] &= ~( std::uint64_t( 1 ) << ( pos % 64 ) ); }
+		void flip( size_t pos ) { m_words[pos / 64] ^= std::uint64_t( 1 ) << ( pos % 64 ); }
+
+		/**
+		 * sets every bit to value.
+		*/
+		void fill( bool value )
+		{
+			for( size_t i = 0; i < m_words.size(); i++ )
+				m_words[i] = value ? ~std::uint64_t( 0 ) : 0;
+			trim();
+		}
+
+		/**
+		 * inverts every bit.
+		*/
+		void flip( void )
+		{
+			for( size_t i = 0; i < m_words.size(); i++ )
+				m_words[i] = ~m_words[i];
+			trim();
+		}
+
+		/**
+		 * Bitwise operations with a list of the same size, a word at a time.
+		 * @throws std::length_error if the sizes differ.
+		*/
+		bit_vector& operator&=( const bit_vector& other )
+		{
+			check_same_size( other );
+			for( size_t i = 0; i < m_words.size(); i++ )
+				m_words[i] &= other.m_words[i];
+			return *this;
+		}
+
+		bit_vector& operator|=( const bit_vector& other )
+		{
+			check_same_size( other );
+			for( size_t i = 0; i < m_words.size(); i++ )
+				m_words[i] |= other.m_words[i];
+			return *this;
+		}
+
+		bit_vector& operator^=( const bit_vector& other )
+		{
+			check_same_size( other );
+			for( size_t i = 0; i < m_words.size(); i++ )
+				m_words[i] ^= other.m_words[i];
+			return *this;
+		}
+
+		friend bit_vector operator&( bit_vector lhs, const bit_vector& rhs ) { return lhs &= rhs; }
+		friend bit_vector operator|( bit_vector lhs, const bit_vector& rhs ) { return lhs |= rhs; }
+		friend bit_vector operator^( bit_vector lhs, const bit_vector& rhs ) { return lhs ^= rhs; }
+
+		bit_vector operator~( void )const
+		{
+			bit_vector result( *this );
+			result.flip();
+			return result;
+		}
+
+		void swap( bit_vector& other ) noexcept
+		{
+			m_words.swap( other.m_words );
+			std::swap( m_size, other.m_size );
+		}
+
+		//=== [V] Element access
+
+		/**
+		 * returns the bit at pos, with no bounds-checking.
+		*/
+		bool test( size_t pos )const { return ( m_words[pos / 64] >> ( pos % 64 ) ) & 1; }
+
+		bool operator[]( size_t pos )const { return test( pos ); }
+		reference operator[]( size_t pos ) { return reference( m_words.data(), pos ); }
+
+		/**
+		 * returns the bit at pos, with bounds-checking.
+		 * @throws std::out_of_range if pos >= size().
+		*/
+		bool at( size_t pos )const
+		{
+			if( pos >= m_size )
+				throw std::out_of_range( "[bit_vector::at()] out of range error" );
+			return test( pos );
+		}
+
+		reference at( size_t pos )
+		{
+			if( pos >= m_size )
+				throw std::out_of_range( "[bit_vector::at()] out of range error" );
+			return reference( m_words.data(), pos );
+		}
+
+		bool front( void )const { return test( 0 ); }
+		bool back( void )const { return test( m_size - 1 ); }
+
+		//=== [VI] Queries
+
+		/**
+		 * returns the number of set bits.
+		*/
+		size_t count( void )const { return detail::count_ones( m_words.data(), m_words.size() ); }
+
+		bool any( void )const
+		{
+			for( size_t i = 0; i < m_words.size(); i++ )
+				if( m_words[i] != 0 ) return true;
+			return false;
+		}
+
+		bool none( void )const { return !any(); }
+		bool all( void )const { return count() == m_size; }
+
+		/**
+		 * returns the number of set bits in [0, pos), pos <= size(). O(pos / 64); see sc::rank_select
+		 * for O(1).
+		*/
+		size_t rank( size_t pos )const
+		{
+			size_t r = detail::count_ones( m_words.data(), pos / 64 );
+			if( pos % 64 != 0 )
+				r += detail::popcount64( m_words[pos / 64] & ( ( std::uint64_t( 1 ) << ( pos % 64 ) ) - 1 ) );
+			return r;
+		}
+
+		/**
+		 * returns the position of the (k+1)-th set bit, or npos if there are at most k set bits.
+		 * O(size() / 64); see sc::rank_select for O(log(size())).
+		*/
+		size_t select( size_t k )const
+		{
+			for( size_t i = 0; i < m_words.size(); i++ )
+			{
+				unsigned c = detail::popcount64( m_words[i] );
+				if( k < c )
+					return i * 64 + detail::select64( m_words[i], static_cast<unsigned>( k ) );
+				k -= c;
+			}
+			return npos;
+		}
+
+		/**
+		 * returns the position of the first set bit at or after pos, or npos if there is none. Skips
+		 * zero words whole, so visiting all set bits with find_next( i + 1 ) costs O(size() / 64 + count()).
+		*/
+		size_t find_next( size_t pos )const
+		{
+			if( pos >= m_size ) return npos;
+			size_t i = pos / 64;
+			std::uint64_t w = m_words[i] & ( ~std::uint64_t( 0 ) << ( pos % 64 ) );
+			while( w == 0 )
+			{
+				if( ++i == m_words.size() ) return npos;
+				w = m_words[i];
+			}
+			return i * 64 + static_cast<size_t>( __builtin_ctzll( w ) );
+		}
+
+		size_t find_first( void )const { return find_next( 0 ); }
+
+		/**
+		 * writes bits first to first + count - 1 to out as 0 or 1, which has room for them.
+		*/
+		template < typename U >
+		void unpack( size_t first, size_t count, U* out )const
+		{ bits::unpack( m_words.data(), first, count, out ); }
+
+		/**
+		 * appends all the bits to out, as 0 or 1.
+		*/
+		template < typename U, typename A, typename G, typename I >
+		void unpack( sc::vector<U, A, G, I>& out )const
+		{
+			out.reserve( out.size() + m_size );
+			U block[64];
+			for( size_t i = 0; i < m_size; i += 64 )
+			{
+				size_t count = ( m_size - i < 64 ) ? m_size - i : 64;
+				bits::unpack( m_words.data(), i, count, block );
+				out.insert( out.cend(), block, block + count );
+			}
+		}
+
+		/**
+		 * returns the words; bit i is bit i % 64 of word i / 64.
+		*/
+		const word_container& words( void )const { return m_words; }
+
+		friend bool operator==( const bit_vector& lhs, const bit_vector& rhs )
+		{ return lhs.m_size == rhs.m_size && lhs.m_words == rhs.m_words; }
+
+		friend bool operator!=( const bit_vector& lhs, const bit_vector& rhs )
+		{ return !( lhs == rhs ); }
+
+		friend void swap( bit_vector& A, bit_vector& B ) noexcept
+		{ A.swap( B ); }
+};
+
+/**
+ * Index for constant-time rank and logarithmic select over a bit_vector that no longer changes: one
+ * cumulative count per 512 bits (8 words), 12.5% extra memory. It keeps a pointer to the words of the
+ * list, so it must be rebuilt after the list is modified or destroyed.
+*/
+class rank_select{
+	public:
+		static constexpr size_t npos = static_cast<size_t>( -1 );
+
+		template < typename Allocator >
+		explicit rank_select( const bit_vector<Allocator>& bits ):
+			m_words{ bits.words().data() }, m_count{ bits.words().size() }, m_size{ bits.size() }
+		{
+			size_t blocks = ( m_count + 7 ) / 8;
+			m_blocks.reserve( blocks + 1 );
+			size_t total = 0;
+			for( size_t b = 0; b < blocks; b++ )
+			{
+				m_blocks.push_back( total );
+				size_t n = ( m_count - b * 8 < 8 ) ? m_count - b * 8 : 8;
+				total += detail::count_ones( m_words + b * 8, n );
+			}
+			m_blocks.push_back( total );
+		}
+
+		size_t size( void )const { return m_size; }
+		size_t ones( void )const { return m_blocks.back(); }
+
+		/**
+		 * returns the number of set bits in [0, pos), pos <= size().
+		*/
+		size_t rank( size_t pos )const
+		{
+			size_t word = pos / 64, r = m_blocks[word / 8];
+			for( size_t i = word & ~size_t( 7 ); i < word; i++ )
+				r += detail::popcount64( m_words[i] );
+			if( pos % 64 != 0 )
+				r += detail::popcount64( m_words[word] & ( ( std::uint64_t( 1 ) << ( pos % 64 ) ) - 1 ) );
+			return r;
+		}
+
+		/**
+		 * returns the position of the (k+1)-th set bit, or npos if there are at most k set bits: a binary
+		 * search over the blocks, then a scan of at most 8 words.
+		*/
+		size_t select( size_t k )const
+		{
+			if( k >= ones() ) return npos;
+			// último bloco com contagem acumulada <= k.
+			size_t lo = 0, hi = m_blocks.size() - 1;
+			while( hi - lo > 1 )
+			{
+				size_t mid = lo + ( hi - lo ) / 2;
+				if( m_blocks[mid] <= k ) lo = mid;
+				else hi = mid;
+			}
+			k -= m_blocks[lo];
+			for( size_t i = lo * 8; ; i++ )
+			{
+				unsigned c = detail::popcount64( m_words[i] );
+				if( k < c )
+					return i * 64 + detail::select64( m_words[i], static_cast<unsigned>( k ) );
+				k -= c;
+			}
+		}
+
+	private:
+		const std::uint64_t* m_words;
+		size_t m_count; //!< Number of words.
+		size_t m_size; //!< Number of bits.
+		sc::vector<size_t> m_blocks; //!< Set bits before each block of 8 words, plus the total.
+};
+}// namespace sc
+#endif
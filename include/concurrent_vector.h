@@ -0,0 +1,554 @@
+#ifndef CONCURRENT_VECTOR_H
+#define CONCURRENT_VECTOR_H
+
+#include <algorithm> // std::max
+#include <atomic>
+#include <cstddef>
+#include <initializer_list> // std::initializer_list
+#include <iterator>
+#include <memory> // std::allocator, std::allocator_traits
+#include <new> // placement new
+#include <stdexcept> // std::out_of_range, std::length_error
+#include <type_traits>
+#include <utility> // std::forward, std::move
+
+namespace sc {
+
+/**
+ * Growable array that many threads can append to at the same time. The elements live in buckets whose
+ * sizes double (first_bucket, 2 * first_bucket, 4 * first_bucket, ...), so growing only
+ * adds a bucket: an element never moves and references, pointers and iterators stay valid until the
+ * container is cleared or destroyed.
+ *
+ * push_back / emplace_back / grow_by are lock-free: a slot is claimed with one fetch_add on the
+ * claimed count, constructed by the claiming thread and then published. size() counts the published
+ * prefix, so every element below size() is fully constructed and may be read by any thread while
+ * others keep appending. Elements are published in index order: a slot finished early waits (without
+ * blocking its producer) until the slots before it are done.
+ *
+ * Not thread-safe: clear, assignment, swap and the destructor. Writing to the same element from several
+ * threads needs the caller's own synchronization.
+ *
+ * If a constructor throws, the exception reaches the caller of push_back but the slot it claimed stays
+ * unpublished, so size() stops before it for good (the elements after it are kept and destroyed, just
+ * never published).
+*/
+template< typename T, typename Allocator = std::allocator<T> >
+class concurrent_vector{
+	public:
+		typedef T value_type; //!< Type of the elements stored in the list.
+		typedef Allocator allocator_type; //!< Allocator used to obtain the buckets.
+		typedef std::size_t size_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef T& reference;
+		typedef const T& const_reference;
+		typedef T* pointer;
+		typedef const T* const_pointer;
+
+	private:
+		/// Storage of one element plus its publication flag.
+		struct slot{
+			alignas(T) unsigned char value[sizeof(T)];
+			std::atomic<bool> ready;
+
+			T* get( void ) { return reinterpret_cast<T*>( value ); }
+		};
+
+		typedef typename std::allocator_traits<Allocator>::template rebind_alloc<slot> slot_allocator;
+		typedef std::allocator_traits<slot_allocator> slot_traits;
+
+		/// log2 of the number of elements in bucket 0.
+		static constexpr unsigned first_shift = 5;
+		static constexpr size_type first_bucket = size_type( 1 ) << first_shift;
+		static constexpr unsigned max_buckets = sizeof(size_type) * 8 - first_shift;
+
+		slot_allocator m_alloc; //!< Allocator that owns the buckets.
+		std::atomic<slot*> m_buckets[max_buckets]; //!< Bucket k holds first_bucket << k slots.
+		std::atomic<size_type> m_claimed; //!< Slots handed out to producers.
+		std::atomic<size_type> m_size; //!< Published prefix: [0, m_size) is constructed.
+
+	public:
+		/**
+		 * Random-access iterator over the elements, by index. Appends do not invalidate it.
+		*/
+		template< bool Const >
+		class basic_iterator{
+			public:
+				typedef typename std::conditional< Const, const T, T >::type element_type;
+				typedef T value_type;
+				typedef element_type* pointer;
+				typedef element_type& reference;
+				typedef std::ptrdiff_t difference_type;
+				typedef std::random_access_iterator_tag iterator_category;
+			private:
+				typedef typename std::conditional< Const, const concurrent_vector, concurrent_vector >::type owner_type;
+				owner_type* m_owner;
+				size_type m_index;
+			public:
+				basic_iterator( owner_type* owner = nullptr, size_type index = 0 ): m_owner{ owner }, m_index{ index }
+				{ /* empty */ }
+
+				/**
+				 * converts a mutable iterator into a constant one.
+				*/
+				template< bool C = Const, typename = typename std::enable_if<C>::type >
+				basic_iterator( const basic_iterator<false>& other ): m_owner{ other.owner() }, m_index{ other.index() }
+				{ /* empty */ }
+
+				owner_type* owner( void )const { return m_owner; }
+				size_type index( void )const { return m_index; }
+
+				reference operator*( void )const { return ( *m_owner )[m_index]; }
+				pointer operator->( void )const { return &( *m_owner )[m_index]; }
+				reference operator[]( difference_type n )const { return ( *m_owner )[m_index + n]; }
+
+				basic_iterator& operator++( void ) { ++m_index; return *this; }
+				basic_iterator operator++( int ) { basic_iterator t( *this ); ++m_index; return t; }
+				basic_iterator& operator--( void ) { --m_index; return *this; }
+				basic_iterator operator--( int ) { basic_iterator t( *this ); --m_index; return t; }
+				basic_iterator& operator+=( difference_type n ) { m_index += n; return *this; }
+				basic_iterator& operator-=( difference_type n ) { m_index -= n; return *this; }
+
+				friend basic_iterator operator+( basic_iterator it, difference_type n ) { return it += n; }
+				friend basic_iterator operator+( difference_type n, basic_iterator it ) { return it += n; }
+				friend basic_iterator operator-( basic_iterator it, difference_type n ) { return it -= n; }
+				friend difference_type operator-( const basic_iterator& lhs, const basic_iterator& rhs )
+				{ return difference_type( lhs.m_index ) - difference_type( rhs.m_index ); }
+
+				friend bool operator==( const basic_iterator& lhs, const basic_iterator& rhs ) { return lhs.m_index == rhs.m_index; }
+				friend bool operator!=( const basic_iterator& lhs, const basic_iterator& rhs ) { return lhs.m_index != rhs.m_index; }
+				friend bool operator<( const basic_iterator& lhs, const basic_iterator& rhs ) { return lhs.m_index < rhs.m_index; }
+				friend bool operator>( const basic_iterator& lhs, const basic_iterator& rhs ) { return lhs.m_index > rhs.m_index; }
+				friend bool operator<=( const basic_iterator& lhs, const basic_iterator& rhs ) { return lhs.m_index <= rhs.m_index; }
+				friend bool operator>=( const basic_iterator& lhs, const basic_iterator& rhs ) { return lhs.m_index >= rhs.m_index; }
+		};
+
+		typedef basic_iterator<false> iterator;
+		typedef basic_iterator<true> const_iterator;
+
+		//=== [I] SPECIAL MEMBERS
+
+		/**
+		 * Constructs an empty list. No bucket is allocated.
+		*/
+		explicit concurrent_vector( const Allocator& alloc = Allocator() ):
+			m_alloc{ alloc },
+			m_claimed{ 0 },
+			m_size{ 0 }
+		{
+			for( std::atomic<slot*>& b : m_buckets )
+				b.store( nullptr, std::memory_order_relaxed );
+		}
+
+		/**
+		 * Constructs a list with count copies of value.
+		*/
+		concurrent_vector( size_type count, const T& value, const Allocator& alloc = Allocator() ):
+			concurrent_vector( alloc )
+		{
+			reserve( count );
+			for( size_type i = 0; i < count; i++ )
+				push_back( value );
+		}
+
+		/**
+		 * Constructs a list with the contents of ilist.
+		*/
+		concurrent_vector( std::initializer_list<T> ilist, const Allocator& alloc = Allocator() ):
+			concurrent_vector( alloc )
+		{
+			reserve( ilist.size() );
+			for( const T& x : ilist )
+				push_back( x );
+		}
+
+		/**
+		 * Copy constructor: copies the published elements of other. other may be appended to meanwhile.
+		*/
+		concurrent_vector( const concurrent_vector& other ):
+			concurrent_vector( slot_traits::select_on_container_copy_construction( other.m_alloc ) )
+		{
+			size_type n = other.size();
+			reserve( n );
+			for( size_type i = 0; i < n; i++ )
+				push_back( other[i] );
+		}
+
+		/**
+		 * Move constructor: takes the buckets of other, which is left empty. Not thread-safe.
+		*/
+		concurrent_vector( concurrent_vector&& other ) noexcept:
+			concurrent_vector( other.m_alloc )
+		{ steal( other ); }
+
+		/**
+		 * Destroys every constructed element and releases the buckets.
+		*/
+		~concurrent_vector()
+		{ clear(); }
+
+		/**
+		 * Replaces the contents by a copy of the published elements of other. Not thread-safe.
+		*/
+		concurrent_vector& operator=( const concurrent_vector& other )
+		{
+			if( this == &other ) return *this;
+
+			// clear() devolve todos os baldes: o alocador pode ser trocado em seguida.
+			clear();
+			if constexpr ( slot_traits::propagate_on_container_copy_assignment::value )
+				m_alloc = other.m_alloc;
+			size_type n = other.size();
+			reserve( n );
+			for( size_type i = 0; i < n; i++ )
+				push_back( other[i] );
+			return *this;
+		}
+
+		/**
+		 * Replaces the contents by those of other, which is left empty. The buckets of other are taken
+		 * over when the allocators allow it, otherwise the elements are moved one by one. Not thread-safe.
+		*/
+		concurrent_vector& operator=( concurrent_vector&& other ) noexcept( slot_traits::propagate_on_container_move_assignment::value
+		                                                                    || slot_traits::is_always_equal::value )
+		{
+			if( this == &other ) return *this;
+
+			clear();
+			if( slot_traits::propagate_on_container_move_assignment::value || m_alloc == other.m_alloc )
+			{
+				if constexpr ( slot_traits::propagate_on_container_move_assignment::value )
+					m_alloc = std::move( other.m_alloc );
+				steal( other );
+			}
+			else
+			{
+				// Alocadores diferentes: mover elemento a elemento para baldes próprios.
+				size_type n = other.size();
+				reserve( n );
+				for( size_type i = 0; i < n; i++ )
+					push_back( std::move( other[i] ) );
+				other.clear();
+			}
+			return *this;
+		}
+
+		//=== [II] ITERATORS
+
+		/**
+		 * returns an iterator pointing to the first item in the list.
+		*/
+		iterator begin( void ) { return iterator( this, 0 ); }
+
+		/**
+		 * returns an iterator past the last element published when end() is called.
+		*/
+		iterator end( void ) { return iterator( this, size() ); }
+
+		const_iterator begin( void )const { return const_iterator( this, 0 ); }
+		const_iterator end( void )const { return const_iterator( this, size() ); }
+		const_iterator cbegin( void )const { return begin(); }
+		const_iterator cend( void )const { return end(); }
+
+		//=== [III] CAPACITY
+
+		/**
+		 * returns the number of published elements.
+		*/
+		size_type size( void )const
+		{ return m_size.load( std::memory_order_acquire ); }
+
+		/**
+		 * returns true if no element is published.
+		*/
+		bool empty( void )const
+		{ return size() == 0; }
+
+		/**
+		 * returns the number of slots in the allocated buckets (the buckets form a prefix).
+		*/
+		size_type capacity( void )const
+		{
+			size_type k = 0;
+			while( k < max_buckets && m_buckets[k].load( std::memory_order_acquire ) != nullptr )
+				k++;
+			return bucket_base( k );
+		}
+
+		/**
+		 * returns the largest number of elements the list can hold.
+		*/
+		size_type max_size( void )const
+		{ return std::min<size_type>( slot_traits::max_size( m_alloc ), ~size_type( 0 ) - first_bucket ); }
+
+		/**
+		 * allocates the buckets for the first new_cap elements. Thread-safe.
+		*/
+		void reserve( size_type new_cap )
+		{
+			if( new_cap == 0 ) return;
+			if( new_cap > max_size() )
+				throw std::length_error( "sc::concurrent_vector::reserve: new_cap exceeds max_size()" );
+			for( unsigned k = 0; k <= bucket_of( new_cap - 1 ); k++ )
+				bucket( k );
+		}
+
+		//=== [IV] MODIFIERS
+
+		/**
+		 * appends a copy of value. Lock-free; may run concurrently with other appends and with reads.
+		 * @return the new element, whose address never changes.
+		*/
+		reference push_back( const T& value )
+		{ return emplace_back( value ); }
+
+		/**
+		 * appends value by moving it.
+		*/
+		reference push_back( T&& value )
+		{ return emplace_back( std::move( value ) ); }
+
+		/**
+		 * appends an element constructed from args.
+		 * @return the new element. It is visible to other threads (through size()) once every element
+		 *         before it is published too.
+		*/
+		template< typename... Args >
+		reference emplace_back( Args&&... args )
+		{
+			size_type index = claim( 1 );
+			slot& s = slot_at( index );
+			slot_traits::construct( m_alloc, s.get(), std::forward<Args>( args )... );
+			publish( index, s );
+			return *s.get();
+		}
+
+		/**
+		 * appends count copies of value with one claim, so the new elements are adjacent.
+		 * @return the index of the first new element.
+		*/
+		size_type grow_by( size_type count, const T& value = T() )
+		{
+			if( count == 0 ) return size();
+			size_type first = claim( count );
+			for( size_type i = first; i < first + count; i++ )
+			{
+				slot& s = slot_at( i );
+				slot_traits::construct( m_alloc, s.get(), value );
+				publish( i, s );
+			}
+			return first;
+		}
+
+		/**
+		 * destroys every element and releases the buckets. Not thread-safe.
+		*/
+		void clear( void )
+		{
+			size_type claimed = m_claimed.load( std::memory_order_acquire );
+			for( unsigned k = 0; k < max_buckets; k++ )
+			{
+				slot* b = m_buckets[k].load( std::memory_order_acquire );
+				if( b == nullptr ) break;
+				size_type base = bucket_base( k );
+				size_type n = bucket_size( k );
+				for( size_type i = 0; i < n; i++ )
+				{
+					if( base + i < claimed && b[i].ready.load( std::memory_order_relaxed ) )
+						slot_traits::destroy( m_alloc, b[i].get() );
+					b[i].ready.~atomic();
+				}
+				slot_traits::deallocate( m_alloc, b, n );
+				m_buckets[k].store( nullptr, std::memory_order_relaxed );
+			}
+			m_claimed.store( 0, std::memory_order_relaxed );
+			m_size.store( 0, std::memory_order_release );
+		}
+
+		/**
+		 * exchanges the contents with other. Not thread-safe.
+		*/
+		void swap( concurrent_vector& other ) noexcept
+		{
+			using std::swap;
+			if constexpr ( slot_traits::propagate_on_container_swap::value )
+				swap( m_alloc, other.m_alloc );
+			for( unsigned k = 0; k < max_buckets; k++ )
+				m_buckets[k].store( other.m_buckets[k].exchange( m_buckets[k].load() ) );
+			m_claimed.store( other.m_claimed.exchange( m_claimed.load() ) );
+			m_size.store( other.m_size.exchange( m_size.load() ) );
+		}
+
+		//=== [V] ELEMENT ACCESS
+
+		/**
+		 * returns the element at index, which must be below size().
+		*/
+		reference operator[]( size_type index )
+		{ return *slot_at( index ).get(); }
+
+		const_reference operator[]( size_type index )const
+		{ return *const_cast<concurrent_vector*>( this )->slot_at( index ).get(); }
+
+		/**
+		 * returns the element at index.
+		 * @throws std::out_of_range if index is not below size().
+		*/
+		reference at( size_type index )
+		{
+			if( index >= size() )
+				throw std::out_of_range( "sc::concurrent_vector::at: index out of range" );
+			return ( *this )[index];
+		}
+
+		const_reference at( size_type index )const
+		{
+			if( index >= size() )
+				throw std::out_of_range( "sc::concurrent_vector::at: index out of range" );
+			return ( *this )[index];
+		}
+
+		reference front( void ) { return ( *this )[0]; }
+		const_reference front( void )const { return ( *this )[0]; }
+
+		allocator_type get_allocator( void )const
+		{ return allocator_type( m_alloc ); }
+
+	private:
+		/**
+		 * takes the buckets and counts of other, leaving it empty. The list must hold no buckets.
+		*/
+		void steal( concurrent_vector& other ) noexcept
+		{
+			for( unsigned k = 0; k < max_buckets; k++ )
+				m_buckets[k].store( other.m_buckets[k].exchange( nullptr ) );
+			m_claimed.store( other.m_claimed.exchange( 0 ) );
+			m_size.store( other.m_size.exchange( 0 ) );
+		}
+
+		/**
+		 * index of the bucket that holds element i. Element i is at offset i + first_bucket in the
+		 * doubling sequence, so its bucket is the position of the highest set bit of that number.
+		*/
+		static unsigned bucket_of( size_type i )
+		{
+			size_type j = ( i + first_bucket ) >> first_shift;
+#if defined(__GNUC__)
+			return unsigned( sizeof(unsigned long long) * 8 - 1 - __builtin_clzll( j ) );
+#else
+			unsigned k = 0;
+			while( j >>= 1 ) k++;
+			return k;
+#endif
+		}
+
+		/// index of the first element of bucket k.
+		static size_type bucket_base( unsigned k )
+		{ return ( ( size_type( 1 ) << k ) - 1 ) << first_shift; }
+
+		/// number of slots in bucket k.
+		static size_type bucket_size( unsigned k )
+		{ return first_bucket << k; }
+
+		/**
+		 * returns bucket k, allocating it if no thread did yet. Racing threads each allocate one and the
+		 * losers of the compare-exchange free theirs, so no thread ever waits on another.
+		*/
+		slot* bucket( unsigned k )
+		{
+			slot* b = m_buckets[k].load( std::memory_order_acquire );
+			if( b != nullptr ) return b;
+			size_type n = bucket_size( k );
+			slot* fresh = slot_traits::allocate( m_alloc, n );
+			for( size_type i = 0; i < n; i++ )
+				::new( static_cast<void*>( &fresh[i].ready ) ) std::atomic<bool>( false );
+			if( m_buckets[k].compare_exchange_strong( b, fresh, std::memory_order_acq_rel, std::memory_order_acquire ) )
+				return fresh;
+			slot_traits::deallocate( m_alloc, fresh, n );
+			return b;
+		}
+
+		/**
+		 * slot of element i, allocating its bucket if needed.
+		*/
+		slot& slot_at( size_type i )
+		{
+			unsigned k = bucket_of( i );
+			slot* b = m_buckets[k].load( std::memory_order_acquire );
+			if( b == nullptr )
+				b = bucket( k );
+			return b[i - bucket_base( k )];
+		}
+
+		/**
+		 * claims count adjacent slots and returns the first index. The thread that claims the first slot
+		 * of a bucket also allocates the next bucket, so the other producers rarely race to allocate.
+		*/
+		size_type claim( size_type count )
+		{
+			size_type first = m_claimed.fetch_add( count, std::memory_order_relaxed );
+			if( first + count > max_size() || first + count < first )
+				throw std::length_error( "sc::concurrent_vector: size exceeds max_size()" );
+			unsigned k = bucket_of( first );
+			if( bucket_base( k ) == first && k + 1 < max_buckets )
+				bucket( k + 1 );
+			return first;
+		}
+
+		/**
+		 * marks element index (in slot s) constructed and advances the published prefix over it and every
+		 * ready slot after it. When index is next in line the prefix is moved with a single
+		 * compare-exchange; otherwise the flag is set for the producer of the missing slot to find. The
+		 * flag store and the loads are sequentially consistent: of two producers finishing next to each
+		 * other, at least one sees the other's work, so no ready slot is left behind.
+		*/
+		void publish( size_type index, slot& s )
+		{
+			size_type p = index;
+			if( m_size.compare_exchange_strong( p, index + 1, std::memory_order_seq_cst ) )
+			{
+				s.ready.store( true, std::memory_order_relaxed ); // só clear() lê: ninguém volta a testar index.
+				p = index + 1;
+			}
+			else
+			{
+				s.ready.store( true, std::memory_order_seq_cst );
+				p = m_size.load( std::memory_order_seq_cst );
+			}
+			for( ;; )
+			{
+				unsigned k = bucket_of( p );
+				if( k >= max_buckets ) return;
+				slot* b = m_buckets[k].load( std::memory_order_seq_cst );
+				if( b == nullptr || !b[p - bucket_base( k )].ready.load( std::memory_order_seq_cst ) )
+					return;
+				// Falha: outro produtor avançou; p recebe o valor atual e o laço continua dali.
+				if( m_size.compare_exchange_weak( p, p + 1, std::memory_order_seq_cst ) )
+					++p;
+			}
+		}
+};
+
+/**
+ * as in a == b : returns true if both lists have the same published elements.
+*/
+template< typename T, typename Alloc >
+bool operator==( const concurrent_vector<T, Alloc>& lhs, const concurrent_vector<T, Alloc>& rhs )
+{
+	std::size_t n = lhs.size();
+	if( n != rhs.size() ) return false;
+	for( std::size_t i = 0; i < n; i++ )
+		if( !( lhs[i] == rhs[i] ) ) return false;
+	return true;
+}
+
+template< typename T, typename Alloc >
+bool operator!=( const concurrent_vector<T, Alloc>& lhs, const concurrent_vector<T, Alloc>& rhs )
+{ return !( lhs == rhs ); }
+
+template< typename T, typename Alloc >
+void swap( concurrent_vector<T, Alloc>& lhs, concurrent_vector<T, Alloc>& rhs ) noexcept
+{ lhs.swap( rhs ); }
+
+}// namespace sc
+#endif
@@ -0,0 +1,53 @@
+#ifndef CONSTEXPR_H
+#define CONSTEXPR_H
+#if defined( __has_include )
+#if __has_include( <version> )
+#include <version>
+#endif
+#endif
+#include <memory> // std::construct_at, std::destroy_at
+#include <new> // placement new
+#include <utility> // std::forward
+#include <type_traits> // std::is_constant_evaluated
+
+/**
+ * SC_CONSTEXPR20 marks the members of sc::vector and sc::static_vector that can run inside constant
+ * expressions. That needs C++20 constexpr allocation (std::allocator, std::construct_at and constexpr
+ * destructors); in C++17 builds the macro expands to nothing and the containers work as before.
+*/
+#if defined( __cpp_constexpr_dynamic_alloc ) && defined( __cpp_lib_constexpr_dynamic_alloc ) && defined( __cpp_lib_is_constant_evaluated )
+#define SC_CONSTEXPR20 constexpr
+#define SC_HAS_CONSTEXPR_ALLOCATION 1
+#else
+#define SC_CONSTEXPR20
+#define SC_HAS_CONSTEXPR_ALLOCATION 0
+#endif
+
+namespace sc{
+	/**
+	 * returns true while a constant expression is evaluated. Fast paths that are not allowed there
+	 * (memcpy of objects, SIMD kernels, reinterpret_cast buffers) test it and fall back to plain loops.
+	*/
+	constexpr bool is_constant_evaluated( void ) noexcept
+	{
+#if SC_HAS_CONSTEXPR_ALLOCATION
+		return std::is_constant_evaluated();
+#else
+		return false;
+#endif
+	}
+
+	/**
+	 * constructs a T at p: std::construct_at when available (allowed in constant expressions), placement new otherwise.
+	*/
+	template < typename T, typename... Args >
+	SC_CONSTEXPR20 T* construct_at( T* p, Args&&... args )
+	{
+#if SC_HAS_CONSTEXPR_ALLOCATION
+		return std::construct_at( p, std::forward<Args>( args )... );
+#else
+		return ::new( static_cast<void*>( p ) ) T( std::forward<Args>( args )... );
+#endif
+	}
+}// namespace sc
+#endif
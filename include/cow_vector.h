@@ -0,0 +1,566 @@
+#ifndef COW_VECTOR_H
+#define COW_VECTOR_H
+
+#include "vector.h"
+#include <algorithm> // std::max
+#include <atomic>
+#include <cstddef>
+#include <initializer_list> // std::initializer_list
+#include <iterator>
+#include <memory> // std::allocator, std::allocator_traits
+#include <stdexcept> // std::out_of_range
+#include <type_traits>
+#include <utility> // std::forward, std::move
+
+namespace sc {
+
+template< typename T, typename Allocator > class cow_vector;
+
+namespace detail {
+	/**
+	 * Buffer shared by copies of a sc::cow_vector and its snapshots: a sc::vector plus an atomic count of
+	 * the handles that point to it.
+	*/
+	template< typename T, typename Allocator >
+	struct cow_buffer{
+		std::atomic<std::size_t> refs;
+		sc::vector<T, Allocator> items;
+
+		template< typename... Args >
+		explicit cow_buffer( Args&&... args ): refs{ 1 }, items( std::forward<Args>(args)... )
+		{ /* empty */ }
+	};
+
+	/**
+	 * Counted handle to a cow_buffer, shared by cow_vector and cow_vector::snapshot. Copying it is one
+	 * relaxed increment; dropping the last handle destroys the buffer. Like std::shared_ptr, distinct
+	 * handles may be copied and dropped from different threads at the same time.
+	*/
+	template< typename T, typename Allocator >
+	class cow_handle{
+		public:
+			typedef cow_buffer<T, Allocator> buffer;
+			typedef typename std::allocator_traits<Allocator>::template rebind_alloc<buffer> buffer_allocator;
+			typedef std::allocator_traits<buffer_allocator> buffer_traits;
+
+			explicit cow_handle( const Allocator& alloc ): m_alloc{ alloc }, m_buf{ nullptr }
+			{ /* empty */ }
+
+			cow_handle( const cow_handle& other ): m_alloc{ other.m_alloc }, m_buf{ other.m_buf }
+			{
+				if( m_buf != nullptr )
+					m_buf->refs.fetch_add( 1, std::memory_order_relaxed );
+			}
+
+			cow_handle( cow_handle&& other ) noexcept: m_alloc{ other.m_alloc }, m_buf{ other.m_buf }
+			{ other.m_buf = nullptr; }
+
+			cow_handle& operator=( cow_handle other ) noexcept
+			{
+				swap( other );
+				return *this;
+			}
+
+			~cow_handle()
+			{ reset(); }
+
+			/**
+			 * builds a new buffer from args (forwarded to the sc::vector constructor) and points to it.
+			*/
+			template< typename... Args >
+			void make( Args&&... args )
+			{
+				buffer* fresh = buffer_traits::allocate( m_alloc, 1 );
+				try {
+					buffer_traits::construct( m_alloc, fresh, std::forward<Args>(args)... );
+				}
+				catch( ... ) {
+					buffer_traits::deallocate( m_alloc, fresh, 1 );
+					throw;
+				}
+				reset();
+				m_buf = fresh;
+			}
+
+			/**
+			 * drops this handle's reference; the last one destroys the buffer.
+			*/
+			void reset( void ) noexcept
+			{
+				if( m_buf == nullptr )
+					return;
+				// acq_rel: as escritas de todos os donos acontecem antes da destruição.
+				if( m_buf->refs.fetch_sub( 1, std::memory_order_acq_rel ) == 1 )
+				{
+					buffer_traits::destroy( m_alloc, m_buf );
+					buffer_traits::deallocate( m_alloc, m_buf, 1 );
+				}
+				m_buf = nullptr;
+			}
+
+			void swap( cow_handle& other ) noexcept
+			{
+				using std::swap;
+				swap( m_alloc, other.m_alloc );
+				swap( m_buf, other.m_buf );
+			}
+
+			/// true if no other handle shares the buffer (or there is none).
+			bool unique( void )const
+			{ return m_buf == nullptr || m_buf->refs.load( std::memory_order_acquire ) == 1; }
+
+			std::size_t use_count( void )const
+			{ return ( m_buf == nullptr ) ? 0 : m_buf->refs.load( std::memory_order_relaxed ); }
+
+			buffer* get( void )const { return m_buf; }
+			Allocator allocator( void )const { return Allocator( m_alloc ); }
+
+		private:
+			buffer_allocator m_alloc;
+			buffer* m_buf; //!< Shared buffer, nullptr while the list never held anything.
+	};
+}// namespace detail
+
+/**
+ * Copy-on-write list for read-mostly data handed to many readers (configuration, indexes). Copies share
+ * one buffer through an atomic reference count, so copying, assigning and get_snapshot() are O(1) whatever
+ * the size. The first mutation through a handle whose buffer is shared copies the size() elements into
+ * a private buffer; while the buffer is not shared, mutations work in place like sc::vector.
+ *
+ * get_snapshot() returns a read-only view that keeps the current contents alive: the writer may keep
+ * modifying its cow_vector, and each snapshot still sees the elements as they were when it was taken.
+ *
+ * Thread safety follows std::shared_ptr: different cow_vector and snapshot objects may be used from
+ * different threads even when they share a buffer; one object used by several threads, with at least
+ * one of them modifying it, needs the caller's synchronization (publish snapshots through a mutex or an
+ * atomic handle).
+ *
+ * Reads never copy, so only const access is offered directly. edit() and mutable_data() give write
+ * access after making the buffer private; the reference they return is valid until the list is copied,
+ * snapshotted or modified again.
+*/
+template< typename T, typename Allocator = std::allocator<T> >
+class cow_vector{
+	public:
+		typedef T value_type; //!< Type of the elements stored in the list.
+		typedef Allocator allocator_type;
+		typedef std::size_t size_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef const T& const_reference;
+		typedef const T* const_pointer;
+		typedef sc::const_iterator<T> const_iterator; //!< Contiguous read-only iterator.
+		typedef const_iterator iterator; //!< Iteration never detaches, so every iterator is read-only.
+		typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+	private:
+		typedef detail::cow_handle<T, Allocator> handle;
+		typedef sc::vector<T, Allocator> items_type;
+
+		handle m_handle; //!< Buffer shared with copies and snapshots.
+
+		/**
+		 * read access to the elements: nullptr while no buffer exists.
+		*/
+		const items_type* items( void )const
+		{ return ( m_handle.get() == nullptr ) ? nullptr : &m_handle.get()->items; }
+
+	public:
+		/**
+		 * Immutable view of a cow_vector at the moment get_snapshot() was called. Copying it is O(1); the
+		 * elements it refers to never change, whatever happens to the list it came from.
+		*/
+		class snapshot{
+			public:
+				typedef T value_type;
+				typedef std::size_t size_type;
+				typedef sc::const_iterator<T> const_iterator;
+				typedef const_iterator iterator;
+
+				snapshot( void ): m_handle( Allocator() )
+				{ /* empty */ }
+
+				size_t size( void )const { return ( m_handle.get() == nullptr ) ? 0 : m_handle.get()->items.size(); }
+				bool empty( void )const { return size() == 0; }
+				const T* data( void )const { return ( m_handle.get() == nullptr ) ? nullptr : m_handle.get()->items.data(); }
+				const_iterator begin( void )const { return const_iterator( data() ); }
+				const_iterator end( void )const { return const_iterator( data() + size() ); }
+				const T& operator[]( size_t pos )const { return data()[pos]; }
+				const T& front( void )const { return data()[0]; }
+				const T& back( void )const { return data()[size()-1]; }
+
+				/**
+				 *returns the object at the index pos, with bounds-checking.
+				 * @throws std::out_of_range if pos >= size().
+				*/
+				const T& at( size_t pos )const
+				{
+					if( pos >= size() )
+						throw std::out_of_range( "[cow_vector::snapshot::at()] out of range error" );
+					return data()[pos];
+				}
+
+				/// number of lists and snapshots sharing this buffer.
+				size_t use_count( void )const { return m_handle.use_count(); }
+
+			private:
+				friend class cow_vector;
+				explicit snapshot( const handle& h ): m_handle( h )
+				{ /* empty */ }
+
+				handle m_handle;
+		};
+
+		//=== [I] SPECIAL MEMBERS
+
+		/**
+		 * Constructs an empty list. Nothing is allocated.
+		*/
+		explicit cow_vector( const Allocator& alloc = Allocator() ): m_handle( alloc )
+		{ /* empty */ }
+
+		/**
+		 * Constructs the list with the contents of the range [first, last) .
+		*/
+		template< typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category >
+		cow_vector( InputIt first, InputIt last, const Allocator& alloc = Allocator() ): m_handle( alloc )
+		{ m_handle.make( first, last, alloc ); }
+
+		/**
+		 * Constructs the list with the contents of the initializer list init .
+		*/
+		cow_vector( std::initializer_list<T> ilist, const Allocator& alloc = Allocator() ): m_handle( alloc )
+		{ m_handle.make( ilist, alloc ); }
+
+		/**
+		 * Takes over the storage of a sc::vector; no element is copied.
+		*/
+		explicit cow_vector( items_type&& items ): m_handle( items.get_allocator() )
+		{ m_handle.make( std::move( items ) ); }
+
+		/**
+		 *Copy constructor. O(1): the buffer of other is shared until one of the two lists is modified.
+		*/
+		cow_vector( const cow_vector& other ) = default;
+
+		/**
+		 *Move constructor. other is left empty.
+		*/
+		cow_vector( cow_vector&& other ) noexcept = default;
+
+		/**
+		 *Copy assignment operator. O(1): shares the buffer of other.
+		*/
+		cow_vector& operator=( const cow_vector& other ) = default;
+
+		/**
+		 *Move assignment operator. other is left empty.
+		*/
+		cow_vector& operator=( cow_vector&& other ) noexcept = default;
+
+		/**
+		 *Replaces the contents with those identiﬁed by initializer list ilist .
+		*/
+		cow_vector& operator=( std::initializer_list<T> ilist )
+		{
+			assign( ilist.begin(), ilist.end() );
+			return *this;
+		}
+
+		/**
+		 * returns the allocator associated with the container.
+		*/
+		allocator_type get_allocator( void )const
+		{ return m_handle.allocator(); }
+
+		/**
+		 * returns a read-only view of the current contents, in O(1). Later changes to this list do not
+		 * affect it: the first one copies the elements into a private buffer.
+		*/
+		snapshot get_snapshot( void )const
+		{ return snapshot( m_handle ); }
+
+		/**
+		 * number of lists and snapshots sharing the buffer of this list (0 if it has none).
+		*/
+		size_t use_count( void )const
+		{ return m_handle.use_count(); }
+
+		/**
+		 * returns true if a modification would not copy the elements.
+		*/
+		bool unique( void )const
+		{ return m_handle.unique(); }
+
+		//=== [II] ITERATORS
+
+		/**
+		 * returns a constant iterator pointing to the ﬁrst item in the list.
+		*/
+		const_iterator begin( void )const
+		{ return const_iterator( data() ); }
+
+		/**
+		 * returns a constant iterator pointing to the end mark in the list.
+		*/
+		const_iterator end( void )const
+		{ return const_iterator( data() + size() ); }
+
+		/**
+		 * returns a constant iterator pointing to the ﬁrst item in the list.
+		*/
+		const_iterator cbegin( void )const
+		{ return begin(); }
+
+		/**
+		 * returns a constant iterator pointing to the end mark in the list.
+		*/
+		const_iterator cend( void )const
+		{ return end(); }
+
+		/**
+		 * returns a constant reverse iterator pointing to the last item in the list.
+		*/
+		const_reverse_iterator rbegin( void )const
+		{ return const_reverse_iterator( end() ); }
+
+		/**
+		 * returns a constant reverse iterator pointing to the position just before the first item in the list.
+		*/
+		const_reverse_iterator rend( void )const
+		{ return const_reverse_iterator( begin() ); }
+
+		//=== [III] Capacity
+
+		/**
+		 *return the number of elements in the container.
+		*/
+		size_t size( void )const
+		{ return ( items() == nullptr ) ? 0 : items()->size(); }
+
+		/**
+		 * return the capacity of the (possibly shared) buffer.
+		*/
+		size_t capacity( void )const
+		{ return ( items() == nullptr ) ? 0 : items()->capacity(); }
+
+		/**
+		 * returns true if the container contains no elements, and false otherwise.
+		*/
+		bool empty( void )const
+		{ return size() == 0; }
+
+		/**
+		 * makes sure the private buffer holds at least new_cap elements.
+		*/
+		void reserve( size_t new_cap )
+		{ detach( new_cap ).reserve( new_cap ); }
+
+		//=== [IV] Modifiers
+
+		/**
+		 *remove all elements. A shared buffer is simply released (the other owners keep it).
+		*/
+		void clear( void )
+		{
+			if( m_handle.unique() )
+			{
+				if( items() != nullptr )
+					m_handle.get()->items.clear();
+			}
+			else
+				m_handle.reset();
+		}
+
+		/**
+		 * adds value to the end of the list.
+		*/
+		void push_back( const T& value )
+		{ emplace_back( value ); }
+
+		/**
+		 * adds value to the end of the list, moving it into place.
+		*/
+		void push_back( T&& value )
+		{ emplace_back( std::move( value ) ); }
+
+		/**
+		 * Constructs one element at the end of the list. A shared buffer is copied first, with room for it.
+		*/
+		template< class... Args >
+		void emplace_back( Args&&... args )
+		{
+			if( m_handle.unique() && items() != nullptr )
+			{
+				m_handle.get()->items.emplace_back( std::forward<Args>(args)... );
+				return;
+			}
+			// args pode referenciar um elemento do buffer compartilhado: construir antes de trocar.
+			T value( std::forward<Args>(args)... );
+			detach( size() + 1 ).emplace_back( std::move( value ) );
+		}
+
+		/**
+		 * removes the object at the end of the list.
+		*/
+		void pop_back( void )
+		{
+			if( empty() ) return;
+			detach( size() ).pop_back();
+		}
+
+		/**
+		 * adds value into the list before the position given by pos .
+		 * @return index of the inserted element (iterators into a shared buffer do not survive the copy).
+		*/
+		size_t insert( const_iterator pos, const T& value )
+		{
+			size_t idx = pos - cbegin();
+			T copy( value );
+			items_type& own = detach( size() + 1 );
+			own.insert( own.cbegin() + idx, std::move( copy ) );
+			return idx;
+		}
+
+		/**
+		 * removes the object at position pos .
+		 * @return index of the element that followed pos.
+		*/
+		size_t erase( const_iterator pos )
+		{ return erase( pos, pos + 1 ); }
+
+		/**
+		 * removes elements in the range [first; last) .
+		 * @return index of the element that followed the range.
+		*/
+		size_t erase( const_iterator first, const_iterator last )
+		{
+			size_t idx = first - cbegin();
+			size_t count = last - first;
+			if( count == 0 )
+				return idx;
+			items_type& own = detach( size() );
+			own.erase( own.cbegin() + idx, own.cbegin() + idx + count );
+			return idx;
+		}
+
+		/**
+		 * replaces the contents of the list with copies of the elements in the range [first; last) .
+		 * A shared buffer is left to its other owners and a new one is built.
+		*/
+		template < typename InItr, typename = typename std::iterator_traits<InItr>::iterator_category >
+		void assign( InItr first, InItr last )
+		{
+			if( m_handle.unique() && items() != nullptr )
+				m_handle.get()->items.assign( first, last );
+			else
+				m_handle.make( first, last, get_allocator() );
+		}
+
+		/**
+		 * replaces the contents of the list with the elements from the initializer list ilist .
+		*/
+		void assign( std::initializer_list<T> ilist )
+		{ assign( ilist.begin(), ilist.end() ); }
+
+		/**
+		 * returns a modifiable reference to the element at pos, making the buffer private first.
+		*/
+		T& edit( size_t pos )
+		{ return detach( size() )[pos]; }
+
+		/**
+		 * returns a modifiable pointer to the elements, making the buffer private first.
+		*/
+		T* mutable_data( void )
+		{ return ( size() == 0 ) ? nullptr : detach( size() ).data(); }
+
+		/**
+		 * exchanges the contents of this list with those of other in O(1).
+		*/
+		void swap( cow_vector& other ) noexcept
+		{ m_handle.swap( other.m_handle ); }
+
+		//=== [V] Element access
+
+		/**
+		 * returns a pointer to the (possibly shared) elements. [data(), data()+size()) is a valid range.
+		*/
+		const T* data( void )const
+		{ return ( items() == nullptr ) ? nullptr : items()->data(); }
+
+		/**
+		 *returns the object at the index pos in the array, with no bounds-checking.
+		*/
+		const T& operator[]( size_t pos )const
+		{ return data()[pos]; }
+
+		/**
+		 *returns the object at the index pos in the array, with bounds-checking.
+		 * @throws std::out_of_range if pos >= size().
+		*/
+		const T& at( size_t pos )const
+		{
+			if( pos >= size() )
+				throw std::out_of_range( "[cow_vector::at()] out of range error" );
+			return data()[pos];
+		}
+
+		/**
+		 *returns the object at the beginning of the list.
+		*/
+		const T& front( void )const
+		{ return data()[0]; }
+
+		/**
+		 * returns the object at the end of the list.
+		*/
+		const T& back( void )const
+		{ return data()[size()-1]; }
+
+		//=== [VII] Friend functions.
+
+		/**
+		 * exchanges the contents of A and B in O(1).
+		*/
+		friend void swap( cow_vector& A, cow_vector& B ) noexcept
+		{ A.swap( B ); }
+
+	private:
+		/**
+		 * returns the elements for writing. A buffer shared with another list or snapshot is copied first
+		 * into a private one with room for at least min_cap elements; the other owners keep the old one.
+		*/
+		items_type& detach( size_t min_cap )
+		{
+			if( m_handle.unique() && items() != nullptr )
+				return m_handle.get()->items;
+			items_type own( std::max( min_cap, size() ), get_allocator() );
+			if( items() != nullptr )
+				own.assign( items()->data(), items()->data() + items()->size() );
+			m_handle.make( std::move( own ) );
+			return m_handle.get()->items;
+		}
+};
+
+/**
+ * Checks if the contents of lhs and rhs are equal (O(1) when they share a buffer).
+*/
+template< typename T, typename Alloc >
+bool operator==( const sc::cow_vector<T, Alloc>& lhs, const sc::cow_vector<T, Alloc>& rhs )
+{
+	if( lhs.size() != rhs.size() )
+		return false;
+	if( lhs.data() == rhs.data() )
+		return true;
+	return sc::simd::equal( lhs.data(), rhs.data(), lhs.size() );
+}
+
+/**
+ * Similar to the previous operator, but the opposite result.
+*/
+template< typename T, typename Alloc >
+bool operator!=( const sc::cow_vector<T, Alloc>& lhs, const sc::cow_vector<T, Alloc>& rhs )
+{ return !( lhs == rhs ); }
+}//namespace
+
+#endif
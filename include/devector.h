@@ -0,0 +1,769 @@
+#ifndef DEVECTOR_H
+#define DEVECTOR_H
+
+#include "iterator.h"
+#include "relocate.h"
+#include "simd.h"
+#include <iterator>
+#include <algorithm> //std::move, std::move_backward, std::max
+#include <initializer_list> // std::initializer_list
+#include <stdexcept>//std::out_of_range
+#include <memory> // std::allocator, std::allocator_traits
+#include <ostream>
+#include <type_traits>
+#include <cstring> // std::memcpy, std::memmove
+
+namespace sc {
+
+/**
+ * Double-ended contiguous container. The elements occupy a window [m_first, m_last) inside a raw block
+ * that keeps free space at both ends, so push_front/pop_front/push_back/pop_back are all amortized O(1)
+ * while data() still exposes one contiguous array.
+ *
+ * When one end runs out of room the window is recentered inside the block if at least half of the block
+ * is free; otherwise a block twice as large is allocated and all the new room is given to the end that
+ * ran out.
+*/
+template< typename T, typename Allocator = std::allocator<T> >
+class devector{
+	public:
+		typedef T value_type; //!< Type of the elements stored in the list.
+		typedef Allocator allocator_type; //!< Allocator used to obtain raw storage.
+		typedef std::size_t size_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef T& reference;
+		typedef const T& const_reference;
+		typedef T* pointer;
+		typedef const T* const_pointer;
+		typedef sc::iterator<T> iterator; //!< Contiguous iterator.
+		typedef sc::const_iterator<T> const_iterator; //!< Contiguous read-only iterator.
+		typedef std::reverse_iterator<iterator> reverse_iterator;
+		typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+	private:
+		typedef std::allocator_traits<Allocator> alloc_traits;
+		static_assert( std::is_same< typename alloc_traits::pointer, T* >::value,
+		               "sc::devector requires an allocator whose pointer type is T*" );
+
+		/// Elements can be moved around as raw bytes (see sc::is_trivially_relocatable).
+		static constexpr bool trivially_relocatable = sc::is_trivially_relocatable<T>::value;
+		/// Elements can be shifted inside the block without risking a half-moved state.
+		static constexpr bool recenter_in_place = trivially_relocatable || std::is_nothrow_move_constructible<T>::value;
+
+		allocator_type m_alloc; //!< Allocator that owns the storage area.
+		T * m_storage; //!< Raw block (only [m_first, m_last) is constructed).
+		T * m_first; //!< First element of the list.
+		T * m_last; //!< Position just after the last element of the list.
+		size_t m_capacity; //!< Size of the block, in elements.
+
+	public:
+		//=== [I] SPECIAL MEMBERS
+
+		/**
+		 * Constructs an empty list whose block has room for count elements, with the window in the middle.
+		 *  @param count  the number of elements to reserve room for.
+		*/
+		devector( size_t count=0, const Allocator& alloc = Allocator() ):
+			m_alloc{ alloc },
+			m_storage{ nullptr },
+			m_first{ nullptr },
+			m_last{ nullptr },
+			m_capacity{ 0 }
+		{
+			if( count == 0 ) return;
+			m_storage = alloc_traits::allocate( m_alloc, count );
+			m_capacity = count;
+			m_first = m_last = m_storage + count / 2;
+		}
+
+		/**
+		 * Constructs the list with the contents of the range [first, last) . Forward ranges get a block of
+		 * exactly their size; single-pass ranges are read once, growing the list as push_back does.
+		*/
+		template< typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category >
+		devector( InputIt first, InputIt last, const Allocator& alloc = Allocator() ):
+			devector( 0, alloc )
+		{ init_copy( first, last ); }
+
+		/**
+		 *Copy constructor. The copy gets a block of exactly other.size() elements.
+		*/
+		devector( const devector& other ):
+			devector( 0, alloc_traits::select_on_container_copy_construction( other.m_alloc ) )
+		{ init_copy( other.m_first, other.m_last ); }
+
+		/**
+		 *Move constructor. Steals the block of other, which is left empty.
+		*/
+		devector( devector&& other ) noexcept:
+			m_alloc{ std::move( other.m_alloc ) },
+			m_storage{ other.m_storage },
+			m_first{ other.m_first },
+			m_last{ other.m_last },
+			m_capacity{ other.m_capacity }
+		{
+			other.m_storage = other.m_first = other.m_last = nullptr;
+			other.m_capacity = 0;
+		}
+
+		/**
+		 * Constructs the list with the contents of the initializer list init .
+		*/
+		devector( std::initializer_list<T> ilist, const Allocator& alloc = Allocator() ):
+			devector( ilist.begin(), ilist.end(), alloc )
+		{ /*empty*/ }
+
+		/**
+		 * Destructs the list. The destructors of the elements are called and the used storage is deallocated.
+		*/
+		~devector()
+		{
+			destroy( m_first, m_last );
+			deallocate();
+		}
+
+		/**
+		 *Copy assignment operator. Replaces the contents with a copy of the contents of other. The current
+		 *block is reused when it is large enough.
+		*/
+		devector& operator=( const devector& other )
+		{
+			if( this == &other ) return *this;
+
+			clear();
+			if constexpr ( alloc_traits::propagate_on_container_copy_assignment::value )
+			{
+				// O bloco atual foi obtido do alocador antigo: devolvê-lo antes de trocar.
+				if( !( m_alloc == other.m_alloc ) )
+					deallocate();
+				m_alloc = other.m_alloc;
+			}
+			fill_copy( other.m_first, other.m_last, other.size() );
+			return *this;
+		}
+
+		/**
+		 *Move assignment operator. Replaces the contents with those of other, which is left empty. The block
+		 *of other is taken over when the allocators allow it, otherwise the elements are moved one by one.
+		*/
+		devector& operator=( devector&& other ) noexcept( alloc_traits::propagate_on_container_move_assignment::value
+		                                                  || alloc_traits::is_always_equal::value )
+		{
+			if( this == &other ) return *this;
+
+			if( alloc_traits::propagate_on_container_move_assignment::value || m_alloc == other.m_alloc )
+			{
+				destroy( m_first, m_last );
+				deallocate();
+				if constexpr ( alloc_traits::propagate_on_container_move_assignment::value )
+					m_alloc = std::move( other.m_alloc );
+				m_storage = other.m_storage;
+				m_first = other.m_first;
+				m_last = other.m_last;
+				m_capacity = other.m_capacity;
+				other.m_storage = other.m_first = other.m_last = nullptr;
+				other.m_capacity = 0;
+			}
+			else
+			{
+				// Alocadores diferentes: mover elemento a elemento para memória própria.
+				clear();
+				fill_copy( std::make_move_iterator( other.m_first ), std::make_move_iterator( other.m_last ), other.size() );
+				other.clear();
+			}
+			return *this;
+		}
+
+		/**
+		 *Replaces the contents with those identiﬁed by initializer list ilist .
+		*/
+		devector& operator=( std::initializer_list<T> ilist )
+		{
+			clear();
+			fill_copy( ilist.begin(), ilist.end(), ilist.size() );
+			return *this;
+		}
+
+		/**
+		 * returns the allocator associated with the container.
+		*/
+		allocator_type get_allocator( void ) const
+		{ return m_alloc; }
+
+		//=== [II] ITERATORS
+		/**
+		 *returns an iterator pointing to the ﬁrst item in the list.
+		*/
+		iterator begin( void )
+		{ return iterator( m_first ); }
+
+		/**
+		 * returns an iterator pointing to the end mark in the list.
+		*/
+		iterator end( void )
+		{ return iterator( m_last ); }
+
+		/**
+		 *returns a constant iterator pointing to the ﬁrst item in the list.
+		*/
+		const_iterator begin( void )const
+		{ return const_iterator( m_first ); }
+
+		/**
+		 * returns a constant iterator pointing to the end mark in the list.
+		*/
+		const_iterator end( void )const
+		{ return const_iterator( m_last ); }
+
+		/**
+		 * returns a constant iterator pointing to the ﬁrst item in the list.
+		*/
+		const_iterator cbegin( void )const
+		{ return const_iterator( m_first ); }
+
+		/**
+		 * returns a constant iterator pointing to the end mark in the list.
+		*/
+		const_iterator cend( void )const
+		{ return const_iterator( m_last ); }
+
+		/**
+		 * returns a reverse iterator pointing to the last item in the list.
+		*/
+		reverse_iterator rbegin( void )
+		{ return reverse_iterator( end() ); }
+
+		/**
+		 * returns a reverse iterator pointing to the position just before the first item in the list.
+		*/
+		reverse_iterator rend( void )
+		{ return reverse_iterator( begin() ); }
+
+		/**
+		 * returns a constant reverse iterator pointing to the last item in the list.
+		*/
+		const_reverse_iterator crbegin( void )const
+		{ return const_reverse_iterator( cend() ); }
+
+		/**
+		 * returns a constant reverse iterator pointing to the position just before the first item in the list.
+		*/
+		const_reverse_iterator crend( void )const
+		{ return const_reverse_iterator( cbegin() ); }
+
+		//=== [III] Capacity
+
+		/**
+		 *return the number of elements in the container.
+		*/
+		size_t size( void )const
+		{ return static_cast<size_t>( m_last - m_first ); }
+
+		/**
+		 * return the size of the block, counting the free room at both ends.
+		*/
+		size_t capacity( void )const
+		{ return m_capacity; }
+
+		/**
+		 * return how many elements can be pushed at the front without moving the list.
+		*/
+		size_t front_free_capacity( void )const
+		{ return static_cast<size_t>( m_first - m_storage ); }
+
+		/**
+		 * return how many elements can be pushed at the back without moving the list.
+		*/
+		size_t back_free_capacity( void )const
+		{ return static_cast<size_t>( m_storage + m_capacity - m_last ); }
+
+		/**
+		 * returns true if the container contains no elements, and false otherwise.
+		*/
+		bool empty( void )const
+		{ return m_first == m_last; }
+
+		//=== [IV] Modifiers
+		/**
+		 *remove all elements from the container, calling their destructors. The window moves back to the middle of the block.
+		*/
+		void clear( void )
+		{
+			destroy( m_first, m_last );
+			m_first = m_last = m_storage + m_capacity / 2;
+		}
+
+		/**
+		 * adds value to the front of the list in amortized constant time.
+		*/
+		void push_front( const T& value )
+		{ emplace_front( value ); }
+
+		/**
+		 * adds value to the front of the list in amortized constant time, moving it into place.
+		*/
+		void push_front( T&& value )
+		{ emplace_front( std::move( value ) ); }
+
+		/**
+		 * adds value to the end of the list in amortized constant time.
+		*/
+		void push_back( const T& value )
+		{ emplace_back( value ); }
+
+		/**
+		 * adds value to the end of the list in amortized constant time, moving it into place.
+		*/
+		void push_back( T&& value )
+		{ emplace_back( std::move( value ) ); }
+
+		/**
+		 * Constructs one element in place at the front of the list.
+		*/
+		template< class... Args >
+		void emplace_front( Args&&... args )
+		{
+			if( m_first == m_storage )
+			{
+				// args pode referenciar um elemento da própria lista: construir antes de mover a janela.
+				T temp( std::forward<Args>(args)... );
+				make_room_front( 1 );
+				alloc_traits::construct( m_alloc, m_first - 1, std::move( temp ) );
+			}
+			else
+				alloc_traits::construct( m_alloc, m_first - 1, std::forward<Args>(args)... );
+			--m_first;
+		}
+
+		/**
+		 * Constructs one element in place at the end of the list.
+		*/
+		template< class... Args >
+		void emplace_back( Args&&... args )
+		{
+			if( m_last == m_storage + m_capacity )
+			{
+				T temp( std::forward<Args>(args)... );
+				make_room_back( 1 );
+				alloc_traits::construct( m_alloc, m_last, std::move( temp ) );
+			}
+			else
+				alloc_traits::construct( m_alloc, m_last, std::forward<Args>(args)... );
+			++m_last;
+		}
+
+		/**
+		 * removes the object at the end of the list.
+		*/
+		void pop_back( void )
+		{
+			if( empty() ) return;
+			--m_last;
+			alloc_traits::destroy( m_alloc, m_last );
+		}
+
+		/**
+		 * removes the object at the front of the list in constant time.
+		*/
+		void pop_front( void )
+		{
+			if( empty() ) return;
+			alloc_traits::destroy( m_alloc, m_first );
+			++m_first;
+		}
+
+		/**
+		 *increase the storage capacity to a value that’s is greater or equal to new_cap . The new room goes to the back.
+		*/
+		void reserve( size_t new_cap )
+		{
+			if( new_cap <= m_capacity ) return;
+			reallocate( new_cap, front_free_capacity() );
+		}
+
+		/**
+		 * adds value into the list before the position given by the iterator pos .
+		*/
+		iterator insert( const_iterator pos, const T& value )
+		{ return emplace( pos, value ); }
+
+		/**
+		 * moves value into the list before the position given by the iterator pos .
+		*/
+		iterator insert( const_iterator pos, T&& value )
+		{ return emplace( pos, std::move( value ) ); }
+
+		/**
+		 * Constructs one element before pos. Only the elements on the shorter side of pos are shifted.
+		 * The method returns an iterator to the position of the inserted item.
+		*/
+		template< class... Args >
+		iterator emplace( const_iterator pos, Args&&... args )
+		{
+			size_t idx = pos - cbegin();
+			if( idx == 0 )
+			{
+				emplace_front( std::forward<Args>(args)... );
+				return begin();
+			}
+			if( idx == size() )
+			{
+				emplace_back( std::forward<Args>(args)... );
+				return end() - 1;
+			}
+
+			T temp( std::forward<Args>(args)... );
+			if( idx < size() - idx )
+			{
+				// Deslocar o prefixo uma posição para a esquerda.
+				make_room_front( 1 );
+				T* p = m_first + idx;
+				if constexpr ( trivially_relocatable )
+					std::memmove( static_cast<void*>( m_first - 1 ), static_cast<const void*>( m_first ), idx * sizeof(T) );
+				else
+				{
+					alloc_traits::construct( m_alloc, m_first - 1, std::move( *m_first ) );
+					std::move( m_first + 1, p, m_first );
+					alloc_traits::destroy( m_alloc, p - 1 );
+				}
+				--m_first;
+				alloc_traits::construct( m_alloc, p - 1, std::move( temp ) );
+			}
+			else
+			{
+				// Deslocar o sufixo uma posição para a direita.
+				make_room_back( 1 );
+				T* p = m_first + idx;
+				if constexpr ( trivially_relocatable )
+					std::memmove( static_cast<void*>( p + 1 ), static_cast<const void*>( p ), ( m_last - p ) * sizeof(T) );
+				else
+				{
+					alloc_traits::construct( m_alloc, m_last, std::move( *( m_last - 1 ) ) );
+					std::move_backward( p, m_last - 1, m_last );
+					alloc_traits::destroy( m_alloc, p );
+				}
+				++m_last;
+				alloc_traits::construct( m_alloc, p, std::move( temp ) );
+			}
+			return iterator( m_first + idx );
+		}
+
+		/**
+		 *removes the object at position pos . The method returns an iterator to the element that follows pos before the call.
+		*/
+		iterator erase( const_iterator pos )
+		{ return erase( pos, pos + 1 ); }
+
+		/**
+		 * removes elements in the range [first; last) . Only the elements on the shorter side are shifted.
+		*/
+		iterator erase( const_iterator first, const_iterator last )
+		{
+			size_t idx = first - cbegin();
+			size_t count = last - first;
+			if( count == 0 )
+				return iterator( m_first + idx );
+			T* p = m_first + idx;
+			size_t after = size() - idx - count;
+			if( idx < after )
+			{
+				// Fechar o buraco trazendo o prefixo para a direita.
+				if constexpr ( trivially_relocatable )
+				{
+					destroy( p, p + count );
+					std::memmove( static_cast<void*>( m_first + count ), static_cast<const void*>( m_first ), idx * sizeof(T) );
+				}
+				else
+				{
+					std::move_backward( m_first, p, p + count );
+					destroy( m_first, m_first + count );
+				}
+				m_first += count;
+			}
+			else
+			{
+				if constexpr ( trivially_relocatable )
+				{
+					destroy( p, p + count );
+					std::memmove( static_cast<void*>( p ), static_cast<const void*>( p + count ), after * sizeof(T) );
+				}
+				else
+				{
+					T* new_last = std::move( p + count, m_last, p );
+					destroy( new_last, m_last );
+				}
+				m_last -= count;
+			}
+			return iterator( m_first + idx );
+		}
+
+		/**
+		 * exchanges the contents of this list with those of other in constant time.
+		*/
+		void swap( devector& other ) noexcept
+		{
+			using std::swap;
+			if constexpr ( alloc_traits::propagate_on_container_swap::value )
+				swap( m_alloc, other.m_alloc );
+			swap( m_storage, other.m_storage );
+			swap( m_first, other.m_first );
+			swap( m_last, other.m_last );
+			swap( m_capacity, other.m_capacity );
+		}
+
+		// [V] Element access
+
+		/**
+		 * returns a pointer to the first element. [data(), data()+size()) is a valid range.
+		*/
+		T* data( void )
+		{ return m_first; }
+
+		/**
+		 * returns a pointer to the first element. [data(), data()+size()) is a valid range.
+		*/
+		const T* data( void ) const
+		{ return m_first; }
+
+		/**
+		 * returns the object at the end of the list.
+		*/
+		const T& back( void ) const
+		{ return *( m_last - 1 ); }
+
+		/**
+		 * returns the object at the end of the list.
+		*/
+		T& back( void )
+		{ return *( m_last - 1 ); }
+
+		/**
+		 *returns the object at the beginning of the list.
+		*/
+		const T& front( void ) const
+		{ return *m_first; }
+
+		/**
+		 *returns the object at the beginning of the list.
+		*/
+		T& front( void )
+		{ return *m_first; }
+
+		/**
+		 *returns the object at the index pos in the array, with no bounds-checking.
+		*/
+		T& operator[]( size_t pos )const{ return m_first[pos]; }
+
+		/**
+		 *returns the object at the index pos in the array, with bounds-checking.
+		*/
+		T at( size_t pos )const
+		{
+			if ( pos >= size() )
+				throw std::out_of_range( "[devector::at() const] out of range error" );
+			return m_first[ pos ];
+		}
+
+		/**
+		 *returns the object at the index pos in the array, with bounds-checking.
+		*/
+		T& at( size_t pos )
+		{
+			if ( pos >= size() )
+				throw std::out_of_range( "[devector::at()] out of range error" );
+			return m_first[ pos ];
+		}
+
+		//=== [VII] Friend functions.
+
+		/**
+		 * extraction operator overload.
+		*/
+		friend std::ostream& operator<<( std::ostream& os, const devector& v )
+		{
+			os << "[ ";
+			std::copy( v.m_first, v.m_last, std::ostream_iterator<T>( os, " " ));
+			os << "]";
+			return os;
+		}
+
+		/**
+		 * exchanges the contents of A and B in constant time.
+		*/
+		friend void swap( devector& A, devector& B ) noexcept
+		{ A.swap( B ); }
+
+	private:
+		//=== [VIII] Raw storage helpers.
+
+		/**
+		 * returns the block to the allocator, leaving the list without storage. The elements must already
+		 * be destroyed.
+		*/
+		void deallocate( void )
+		{
+			if( m_storage != nullptr )
+				alloc_traits::deallocate( m_alloc, m_storage, m_capacity );
+			m_storage = m_first = m_last = nullptr;
+			m_capacity = 0;
+		}
+
+		void destroy( T* first, T* last )
+		{
+			for( ; first != last; ++first )
+				alloc_traits::destroy( m_alloc, first );
+		}
+
+		/**
+		 * fills an empty list with copies of [first, last). Called from the constructors only: they delegate
+		 * to devector( 0, alloc ), so on exception the destructor releases what was built.
+		*/
+		template< typename InputIt >
+		void init_copy( InputIt first, InputIt last )
+		{
+			typedef typename std::iterator_traits<InputIt>::iterator_category category;
+			if constexpr ( std::is_base_of< std::forward_iterator_tag, category >::value )
+				fill_copy( first, last, static_cast<size_t>( std::distance( first, last ) ) );
+			else
+			{
+				// Uma só passada: std::distance consumiria a entrada.
+				for( ; first != last; ++first )
+					emplace_back( *first );
+			}
+		}
+
+		/**
+		 * fills an empty list with the count elements of [first, last). The block is reused, with the window
+		 * centered in it, if it has room for count elements; otherwise it is replaced by one of exactly count.
+		 * On exception the elements constructed so far stay in the list.
+		*/
+		template< typename ForwardIt >
+		void fill_copy( ForwardIt first, ForwardIt last, size_t count )
+		{
+			if( count > m_capacity )
+			{
+				deallocate();
+				m_storage = alloc_traits::allocate( m_alloc, count );
+				m_capacity = count;
+			}
+			m_first = m_last = m_storage + ( m_capacity - count ) / 2;
+			for( ; first != last; ++first, ++m_last )
+				alloc_traits::construct( m_alloc, m_last, *first );
+		}
+
+		/**
+		 * guarantees at least n free slots before the first element.
+		*/
+		void make_room_front( size_t n )
+		{
+			if( front_free_capacity() >= n ) return;
+			size_t free = m_capacity - size();
+			if( recenter_in_place && free >= n && free - n >= size() )
+				shift_to( m_storage + n + ( free - n ) / 2 );
+			else
+			{
+				// Toda a memória nova vai para a frente, a folga de trás é mantida.
+				size_t new_cap = std::max( 2 * m_capacity, size() + n );
+				reallocate( new_cap, new_cap - size() - back_free_capacity() );
+			}
+		}
+
+		/**
+		 * guarantees at least n free slots after the last element.
+		*/
+		void make_room_back( size_t n )
+		{
+			if( back_free_capacity() >= n ) return;
+			size_t free = m_capacity - size();
+			if( recenter_in_place && free >= n && free - n >= size() )
+				shift_to( m_storage + ( free - n ) / 2 );
+			else
+			{
+				// Toda a memória nova vai para trás, a folga da frente é mantida.
+				size_t new_cap = std::max( 2 * m_capacity, size() + n );
+				reallocate( new_cap, front_free_capacity() );
+			}
+		}
+
+		/**
+		 * moves the window inside the current block so that the first element lands on dest.
+		 * Only used when moving cannot throw.
+		*/
+		void shift_to( T* dest )
+		{
+			size_t count = size();
+			if( dest == m_first ) return;
+			if constexpr ( trivially_relocatable )
+				std::memmove( static_cast<void*>( dest ), static_cast<const void*>( m_first ), count * sizeof(T) );
+			else if( dest < m_first )
+			{
+				for( size_t i = 0; i < count; i++ )
+				{
+					alloc_traits::construct( m_alloc, dest + i, std::move( m_first[i] ) );
+					alloc_traits::destroy( m_alloc, m_first + i );
+				}
+			}
+			else
+			{
+				for( size_t i = count; i-- > 0; )
+				{
+					alloc_traits::construct( m_alloc, dest + i, std::move( m_first[i] ) );
+					alloc_traits::destroy( m_alloc, m_first + i );
+				}
+			}
+			m_first = dest;
+			m_last = dest + count;
+		}
+
+		/**
+		 * moves the list to a new block of new_cap elements, leaving front_room free slots before it.
+		 * On exception the list is unchanged.
+		*/
+		void reallocate( size_t new_cap, size_t front_room )
+		{
+			size_t count = size();
+			T* block = alloc_traits::allocate( m_alloc, new_cap );
+			T* dest = block + front_room;
+			if constexpr ( trivially_relocatable )
+			{
+				if( count != 0 )
+					std::memcpy( static_cast<void*>( dest ), static_cast<const void*>( m_first ), count * sizeof(T) );
+			}
+			else
+			{
+				T* cur = dest;
+				try {
+					for( T* it = m_first; it != m_last; ++it, ++cur )
+						alloc_traits::construct( m_alloc, cur, std::move_if_noexcept( *it ) );
+				}
+				catch( ... ) {
+					destroy( dest, cur );
+					alloc_traits::deallocate( m_alloc, block, new_cap );
+					throw;
+				}
+				destroy( m_first, m_last );
+			}
+			deallocate();
+			m_storage = block;
+			m_capacity = new_cap;
+			m_first = dest;
+			m_last = dest + count;
+		}
+};
+
+/**
+ * Checks if the contents of lhs and rhs are equal.
+*/
+template< typename T, typename Alloc >
+bool operator==( const sc::devector<T, Alloc>& lhs, const sc::devector<T, Alloc>& rhs )
+{ return lhs.size() == rhs.size() && sc::simd::equal( lhs.data(), rhs.data(), lhs.size() ); }
+
+/**
+ * Similar to the previous operator, but the opposite result.
+*/
+template< typename T, typename Alloc >
+bool operator!=( const sc::devector<T, Alloc>& lhs, const sc::devector<T, Alloc>& rhs )
+{ return !( lhs == rhs ); }
+}//namespace
+
+#endif
@@ -0,0 +1,445 @@
+#ifndef EXPR_H
+#define EXPR_H
+#include "vector.h"
+#include "simd.h"
+#include <cmath> // std::sqrt, std::fma
+#include <cstddef>
+#include <cstring> // std::memcpy
+#include <stdexcept> // std::length_error
+#include <tuple>
+#include <type_traits>
+#include <utility> // std::index_sequence
+
+/**
+ * Lazy element-wise arithmetic on sc::vector of arithmetic types. The operators only build a small
+ * expression object that points to the operands; the whole tree is computed in one pass, with no
+ * temporary lists, when it is assigned to a sc::vector or reduced:
+ *
+ *     sc::vector<double> r = a * b + c;          // one loop, one allocation (none if r is big enough)
+ *     r = sc::sqrt( sc::abs( a - 2.0 ) );        // scalars are broadcast to every element
+ *     double d = sc::dot( a, b ), s = sc::sum( a * 0.5 + c );
+ *
+ * Supported: + - * / between lists and scalars, unary -, sqrt (floating point), abs, fma(a, b, c) and the
+ * reductions sum and dot. A scalar must fit the element type: sc::vector<int> * 0.5 does not compile
+ * (it would multiply by 0), sc::vector<float> needs 0.5f, while integer literals work with any integers.
+ * Evaluation goes one vector register at a time, dispatched at run time to SSE2, AVX2 (with FMA) or
+ * AVX-512 like simd.h; other element types and non-x86 builds use a scalar loop.
+ *
+ * Operands must have the same size (std::length_error otherwise) and must outlive the expression: keep
+ * expressions inside one statement rather than storing them in auto variables. Element i of the result
+ * depends only on element i of the operands, so r = r * 2 + a is safe. sum and dot add in a different
+ * order than a sequential loop, so floating-point results may differ in the last bits.
+*/
+#if defined(__GNUC__)
+#define SC_EXPR_INLINE inline __attribute__(( always_inline ))
+#else
+#define SC_EXPR_INLINE inline
+#endif
+
+namespace sc{
+namespace expr{
+namespace detail{
+	template < typename X >
+	struct is_sc_vector : std::false_type { /* empty */ };
+
+	template < typename T, typename A, typename G, typename I >
+	struct is_sc_vector< sc::vector<T, A, G, I> > : std::is_arithmetic<T> { /* empty */ };
+
+	/// X is a list or an expression: something with one value per element.
+	template < typename X >
+	struct is_array : std::integral_constant< bool, std::is_base_of< node, X >::value || is_sc_vector<X>::value >
+	{ /* empty */ };
+
+	/// X may appear on either side of an operator: a list, an expression or a scalar.
+	template < typename X >
+	struct is_operand : std::integral_constant< bool, is_array<X>::value || std::is_arithmetic<X>::value >
+	{ /* empty */ };
+
+	/// element type of an array operand; void for a scalar.
+	template < typename X, typename = void >
+	struct element_of { typedef void type; };
+
+	template < typename X >
+	struct element_of< X, typename std::enable_if< is_array<X>::value >::type > { typedef typename X::value_type type; };
+
+	/// element type of an expression over the operands Xs: that of the first array among them (void if none).
+	template < typename... Xs >
+	struct value_of { typedef void type; };
+
+	template < typename X, typename... Rest >
+	struct value_of<X, Rest...>
+		: std::conditional< std::is_void< typename element_of<X>::type >::value, value_of<Rest...>, element_of<X> >::type
+	{ /* empty */ };
+
+	/**
+	 * a scalar of type X may be used with elements of type T if T holds all its values: the common type
+	 * of T and X is T, or both are integers (integer literals are int, so bytes + 1 is accepted). So
+	 * sc::vector<int> * 0.5 does not compile instead of multiplying by 0. Arrays always fit.
+	*/
+	template < typename X, typename T, bool Scalar = std::is_arithmetic<X>::value && std::is_arithmetic<T>::value >
+	struct operand_fits : std::true_type { /* empty */ };
+
+	template < typename X, typename T >
+	struct operand_fits< X, T, true >
+		: std::integral_constant< bool, std::is_same< typename std::common_type<T, X>::type, T >::value
+		                                || ( std::is_integral<T>::value && std::is_integral<X>::value ) >
+	{ /* empty */ };
+
+	/// SFINAE guard of the binary operators: both operands valid, at least one of them an array, and a
+	/// scalar operand that fits the element type.
+	template < typename L, typename R >
+	using if_binary = typename std::enable_if< is_operand<L>::value && is_operand<R>::value
+	                                           && ( is_array<L>::value || is_array<R>::value )
+	                                           && operand_fits< L, typename value_of<L, R>::type >::value
+	                                           && operand_fits< R, typename value_of<L, R>::type >::value >::type;
+
+	template < typename X >
+	using if_array = typename std::enable_if< is_array<X>::value >::type;
+
+	inline std::size_t common_size( std::size_t a, std::size_t b )
+	{
+		if( a != b )
+			throw std::length_error( "sc::expr: operands of different sizes" );
+		return a;
+	}
+}// namespace detail
+
+	/**
+	 * Leaf that reads n elements from a contiguous block (the storage of a sc::vector).
+	*/
+	template < typename T >
+	class terminal : public node{
+		public:
+			typedef T value_type;
+
+			terminal( const T* data, std::size_t n ): m_data{ data }, m_size{ n }
+			{ /* empty */ }
+
+			std::size_t size( void )const { return m_size; }
+			const T* data( void )const { return m_data; }
+			SC_EXPR_INLINE T operator[]( std::size_t i )const { return m_data[i]; }
+
+		private:
+			const T* m_data;
+			std::size_t m_size;
+	};
+
+	/**
+	 * Leaf holding one value, repeated for every element.
+	*/
+	template < typename T >
+	class broadcast : public node{
+		public:
+			typedef T value_type;
+
+			explicit broadcast( T value ): m_value{ value }
+			{ /* empty */ }
+
+			T value( void )const { return m_value; }
+			SC_EXPR_INLINE T operator[]( std::size_t )const { return m_value; }
+
+		private:
+			T m_value;
+	};
+
+	/**
+	 * Operations of the nodes. apply() computes one element; expr_kernels.h has the register version
+	 * of each of them.
+	*/
+	struct add { template < typename T > static SC_EXPR_INLINE T apply( T a, T b ) { return a + b; } };
+	struct sub { template < typename T > static SC_EXPR_INLINE T apply( T a, T b ) { return a - b; } };
+	struct mul { template < typename T > static SC_EXPR_INLINE T apply( T a, T b ) { return a * b; } };
+	struct div { template < typename T > static SC_EXPR_INLINE T apply( T a, T b ) { return a / b; } };
+	struct neg { template < typename T > static SC_EXPR_INLINE T apply( T a ) { return -a; } };
+
+	struct abs{
+		template < typename T >
+		static SC_EXPR_INLINE T apply( T a )
+		{
+			if constexpr ( std::is_unsigned<T>::value )
+				return a;
+			else
+				return ( -a < a ) ? a : -a; // Para -0.0 devolve +0.0; para NaN devolve NaN.
+		}
+	};
+
+	struct sqrt{
+		template < typename T >
+		static SC_EXPR_INLINE T apply( T a ) { return std::sqrt( a ); }
+	};
+
+	struct fma{
+		template < typename T >
+		static SC_EXPR_INLINE T apply( T a, T b, T c )
+		{
+			if constexpr ( std::is_floating_point<T>::value )
+				return std::fma( a, b, c );
+			else
+				return a * b + c;
+		}
+	};
+
+	/**
+	 * Node applying Op to the elements of one, two or three operands (leaves or other nodes, kept by value).
+	*/
+	template < typename Op, typename... Args >
+	class node_of : public node{
+		public:
+			typedef typename std::common_type< typename Args::value_type... >::type value_type;
+
+			explicit node_of( const Args&... args ): m_args{ args... }, m_size{ size_of( args... ) }
+			{ /* empty */ }
+
+			std::size_t size( void )const { return m_size; }
+			const std::tuple<Args...>& args( void )const { return m_args; }
+
+			SC_EXPR_INLINE value_type operator[]( std::size_t i )const
+			{ return call( i, std::index_sequence_for<Args...>() ); }
+
+			/**
+			 * writes the n = size() values of the expression to out, which has room for them.
+			*/
+			void evaluate( value_type* out )const;
+
+		private:
+			std::tuple<Args...> m_args;
+			std::size_t m_size;
+
+			template < std::size_t... I >
+			SC_EXPR_INLINE value_type call( std::size_t i, std::index_sequence<I...> )const
+			{ return Op::template apply<value_type>( std::get<I>( m_args )[i]... ); }
+
+			/// size of the arrays among the operands (broadcast leaves have none).
+			template < typename A, typename... Rest >
+			static std::size_t size_of( const A& a, const Rest&... rest )
+			{
+				if constexpr ( sizeof...( Rest ) == 0 )
+					return a.size();
+				else if constexpr ( std::is_same< A, broadcast<typename A::value_type> >::value )
+					return size_of( rest... );
+				else if constexpr ( ( std::is_same< Rest, broadcast<typename Rest::value_type> >::value && ... ) )
+					return a.size();
+				else
+					return detail::common_size( a.size(), size_of( rest... ) );
+			}
+	};
+
+namespace detail{
+	/**
+	 * wraps an operand as a node: a list becomes a terminal, a scalar a broadcast of T, and an
+	 * expression is copied as it is.
+	*/
+	template < typename T, typename X >
+	auto leaf( const X& x )
+	{
+		if constexpr ( std::is_base_of< node, X >::value )
+			return x;
+		else if constexpr ( std::is_arithmetic<X>::value )
+			return broadcast<T>( static_cast<T>( x ) );
+		else
+			return terminal<typename X::value_type>( x.data(), x.size() );
+	}
+
+	template < typename... Xs >
+	using same_elements = std::integral_constant< bool, ( ( std::is_void< typename element_of<Xs>::type >::value
+	                                                        || std::is_same< typename element_of<Xs>::type, typename value_of<Xs...>::type >::value ) && ... ) >;
+
+	template < typename Op, typename... Xs >
+	auto make( const Xs&... xs )
+	{
+		typedef typename value_of<Xs...>::type T;
+		static_assert( std::is_arithmetic<T>::value, "sc::expr: element-wise arithmetic needs arithmetic element types" );
+		static_assert( same_elements<Xs...>::value, "sc::expr: lists and expressions in one expression must have the same element type" );
+		return node_of< Op, decltype( leaf<T>( xs ) )... >( leaf<T>( xs )... );
+	}
+
+	/// instruction sets the evaluation loops are compiled for.
+#ifdef SC_SIMD_X86
+#pragma GCC push_options
+#pragma GCC target("sse2")
+	namespace sse2{
+#define SC_EXPR_BYTES 16
+#define SC_EXPR_SQRT_PS( v ) _mm_sqrt_ps( (__m128)( v ) )
+#define SC_EXPR_SQRT_PD( v ) _mm_sqrt_pd( (__m128d)( v ) )
+#include "expr_kernels.h"
+#undef SC_EXPR_SQRT_PD
+#undef SC_EXPR_SQRT_PS
+#undef SC_EXPR_BYTES
+	}
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+	namespace avx2{
+#define SC_EXPR_BYTES 32
+#define SC_EXPR_SQRT_PS( v ) _mm256_sqrt_ps( (__m256)( v ) )
+#define SC_EXPR_SQRT_PD( v ) _mm256_sqrt_pd( (__m256d)( v ) )
+#define SC_EXPR_FMA_PS( a, b, c ) _mm256_fmadd_ps( (__m256)( a ), (__m256)( b ), (__m256)( c ) )
+#define SC_EXPR_FMA_PD( a, b, c ) _mm256_fmadd_pd( (__m256d)( a ), (__m256d)( b ), (__m256d)( c ) )
+#include "expr_kernels.h"
+#undef SC_EXPR_FMA_PD
+#undef SC_EXPR_FMA_PS
+#undef SC_EXPR_SQRT_PD
+#undef SC_EXPR_SQRT_PS
+#undef SC_EXPR_BYTES
+	}
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+	namespace avx512{
+#define SC_EXPR_BYTES 64
+// maskz: _mm512_sqrt_pd parte de _mm512_undefined_pd, que o GCC 12 acusa como não inicializado.
+#define SC_EXPR_SQRT_PS( v ) _mm512_maskz_sqrt_ps( (__mmask16) -1, (__m512)( v ) )
+#define SC_EXPR_SQRT_PD( v ) _mm512_maskz_sqrt_pd( (__mmask8) -1, (__m512d)( v ) )
+#define SC_EXPR_FMA_PS( a, b, c ) _mm512_fmadd_ps( (__m512)( a ), (__m512)( b ), (__m512)( c ) )
+#define SC_EXPR_FMA_PD( a, b, c ) _mm512_fmadd_pd( (__m512d)( a ), (__m512d)( b ), (__m512d)( c ) )
+#include "expr_kernels.h"
+#undef SC_EXPR_FMA_PD
+#undef SC_EXPR_FMA_PS
+#undef SC_EXPR_SQRT_PD
+#undef SC_EXPR_SQRT_PS
+#undef SC_EXPR_BYTES
+	}
+#pragma GCC pop_options
+#endif
+
+	/**
+	 * out[i] = e[i] for i < n, on the widest instruction set available.
+	*/
+	template < typename T, typename E >
+	void assign( T* out, const E& e, std::size_t n )
+	{
+#ifdef SC_SIMD_X86
+		if constexpr ( sc::simd::is_vectorizable<T>::value )
+		{
+			switch( sc::simd::active_isa() )
+			{
+				case sc::simd::isa::avx512: return avx512::assign( out, e, n );
+				case sc::simd::isa::avx2: return avx2::assign( out, e, n );
+				case sc::simd::isa::sse2: return sse2::assign( out, e, n );
+				default: break;
+			}
+		}
+#endif
+		for( std::size_t i = 0; i < n; i++ )
+			out[i] = e[i];
+	}
+
+	/**
+	 * sum of e[i] for i < n, on the widest instruction set available.
+	*/
+	template < typename T, typename E >
+	T sum( const E& e, std::size_t n )
+	{
+#ifdef SC_SIMD_X86
+		if constexpr ( sc::simd::is_vectorizable<T>::value )
+		{
+			switch( sc::simd::active_isa() )
+			{
+				case sc::simd::isa::avx512: return avx512::sum<T>( e, n );
+				case sc::simd::isa::avx2: return avx2::sum<T>( e, n );
+				case sc::simd::isa::sse2: return sse2::sum<T>( e, n );
+				default: break;
+			}
+		}
+#endif
+		T total = T();
+		for( std::size_t i = 0; i < n; i++ )
+			total += e[i];
+		return total;
+	}
+}// namespace detail
+
+	template < typename Op, typename... Args >
+	void node_of<Op, Args...>::evaluate( value_type* out )const
+	{ detail::assign( out, *this, m_size ); }
+
+	//=== Operators
+
+	/**
+	 * element-wise sum. Either side may be a sc::vector, an expression or a scalar (broadcast).
+	*/
+	template < typename L, typename R, typename = detail::if_binary<L, R> >
+	auto operator+( const L& l, const R& r ) { return detail::make<add>( l, r ); }
+
+	/**
+	 * element-wise difference.
+	*/
+	template < typename L, typename R, typename = detail::if_binary<L, R> >
+	auto operator-( const L& l, const R& r ) { return detail::make<sub>( l, r ); }
+
+	/**
+	 * element-wise product.
+	*/
+	template < typename L, typename R, typename = detail::if_binary<L, R> >
+	auto operator*( const L& l, const R& r ) { return detail::make<mul>( l, r ); }
+
+	/**
+	 * element-wise quotient.
+	*/
+	template < typename L, typename R, typename = detail::if_binary<L, R> >
+	auto operator/( const L& l, const R& r ) { return detail::make<div>( l, r ); }
+
+	/**
+	 * element-wise negation.
+	*/
+	template < typename X, typename = detail::if_array<X> >
+	auto operator-( const X& x ) { return detail::make<neg>( x ); }
+}// namespace expr
+
+	using expr::operator+;
+	using expr::operator-;
+	using expr::operator*;
+	using expr::operator/;
+
+	/**
+	 * element-wise absolute value.
+	*/
+	template < typename X, typename = expr::detail::if_array<X> >
+	auto abs( const X& x ) { return expr::detail::make<expr::abs>( x ); }
+
+	/**
+	 * element-wise square root (floating-point elements only).
+	*/
+	template < typename X, typename = expr::detail::if_array<X> >
+	auto sqrt( const X& x )
+	{
+		static_assert( std::is_floating_point< typename X::value_type >::value, "sc::sqrt needs floating-point elements" );
+		return expr::detail::make<expr::sqrt>( x );
+	}
+
+	/**
+	 * element-wise a * b + c. For floating point the product is not rounded before the addition
+	 * (one FMA instruction where available, std::fma otherwise), so it may differ from a * b + c.
+	*/
+	template < typename A, typename B, typename C,
+	           typename = typename std::enable_if< expr::detail::is_operand<A>::value && expr::detail::is_operand<B>::value
+	                                               && expr::detail::is_operand<C>::value
+	                                               && ( expr::detail::is_array<A>::value || expr::detail::is_array<B>::value
+	                                                    || expr::detail::is_array<C>::value )
+	                                               && expr::detail::operand_fits< A, typename expr::detail::value_of<A, B, C>::type >::value
+	                                               && expr::detail::operand_fits< B, typename expr::detail::value_of<A, B, C>::type >::value
+	                                               && expr::detail::operand_fits< C, typename expr::detail::value_of<A, B, C>::type >::value >::type >
+	auto fma( const A& a, const B& b, const C& c ) { return expr::detail::make<expr::fma>( a, b, c ); }
+
+	/**
+	 * returns the sum of the elements of a list or an expression, computed in one pass.
+	*/
+	template < typename X, typename = expr::detail::if_array<X> >
+	auto sum( const X& x )
+	{
+		auto e = expr::detail::leaf< typename X::value_type >( x );
+		return expr::detail::sum< typename decltype( e )::value_type >( e, x.size() );
+	}
+
+	/**
+	 * returns the sum of a[i] * b[i], computed in one pass with no temporary list.
+	*/
+	template < typename A, typename B, typename = expr::detail::if_array<A>, typename = expr::detail::if_array<B> >
+	auto dot( const A& a, const B& b )
+	{ return sc::sum( a * b ); }
+}// namespace sc
+
+#undef SC_EXPR_INLINE
+#endif
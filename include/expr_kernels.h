@@ -0,0 +1,145 @@
+/**
+ * Register versions of the element-wise expressions of expr.h. Like simd_kernels.h, this file has no
+ * include guard: expr.h includes it once per instruction set, inside a "#pragma GCC target" region and
+ * a namespace of its own, after defining
+ *
+ *   SC_EXPR_BYTES                 width of one vector register, in bytes;
+ *   SC_EXPR_SQRT_PS(v), _PD(v)    square root of a register of float / double;
+ *   SC_EXPR_FMA_PS(a, b, c), _PD  a * b + c rounded once (optional: lane by lane std::fma otherwise).
+ *
+ * Everything that handles registers is defined here, so the whole tree of an expression is compiled
+ * for this instruction set and inlined into the loops at the end.
+ *
+ * Do not include it directly.
+*/
+
+/// Width of one vector, in bytes.
+constexpr std::size_t bytes = SC_EXPR_BYTES;
+
+/// Vector of T filling one register.
+template < typename T >
+using vec = typename sc::simd::detail::vector_of< T, bytes >::type;
+
+//=== Operations on one register
+
+template < typename T > SC_EXPR_INLINE vec<T> apply( sc::expr::add, vec<T> a, vec<T> b ) { return a + b; }
+template < typename T > SC_EXPR_INLINE vec<T> apply( sc::expr::sub, vec<T> a, vec<T> b ) { return a - b; }
+template < typename T > SC_EXPR_INLINE vec<T> apply( sc::expr::mul, vec<T> a, vec<T> b ) { return a * b; }
+template < typename T > SC_EXPR_INLINE vec<T> apply( sc::expr::div, vec<T> a, vec<T> b ) { return a / b; }
+template < typename T > SC_EXPR_INLINE vec<T> apply( sc::expr::neg, vec<T> a ) { return -a; }
+
+template < typename T >
+SC_EXPR_INLINE vec<T> apply( sc::expr::abs, vec<T> a )
+{
+	if constexpr ( std::is_unsigned<T>::value )
+		return a;
+	else
+		return ( -a < a ) ? a : -a;
+}
+
+template < typename T >
+SC_EXPR_INLINE vec<T> apply( sc::expr::sqrt, vec<T> a )
+{
+	if constexpr ( std::is_same<T, float>::value )
+		return (vec<T>) SC_EXPR_SQRT_PS( a );
+	else
+		return (vec<T>) SC_EXPR_SQRT_PD( a );
+}
+
+template < typename T >
+SC_EXPR_INLINE vec<T> apply( sc::expr::fma, vec<T> a, vec<T> b, vec<T> c )
+{
+	if constexpr ( !std::is_floating_point<T>::value )
+		return a * b + c;
+#ifdef SC_EXPR_FMA_PD
+	else if constexpr ( std::is_same<T, float>::value )
+		return (vec<T>) SC_EXPR_FMA_PS( a, b, c );
+	else
+		return (vec<T>) SC_EXPR_FMA_PD( a, b, c );
+#else
+	else
+	{
+		for( std::size_t k = 0; k < bytes / sizeof(T); k++ )
+			a[k] = std::fma( a[k], b[k], c[k] );
+		return a;
+	}
+#endif
+}
+
+//=== Evaluation of the nodes, one register (elements i to i + bytes / sizeof(T) - 1) at a time
+
+template < typename T >
+SC_EXPR_INLINE vec<T> packet( const sc::expr::terminal<T>& leaf, std::size_t i )
+{
+	vec<T> v;
+	std::memcpy( &v, leaf.data() + i, bytes );
+	return v;
+}
+
+template < typename T >
+SC_EXPR_INLINE vec<T> packet( const sc::expr::broadcast<T>& leaf, std::size_t )
+{ return vec<T>{} + leaf.value(); }
+
+template < typename Op, typename... Args, std::size_t... I >
+SC_EXPR_INLINE vec< typename sc::expr::node_of<Op, Args...>::value_type >
+packet( const sc::expr::node_of<Op, Args...>& e, std::size_t i, std::index_sequence<I...> );
+
+template < typename Op, typename... Args >
+SC_EXPR_INLINE vec< typename sc::expr::node_of<Op, Args...>::value_type >
+packet( const sc::expr::node_of<Op, Args...>& e, std::size_t i )
+{ return packet( e, i, std::index_sequence_for<Args...>() ); }
+
+template < typename Op, typename... Args, std::size_t... I >
+SC_EXPR_INLINE vec< typename sc::expr::node_of<Op, Args...>::value_type >
+packet( const sc::expr::node_of<Op, Args...>& e, std::size_t i, std::index_sequence<I...> )
+{
+	typedef typename sc::expr::node_of<Op, Args...>::value_type T;
+	return apply<T>( Op(), packet( std::get<I>( e.args() ), i )... );
+}
+
+//=== Loops
+
+/**
+ * out[i] = e[i] for every i < n, one register at a time.
+*/
+template < typename T, typename E >
+void assign( T* out, const E& e, std::size_t n )
+{
+	constexpr std::size_t lanes = bytes / sizeof(T);
+	std::size_t i = 0;
+	for( ; i + lanes <= n; i += lanes )
+	{
+		vec<T> v = packet( e, i );
+		std::memcpy( static_cast<void*>( out + i ), &v, bytes );
+	}
+	for( ; i < n; i++ )
+		out[i] = e[i];
+}
+
+/**
+ * returns the sum of e[i] for i < n. Four registers accumulate in turn, so the additions of
+ * consecutive iterations do not wait for each other.
+*/
+template < typename T, typename E >
+T sum( const E& e, std::size_t n )
+{
+	constexpr std::size_t lanes = bytes / sizeof(T);
+	vec<T> acc0 = vec<T>{}, acc1 = acc0, acc2 = acc0, acc3 = acc0;
+	std::size_t i = 0;
+	for( ; i + 4 * lanes <= n; i += 4 * lanes )
+	{
+		acc0 += packet( e, i );
+		acc1 += packet( e, i + lanes );
+		acc2 += packet( e, i + 2 * lanes );
+		acc3 += packet( e, i + 3 * lanes );
+	}
+	for( ; i + lanes <= n; i += lanes )
+		acc0 += packet( e, i );
+	acc0 = ( acc0 + acc1 ) + ( acc2 + acc3 );
+	T total = T();
+	for( std::size_t k = 0; k < lanes; k++ )
+		total += acc0[k];
+	for( ; i < n; i++ )
+		total += e[i];
+	return total;
+}
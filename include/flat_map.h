@@ -0,0 +1,433 @@
+#ifndef FLAT_MAP_H
+#define FLAT_MAP_H
+#include "flat_set.h"
+#include "vector.h"
+#include <algorithm> // std::stable_sort, std::inplace_merge
+#include <cstddef>
+#include <functional> // std::less
+#include <initializer_list>
+#include <iterator>
+#include <memory> // std::allocator, std::allocator_traits
+#include <stdexcept> // std::out_of_range
+#include <type_traits>
+#include <utility> // std::pair, std::move, std::forward
+
+namespace sc{
+namespace detail{
+	/**
+	 * Iterator of sc::flat_map: one position in the key array and the same position in the value array.
+	 * Dereferencing gives a pair of references, std::pair<const K&, V&> (const V& when Const).
+	*/
+	template < typename K, typename V, bool Const >
+	class flat_map_iterator{
+		public:
+			typedef std::random_access_iterator_tag iterator_category;
+			typedef std::pair<K, V> value_type;
+			typedef std::ptrdiff_t difference_type;
+			typedef typename std::conditional<Const, const V, V>::type mapped;
+			typedef std::pair<const K&, mapped&> reference;
+
+			/// Holds the pair of references so that it->first and it->second work.
+			struct pointer{
+				reference ref;
+				const reference* operator->( void )const { return &ref; }
+			};
+
+			flat_map_iterator( void ): m_key{ nullptr }, m_value{ nullptr }
+			{ /* empty */ }
+
+			flat_map_iterator( const K* key, mapped* value ): m_key{ key }, m_value{ value }
+			{ /* empty */ }
+
+			/// a mutable iterator converts to a const one.
+			template < bool C = Const, typename = typename std::enable_if<C>::type >
+			flat_map_iterator( const flat_map_iterator<K, V, false>& other ): m_key{ other.key_ptr() }, m_value{ other.value_ptr() }
+			{ /* empty */ }
+
+			reference operator*( void )const { return reference( *m_key, *m_value ); }
+			pointer operator->( void )const { return pointer{ **this }; }
+			reference operator[]( difference_type n )const { return *( *this + n ); }
+
+			flat_map_iterator& operator++( void ) { ++m_key; ++m_value; return *this; }
+			flat_map_iterator operator++( int ) { flat_map_iterator old = *this; ++*this; return old; }
+			flat_map_iterator& operator--( void ) { --m_key; --m_value; return *this; }
+			flat_map_iterator operator--( int ) { flat_map_iterator old = *this; --*this; return old; }
+			flat_map_iterator& operator+=( difference_type n ) { m_key += n; m_value += n; return *this; }
+			flat_map_iterator& operator-=( difference_type n ) { m_key -= n; m_value -= n; return *this; }
+
+			friend flat_map_iterator operator+( flat_map_iterator it, difference_type n ) { return it += n; }
+			friend flat_map_iterator operator+( difference_type n, flat_map_iterator it ) { return it += n; }
+			friend flat_map_iterator operator-( flat_map_iterator it, difference_type n ) { return it -= n; }
+			friend difference_type operator-( const flat_map_iterator& a, const flat_map_iterator& b ) { return a.m_key - b.m_key; }
+
+			friend bool operator==( const flat_map_iterator& a, const flat_map_iterator& b ) { return a.m_key == b.m_key; }
+			friend bool operator!=( const flat_map_iterator& a, const flat_map_iterator& b ) { return a.m_key != b.m_key; }
+			friend bool operator<( const flat_map_iterator& a, const flat_map_iterator& b ) { return a.m_key < b.m_key; }
+			friend bool operator>( const flat_map_iterator& a, const flat_map_iterator& b ) { return a.m_key > b.m_key; }
+			friend bool operator<=( const flat_map_iterator& a, const flat_map_iterator& b ) { return a.m_key <= b.m_key; }
+			friend bool operator>=( const flat_map_iterator& a, const flat_map_iterator& b ) { return a.m_key >= b.m_key; }
+
+			const K* key_ptr( void )const { return m_key; }
+			mapped* value_ptr( void )const { return m_value; }
+
+		private:
+			const K* m_key;
+			mapped* m_value;
+	};
+}// namespace detail
+
+/**
+ * Sorted map of unique keys kept in two sc::vector: one with the keys, one with the values, at the same
+ * positions. Lookups binary-search the key array only (see sorted_search / eytzinger_search), so a
+ * search touches no value; keys() and values() expose both arrays for linear scans.
+ *
+ * As in sc::flat_set, a single insert or erase shifts both arrays (O(n)), while the bulk
+ * insert( first, last ) appends, sorts and merges in O(n + m log m).
+ *
+ * Iterators yield std::pair<const K&, V&> (a pair of references, not a reference to a pair), and are
+ * invalidated by any insertion or erase.
+*/
+template< typename K, typename V, typename Compare = std::less<K>, typename KeyAllocator = std::allocator<K>,
+          typename MappedAllocator = std::allocator<V>, typename Search = sc::sorted_search >
+class flat_map{
+	public:
+		typedef K key_type;
+		typedef V mapped_type;
+		typedef std::pair<K, V> value_type;
+		typedef Compare key_compare;
+		typedef std::size_t size_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef detail::flat_map_iterator<K, V, false> iterator;
+		typedef detail::flat_map_iterator<K, V, true> const_iterator;
+		typedef std::reverse_iterator<iterator> reverse_iterator;
+		typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+		typedef sc::vector<K, KeyAllocator> key_container_type;
+		typedef sc::vector<V, MappedAllocator> mapped_container_type;
+
+	private:
+		key_container_type m_keys; //!< Sorted keys, no two equivalent.
+		mapped_container_type m_values; //!< m_values[i] belongs to m_keys[i].
+		Compare m_comp;
+		detail::search_index<K, Compare, KeyAllocator, Search> m_index;
+
+	public:
+		//=== [I] SPECIAL MEMBERS
+
+		/**
+		 * Constructs an empty map.
+		*/
+		explicit flat_map( const Compare& comp = Compare(), const KeyAllocator& key_alloc = KeyAllocator(),
+		                   const MappedAllocator& mapped_alloc = MappedAllocator() ):
+			m_keys( key_alloc ), m_values( mapped_alloc ), m_comp( comp ), m_index( key_alloc )
+		{ /* empty */ }
+
+		/**
+		 * Constructs the map with the (key, value) pairs of [first, last), in any order; of equivalent keys
+		 * the first one is kept.
+		*/
+		template< typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category >
+		flat_map( InputIt first, InputIt last, const Compare& comp = Compare() ):
+			flat_map( comp )
+		{ insert( first, last ); }
+
+		/**
+		 * Constructs the map with the pairs of ilist.
+		*/
+		flat_map( std::initializer_list<value_type> ilist, const Compare& comp = Compare() ):
+			flat_map( ilist.begin(), ilist.end(), comp )
+		{ /* empty */ }
+
+		flat_map( const flat_map& ) = default;
+		flat_map( flat_map&& ) = default;
+		flat_map& operator=( const flat_map& ) = default;
+		flat_map& operator=( flat_map&& ) = default;
+
+		key_compare key_comp( void )const { return m_comp; }
+
+		//=== [II] ITERATORS
+
+		iterator begin( void ) { return iterator( m_keys.data(), m_values.data() ); }
+		iterator end( void ) { return begin() + size(); }
+		const_iterator begin( void )const { return const_iterator( m_keys.data(), m_values.data() ); }
+		const_iterator end( void )const { return begin() + size(); }
+		const_iterator cbegin( void )const { return begin(); }
+		const_iterator cend( void )const { return end(); }
+		reverse_iterator rbegin( void ) { return reverse_iterator( end() ); }
+		reverse_iterator rend( void ) { return reverse_iterator( begin() ); }
+		const_reverse_iterator rbegin( void )const { return const_reverse_iterator( end() ); }
+		const_reverse_iterator rend( void )const { return const_reverse_iterator( begin() ); }
+
+		//=== [III] Capacity
+
+		size_t size( void )const { return m_keys.size(); }
+		bool empty( void )const { return m_keys.empty(); }
+		size_t capacity( void )const { return m_keys.capacity(); }
+
+		/**
+		 * makes room for new_cap entries in both arrays.
+		*/
+		void reserve( size_t new_cap )
+		{
+			m_keys.reserve( new_cap );
+			m_values.reserve( new_cap );
+		}
+
+		void shrink_to_fit( void )
+		{
+			m_keys.shrink_to_fit();
+			m_values.shrink_to_fit();
+		}
+
+		//=== [IV] Modifiers
+
+		void clear( void )
+		{
+			m_keys.clear();
+			m_values.clear();
+			m_index.clear();
+		}
+
+		/**
+		 * inserts value if its key is not present (O(n): the entries after it are shifted).
+		 * @return the position of the key and whether the pair was inserted.
+		*/
+		std::pair<iterator, bool> insert( const value_type& value )
+		{ return try_emplace( value.first, value.second ); }
+
+		std::pair<iterator, bool> insert( value_type&& value )
+		{ return try_emplace( std::move( value.first ), std::move( value.second ) ); }
+
+		/**
+		 * inserts a value constructed from args under key, if key is not present; otherwise nothing
+		 * (args are not used).
+		*/
+		template< typename Key, typename... Args >
+		std::pair<iterator, bool> try_emplace( Key&& key, Args&&... args )
+		{
+			size_t idx = bound<false>( key );
+			if( idx != size() && !m_comp( key, m_keys[idx] ) )
+				return { begin() + idx, false };
+			m_index.clear();
+			m_keys.emplace( m_keys.cbegin() + idx, std::forward<Key>( key ) );
+			try {
+				m_values.emplace( m_values.cbegin() + idx, std::forward<Args>(args)... );
+			}
+			catch( ... ) {
+				m_keys.erase( m_keys.cbegin() + idx );
+				throw;
+			}
+			return { begin() + idx, true };
+		}
+
+		/**
+		 * inserts value under key, or assigns it to the value already there.
+		 * @return the position of the key and whether a new entry was inserted.
+		*/
+		template< typename Key, typename M >
+		std::pair<iterator, bool> insert_or_assign( Key&& key, M&& value )
+		{
+			size_t idx = bound<false>( key );
+			if( idx != size() && !m_comp( key, m_keys[idx] ) )
+			{
+				m_values[idx] = std::forward<M>( value );
+				return { begin() + idx, false };
+			}
+			return try_emplace( std::forward<Key>( key ), std::forward<M>( value ) );
+		}
+
+		/**
+		 * inserts the (key, value) pairs of [first, last), in any order, in O(n + m log m): the pairs are
+		 * copied into separate key and value lists, the positions of old and new entries are sorted by key
+		 * and merged, and the entries moved into new arrays in that order. Keys already present, and
+		 * repeated ones in the range after the first, are dropped. If copying a key or a value throws, the
+		 * map is unchanged (moving one too, for types whose move constructor is not noexcept).
+		*/
+		template< typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category >
+		void insert( InputIt first, InputIt last )
+		{
+			// Lote separado: uma cópia que lança não deixa chaves e valores com tamanhos diferentes.
+			key_container_type new_keys( 0, m_keys.get_allocator() );
+			mapped_container_type new_values( 0, m_values.get_allocator() );
+			for( ; first != last; ++first )
+			{
+				new_keys.emplace_back( ( *first ).first );
+				new_values.emplace_back( ( *first ).second );
+			}
+			size_t old = m_keys.size(), total = old + new_keys.size();
+			if( total == old )
+				return;
+			// Ordena posições, não entradas: posição i < old é m_keys[i], as demais new_keys[i - old].
+			auto key_at = [&]( size_t i ) -> K& { return ( i < old ) ? m_keys[i] : new_keys[i - old]; };
+			auto value_at = [&]( size_t i ) -> V& { return ( i < old ) ? m_values[i] : new_values[i - old]; };
+			sc::vector<size_t> order( total );
+			for( size_t i = 0; i < total; i++ )
+				order.push_back( i );
+			auto by_key = [&]( size_t a, size_t b ){ return m_comp( key_at( a ), key_at( b ) ); };
+			std::stable_sort( order.data() + old, order.data() + total, by_key );
+			std::inplace_merge( order.data(), order.data() + old, order.data() + total, by_key );
+
+			key_container_type keys( total, m_keys.get_allocator() );
+			mapped_container_type values( total, m_values.get_allocator() );
+			for( size_t i = 0; i < total; i++ )
+			{
+				size_t from = order[i];
+				if( !keys.empty() && !m_comp( keys.back(), key_at( from ) ) )
+					continue; // equivalente à anterior: fica a que veio primeiro.
+				keys.push_back( std::move_if_noexcept( key_at( from ) ) );
+				values.push_back( std::move_if_noexcept( value_at( from ) ) );
+			}
+			m_keys.swap( keys );
+			m_values.swap( values );
+			m_index.rebuild( m_keys.data(), m_keys.size() );
+		}
+
+		void insert( std::initializer_list<value_type> ilist )
+		{ insert( ilist.begin(), ilist.end() ); }
+
+		/**
+		 * removes the entry with key equivalent to key, if any.
+		 * @return the number of entries removed (0 or 1).
+		*/
+		size_t erase( const K& key )
+		{
+			const_iterator pos = find( key );
+			if( pos == end() )
+				return 0;
+			erase( pos );
+			return 1;
+		}
+
+		/**
+		 * removes the entry at pos.
+		 * @return iterator following the removed entry.
+		*/
+		iterator erase( const_iterator pos )
+		{ return erase( pos, pos + 1 ); }
+
+		/**
+		 * removes the entries in [first, last).
+		*/
+		iterator erase( const_iterator first, const_iterator last )
+		{
+			size_t from = first - cbegin(), to = last - cbegin();
+			m_index.clear();
+			m_keys.erase( m_keys.cbegin() + from, m_keys.cbegin() + to );
+			m_values.erase( m_values.cbegin() + from, m_values.cbegin() + to );
+			return begin() + from;
+		}
+
+		/**
+		 * rebuilds the search index after single-element modifications (see eytzinger_search); does
+		 * nothing with sorted_search.
+		*/
+		void build_index( void )
+		{ m_index.rebuild( m_keys.data(), m_keys.size() ); }
+
+		void swap( flat_map& other ) noexcept
+		{
+			using std::swap;
+			m_keys.swap( other.m_keys );
+			m_values.swap( other.m_values );
+			swap( m_comp, other.m_comp );
+			swap( m_index, other.m_index );
+		}
+
+		//=== [V] Lookup
+
+		/**
+		 * returns an iterator to the entry with key equivalent to key, or end().
+		*/
+		iterator find( const K& key )
+		{ return begin() + find_index( key ); }
+
+		const_iterator find( const K& key )const
+		{ return begin() + find_index( key ); }
+
+		bool contains( const K& key )const { return find_index( key ) != size(); }
+		size_t count( const K& key )const { return contains( key ) ? 1 : 0; }
+
+		/**
+		 * returns an iterator to the first entry whose key is not less than key.
+		*/
+		iterator lower_bound( const K& key ) { return begin() + bound<false>( key ); }
+		const_iterator lower_bound( const K& key )const { return begin() + bound<false>( key ); }
+
+		/**
+		 * returns an iterator to the first entry whose key is greater than key.
+		*/
+		iterator upper_bound( const K& key ) { return begin() + bound<true>( key ); }
+		const_iterator upper_bound( const K& key )const { return begin() + bound<true>( key ); }
+
+		//=== [VI] Element access
+
+		/**
+		 * returns the value under key, inserting a value-initialized one if key is not present.
+		*/
+		V& operator[]( const K& key )
+		{ return ( *try_emplace( key ).first ).second; }
+
+		V& operator[]( K&& key )
+		{ return ( *try_emplace( std::move( key ) ).first ).second; }
+
+		/**
+		 * returns the value under key, with bounds-checking.
+		 * @throws std::out_of_range if key is not present.
+		*/
+		V& at( const K& key )
+		{
+			size_t idx = find_index( key );
+			if( idx == size() )
+				throw std::out_of_range( "[flat_map::at()] key not found" );
+			return m_values[idx];
+		}
+
+		const V& at( const K& key )const
+		{
+			size_t idx = find_index( key );
+			if( idx == size() )
+				throw std::out_of_range( "[flat_map::at()] key not found" );
+			return m_values[idx];
+		}
+
+		/**
+		 * returns the sorted keys.
+		*/
+		const key_container_type& keys( void )const { return m_keys; }
+
+		/**
+		 * returns the values, in the order of keys().
+		*/
+		const mapped_container_type& values( void )const { return m_values; }
+
+		/**
+		 * Checks if the contents of lhs and rhs are equal.
+		*/
+		friend bool operator==( const flat_map& lhs, const flat_map& rhs )
+		{ return lhs.m_keys == rhs.m_keys && lhs.m_values == rhs.m_values; }
+
+		friend bool operator!=( const flat_map& lhs, const flat_map& rhs )
+		{ return !( lhs == rhs ); }
+
+		friend void swap( flat_map& A, flat_map& B ) noexcept
+		{ A.swap( B ); }
+
+	private:
+		template< bool Upper >
+		size_t bound( const K& key )const
+		{
+			if( m_index.valid() )
+				return m_index.template bound<Upper>( key, m_comp );
+			return detail::branchless_bound<Upper>( m_keys.data(), m_keys.size(), key, m_comp );
+		}
+
+		/// position of key, or size() if it is not present.
+		size_t find_index( const K& key )const
+		{
+			if( m_index.valid() )
+				return m_index.find( key, m_comp );
+			size_t idx = bound<false>( key );
+			return ( idx != size() && !m_comp( key, m_keys[idx] ) ) ? idx : size();
+		}
+};
+}// namespace sc
+#endif
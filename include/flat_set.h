@@ -0,0 +1,489 @@
+#ifndef FLAT_SET_H
+#define FLAT_SET_H
+#include "vector.h"
+#include <algorithm> // std::stable_sort, std::inplace_merge, std::unique
+#include <cstddef>
+#include <cstdint> // std::uint32_t
+#include <functional> // std::less
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory> // std::allocator, std::allocator_traits
+#include <type_traits>
+#include <utility> // std::pair, std::move, std::forward
+
+namespace sc{
+	/**
+	 * Search policies of sc::flat_set and sc::flat_map.
+	 *
+	 * sorted_search looks keys up in the sorted array itself, with a branchless binary search that
+	 * prefetches both candidates of the next step: no extra memory, and every modification keeps lookups
+	 * fast. It is the right default.
+	 *
+	 * eytzinger_search also keeps a copy of the keys in Eytzinger (breadth-first) order, where the nodes
+	 * visited by a search sit close together and several levels ahead are prefetched with one line. It
+	 * can win on tables much larger than the cache, on machines with many misses in flight; measure with
+	 * bench/flat_map.cpp. The index costs sizeof(K) + 4 bytes per key (containers of 2^32 keys or more
+	 * keep only the binary search) and is rebuilt by the bulk operations (range constructor,
+	 * insert( first, last )) and by build_index(); a single-element insert or erase drops it, and
+	 * lookups use the binary search until the next rebuild.
+	*/
+	struct sorted_search { /* empty */ };
+	struct eytzinger_search { /* empty */ };
+
+namespace detail{
+	/**
+	 * index of the first element of the sorted range [first, first + n) that is not less than key
+	 * (Upper = false) or that is greater than key (Upper = true). The loop has no data-dependent branch:
+	 * the comparison only picks the next base (cmov), so there are no mispredictions to pay for.
+	*/
+	template < bool Upper, typename K, typename Key, typename Compare >
+	std::size_t branchless_bound( const K* first, std::size_t n, const Key& key, const Compare& comp )
+	{
+		if( n == 0 )
+			return 0;
+		const K* base = first;
+		while( n > 1 )
+		{
+			std::size_t half = n / 2;
+#if defined(__GNUC__)
+			// Os dois candidatos do próximo passo: um deles será lido, e a leitura já vem da cache.
+			__builtin_prefetch( base + half / 2 );
+			__builtin_prefetch( base + half + half / 2 );
+#endif
+			bool right = Upper ? !comp( key, base[half] ) : comp( base[half], key );
+			base = right ? base + half : base;
+			n -= half;
+		}
+		bool right = Upper ? !comp( key, *base ) : comp( *base, key );
+		return static_cast<std::size_t>( base - first ) + right;
+	}
+
+	/**
+	 * Index of the policy Search over the sorted keys of a flat container (see sorted_search). The
+	 * primary template, for sorted_search, holds nothing.
+	*/
+	template < typename K, typename Compare, typename Allocator, typename Search >
+	class search_index{
+		public:
+			explicit search_index( const Allocator& ) { /* empty */ }
+			void rebuild( const K*, std::size_t ) { /* empty */ }
+			void clear( void ) { /* empty */ }
+			bool valid( void )const { return false; }
+
+			template < bool Upper, typename Key >
+			std::size_t bound( const Key&, const Compare& )const { return 0; }
+
+			template < typename Key >
+			std::size_t find( const Key&, const Compare& )const { return 0; }
+	};
+
+	/**
+	 * Eytzinger index: m_tree[1..n] holds the keys in breadth-first order of the implicit binary search
+	 * tree (children of k at 2k and 2k + 1), m_rank[k] the position of m_tree[k] in the sorted array.
+	*/
+	template < typename K, typename Compare, typename Allocator >
+	class search_index< K, Compare, Allocator, eytzinger_search >{
+		public:
+			typedef typename std::allocator_traits<Allocator>::template rebind_alloc<std::uint32_t> rank_allocator;
+
+			explicit search_index( const Allocator& alloc ): m_tree( alloc ), m_rank( rank_allocator( alloc ) )
+			{ /* empty */ }
+
+			/**
+			 * builds the index of the n sorted keys at sorted.
+			*/
+			void rebuild( const K* sorted, std::size_t n )
+			{
+				clear();
+				if( n == 0 || n >= std::numeric_limits<std::uint32_t>::max() )
+					return; // sem índice: as buscas usam a busca binária.
+				m_tree.assign( n + 1, sorted[0] ); // posição 0 não é usada.
+				m_rank.assign( n + 1, 0 );
+				std::size_t next = 0;
+				fill( sorted, n, 1, next );
+			}
+
+			void clear( void )
+			{
+				m_tree.clear();
+				m_rank.clear();
+			}
+
+			bool valid( void )const { return !m_tree.empty(); }
+
+			/**
+			 * same as branchless_bound over the sorted keys, walking the tree instead.
+			*/
+			template < bool Upper, typename Key >
+			std::size_t bound( const Key& key, const Compare& comp )const
+			{
+				std::size_t k = descend<Upper>( key, comp );
+				return ( k == 0 ) ? m_tree.size() - 1 : m_rank[k];
+			}
+
+			/**
+			 * position of the key equivalent to key in the sorted array, or n. The match is checked on the
+			 * tree node itself, so the sorted array is not read.
+			*/
+			template < typename Key >
+			std::size_t find( const Key& key, const Compare& comp )const
+			{
+				std::size_t k = descend<false>( key, comp );
+				return ( k == 0 || comp( key, m_tree[k] ) ) ? m_tree.size() - 1 : m_rank[k];
+			}
+
+		private:
+			sc::vector<K, Allocator> m_tree;
+			sc::vector<std::uint32_t, rank_allocator> m_rank;
+
+			/**
+			 * walks from the root to a leaf and returns the tree node of the bound (0 if it is past the end).
+			*/
+			template < bool Upper, typename Key >
+			std::size_t descend( const Key& key, const Compare& comp )const
+			{
+				const K* tree = m_tree.data();
+				std::size_t n = m_tree.size() - 1;
+				// Uma linha de cache guarda os descendentes de k alguns níveis abaixo: buscá-la antes de precisar.
+				constexpr std::size_t per_line = ( sizeof(K) < 64 ) ? 64 / sizeof(K) : 1;
+				std::size_t k = 1;
+				while( k <= n )
+				{
+#if defined(__GNUC__)
+					__builtin_prefetch( tree + k * per_line );
+#endif
+					bool right = Upper ? !comp( key, tree[k] ) : comp( tree[k], key );
+					k = 2 * k + right;
+				}
+				// Desfazer as descidas à direita do fim do caminho: k vira o último nó em que desceu à esquerda.
+				return k >> ( trailing_ones( k ) + 1 );
+			}
+
+			/// in-order walk of the implicit tree, handing out the sorted keys one by one.
+			void fill( const K* sorted, std::size_t n, std::size_t k, std::size_t& next )
+			{
+				if( k > n )
+					return;
+				fill( sorted, n, 2 * k, next );
+				m_tree[k] = sorted[next];
+				m_rank[k] = static_cast<std::uint32_t>( next++ );
+				fill( sorted, n, 2 * k + 1, next );
+			}
+
+			static unsigned trailing_ones( std::size_t k )
+			{
+#if defined(__GNUC__)
+				return static_cast<unsigned>( __builtin_ctzll( ~static_cast<unsigned long long>( k ) ) );
+#else
+				unsigned count = 0;
+				for( ; k & 1; k >>= 1 )
+					count++;
+				return count;
+#endif
+			}
+	};
+}// namespace detail
+
+/**
+ * Sorted set of unique keys stored contiguously in a sc::vector. Lookups are binary searches over one
+ * array (see sorted_search / eytzinger_search), iteration is a linear scan, and the memory overhead is
+ * the vector's spare capacity.
+ *
+ * A single insert or erase shifts the elements after the position (O(n)). To add many keys, use the bulk
+ * insert( first, last ): the new keys are appended, sorted and merged with the old ones in
+ * O(n + m log m), instead of m shifts of O(n) each.
+ *
+ * Iterators are read-only and, like sc::vector's, are invalidated by any insertion or erase.
+*/
+template< typename K, typename Compare = std::less<K>, typename Allocator = std::allocator<K>, typename Search = sc::sorted_search >
+class flat_set{
+	public:
+		typedef K key_type;
+		typedef K value_type;
+		typedef Compare key_compare;
+		typedef Compare value_compare;
+		typedef Allocator allocator_type;
+		typedef std::size_t size_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef const K& reference;
+		typedef const K& const_reference;
+		typedef sc::const_iterator<K> const_iterator;
+		typedef const_iterator iterator; //!< Keys cannot be modified in place.
+		typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+		typedef const_reverse_iterator reverse_iterator;
+		typedef sc::vector<K, Allocator> container_type;
+
+	private:
+		container_type m_keys; //!< Sorted keys, no two equivalent.
+		Compare m_comp;
+		detail::search_index<K, Compare, Allocator, Search> m_index;
+
+		/// true if a and b, in this order in the sorted array, are equivalent.
+		bool same( const K& a, const K& b )const { return !m_comp( a, b ); }
+
+	public:
+		//=== [I] SPECIAL MEMBERS
+
+		/**
+		 * Constructs an empty set.
+		*/
+		explicit flat_set( const Compare& comp = Compare(), const Allocator& alloc = Allocator() ):
+			m_keys( alloc ), m_comp( comp ), m_index( alloc )
+		{ /* empty */ }
+
+		/**
+		 * Constructs the set with the keys of [first, last), in any order; of equivalent keys the first one is kept.
+		*/
+		template< typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category >
+		flat_set( InputIt first, InputIt last, const Compare& comp = Compare(), const Allocator& alloc = Allocator() ):
+			flat_set( comp, alloc )
+		{ insert( first, last ); }
+
+		/**
+		 * Constructs the set with the keys of ilist.
+		*/
+		flat_set( std::initializer_list<K> ilist, const Compare& comp = Compare(), const Allocator& alloc = Allocator() ):
+			flat_set( ilist.begin(), ilist.end(), comp, alloc )
+		{ /* empty */ }
+
+		/**
+		 * Takes over the storage of keys (in any order), which is then sorted and cleared of duplicates.
+		*/
+		explicit flat_set( container_type&& keys, const Compare& comp = Compare() ):
+			m_keys( std::move( keys ) ), m_comp( comp ), m_index( m_keys.get_allocator() )
+		{
+			std::stable_sort( m_keys.data(), m_keys.data() + m_keys.size(), m_comp );
+			drop_duplicates();
+			m_index.rebuild( m_keys.data(), m_keys.size() );
+		}
+
+		flat_set( const flat_set& ) = default;
+		flat_set( flat_set&& ) = default;
+		flat_set& operator=( const flat_set& ) = default;
+		flat_set& operator=( flat_set&& ) = default;
+
+		/**
+		 *Replaces the contents with the keys of ilist.
+		*/
+		flat_set& operator=( std::initializer_list<K> ilist )
+		{
+			clear();
+			insert( ilist );
+			return *this;
+		}
+
+		allocator_type get_allocator( void )const { return m_keys.get_allocator(); }
+		key_compare key_comp( void )const { return m_comp; }
+		value_compare value_comp( void )const { return m_comp; }
+
+		//=== [II] ITERATORS
+
+		const_iterator begin( void )const { return m_keys.cbegin(); }
+		const_iterator end( void )const { return m_keys.cend(); }
+		const_iterator cbegin( void )const { return m_keys.cbegin(); }
+		const_iterator cend( void )const { return m_keys.cend(); }
+		const_reverse_iterator rbegin( void )const { return const_reverse_iterator( end() ); }
+		const_reverse_iterator rend( void )const { return const_reverse_iterator( begin() ); }
+
+		//=== [III] Capacity
+
+		size_t size( void )const { return m_keys.size(); }
+		size_t capacity( void )const { return m_keys.capacity(); }
+		bool empty( void )const { return m_keys.empty(); }
+
+		/**
+		 * makes room for new_cap keys, so that inserting up to that many does not reallocate.
+		*/
+		void reserve( size_t new_cap ) { m_keys.reserve( new_cap ); }
+
+		void shrink_to_fit( void ) { m_keys.shrink_to_fit(); }
+
+		//=== [IV] Modifiers
+
+		void clear( void )
+		{
+			m_keys.clear();
+			m_index.clear();
+		}
+
+		/**
+		 * inserts key if no equivalent key is present (O(n): the keys after it are shifted).
+		 * @return the position of the key in the set and whether it was inserted.
+		*/
+		std::pair<iterator, bool> insert( const K& key )
+		{ return insert_one( key ); }
+
+		std::pair<iterator, bool> insert( K&& key )
+		{ return insert_one( std::move( key ) ); }
+
+		/**
+		 * constructs a key from args and inserts it as insert( key ) does.
+		*/
+		template< typename... Args >
+		std::pair<iterator, bool> emplace( Args&&... args )
+		{ return insert_one( K( std::forward<Args>(args)... ) ); }
+
+		/**
+		 * inserts the keys of [first, last), in any order, in O(n + m log m): they are copied into a
+		 * separate list and sorted, then appended and merged with the current keys. Keys already present,
+		 * and repeated ones in the range after the first, are dropped. If copying a key throws, the set
+		 * is unchanged.
+		*/
+		template< typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category >
+		void insert( InputIt first, InputIt last )
+		{
+			// Lote separado: uma cópia que lança não deixa chaves fora de ordem na lista.
+			container_type batch( 0, m_keys.get_allocator() );
+			for( ; first != last; ++first )
+				batch.emplace_back( *first );
+			if( batch.empty() )
+				return;
+			std::stable_sort( batch.data(), batch.data() + batch.size(), m_comp );
+			size_t old = m_keys.size();
+			m_keys.insert( m_keys.cend(), std::make_move_iterator( batch.begin() ), std::make_move_iterator( batch.end() ) );
+			K* data = m_keys.data();
+			// Intercalação estável: entre chaves equivalentes a antiga vem antes e é a que fica.
+			if( old != 0 && m_comp( data[old], data[old - 1] ) )
+				std::inplace_merge( data, data + old, data + m_keys.size(), m_comp );
+			drop_duplicates();
+			m_index.rebuild( m_keys.data(), m_keys.size() );
+		}
+
+		void insert( std::initializer_list<K> ilist )
+		{ insert( ilist.begin(), ilist.end() ); }
+
+		/**
+		 * removes the key equivalent to key, if any.
+		 * @return the number of keys removed (0 or 1).
+		*/
+		size_t erase( const K& key )
+		{
+			const_iterator pos = find( key );
+			if( pos == end() )
+				return 0;
+			erase( pos );
+			return 1;
+		}
+
+		/**
+		 * removes the key at pos.
+		 * @return iterator following the removed key.
+		*/
+		iterator erase( const_iterator pos )
+		{
+			m_index.clear();
+			return m_keys.erase( pos );
+		}
+
+		/**
+		 * removes the keys in [first, last).
+		*/
+		iterator erase( const_iterator first, const_iterator last )
+		{
+			m_index.clear();
+			return m_keys.erase( first, last );
+		}
+
+		/**
+		 * rebuilds the search index after single-element modifications (see eytzinger_search); does
+		 * nothing with sorted_search.
+		*/
+		void build_index( void )
+		{ m_index.rebuild( m_keys.data(), m_keys.size() ); }
+
+		void swap( flat_set& other ) noexcept
+		{
+			using std::swap;
+			m_keys.swap( other.m_keys );
+			swap( m_comp, other.m_comp );
+			swap( m_index, other.m_index );
+		}
+
+		//=== [V] Lookup
+
+		/**
+		 * returns an iterator to the first key not less than key.
+		*/
+		const_iterator lower_bound( const K& key )const
+		{ return begin() + bound<false>( key ); }
+
+		/**
+		 * returns an iterator to the first key greater than key.
+		*/
+		const_iterator upper_bound( const K& key )const
+		{ return begin() + bound<true>( key ); }
+
+		/**
+		 * returns the range of keys equivalent to key (empty or one key).
+		*/
+		std::pair<const_iterator, const_iterator> equal_range( const K& key )const
+		{
+			const_iterator pos = find( key );
+			return { pos, ( pos == end() ) ? pos : pos + 1 };
+		}
+
+		/**
+		 * returns an iterator to the key equivalent to key, or end().
+		*/
+		const_iterator find( const K& key )const
+		{
+			if( m_index.valid() )
+				return begin() + m_index.find( key, m_comp );
+			size_t idx = bound<false>( key );
+			return ( idx != size() && !m_comp( key, m_keys[idx] ) ) ? begin() + idx : end();
+		}
+
+		bool contains( const K& key )const { return find( key ) != end(); }
+		size_t count( const K& key )const { return contains( key ) ? 1 : 0; }
+
+		//=== [VI] Element access
+
+		/**
+		 * returns the sorted keys.
+		*/
+		const container_type& keys( void )const { return m_keys; }
+		const K* data( void )const { return m_keys.data(); }
+
+		/**
+		 * Checks if the contents of lhs and rhs are equal.
+		*/
+		friend bool operator==( const flat_set& lhs, const flat_set& rhs )
+		{ return lhs.m_keys == rhs.m_keys; }
+
+		friend bool operator!=( const flat_set& lhs, const flat_set& rhs )
+		{ return !( lhs == rhs ); }
+
+		friend void swap( flat_set& A, flat_set& B ) noexcept
+		{ A.swap( B ); }
+
+	private:
+		template< bool Upper >
+		size_t bound( const K& key )const
+		{
+			if( m_index.valid() )
+				return m_index.template bound<Upper>( key, m_comp );
+			return detail::branchless_bound<Upper>( m_keys.data(), m_keys.size(), key, m_comp );
+		}
+
+		template< typename Key >
+		std::pair<iterator, bool> insert_one( Key&& key )
+		{
+			size_t idx = bound<false>( key );
+			if( idx != size() && !m_comp( key, m_keys[idx] ) )
+				return { begin() + idx, false };
+			m_index.clear();
+			m_keys.insert( m_keys.cbegin() + idx, std::forward<Key>( key ) );
+			return { begin() + idx, true };
+		}
+
+		/// removes every key equivalent to the one before it (the keys are sorted).
+		void drop_duplicates( void )
+		{
+			K* data = m_keys.data();
+			K* last = std::unique( data, data + m_keys.size(), [this]( const K& a, const K& b ){ return same( a, b ); } );
+			m_keys.erase( m_keys.cbegin() + ( last - data ), m_keys.cend() );
+		}
+};
+}// namespace sc
+#endif
@@ -0,0 +1,45 @@
+#ifndef GROWTH_POLICY_H
+#define GROWTH_POLICY_H
+#include <cstddef>
+#include <algorithm> // std::max
+
+namespace sc{
+	/**
+	 * Growth policies decide the capacity of sc::vector when it must grow. A policy is any type with
+	 *
+	 *     static std::size_t next_capacity( std::size_t current, std::size_t required );
+	 *
+	 * returning a capacity >= required, where current is the capacity being outgrown. Users may pass
+	 * their own policy as the third template argument of sc::vector; it must be constexpr for the list
+	 * to grow inside constant expressions.
+	*/
+
+	/**
+	 * Doubles the capacity (the default). Amortized O(1) append; a reallocation needs up to 3x the live data.
+	*/
+	struct doubling_growth{
+		static constexpr std::size_t next_capacity( std::size_t current, std::size_t required )
+		{ return std::max( required, ( current == 0 ) ? std::size_t( 1 ) : 2 * current ); }
+	};
+
+	/**
+	 * Grows by half of the current capacity. Still amortized O(1) append, with at most 2.5x the live
+	 * data during a reallocation and at most 1/3 of the block unused afterwards.
+	*/
+	struct half_growth{
+		static constexpr std::size_t next_capacity( std::size_t current, std::size_t required )
+		{ return std::max( required, current + current / 2 + 1 ); }
+	};
+
+	/**
+	 * Grows by a fixed number of elements. Caps the unused memory at Chunk elements, but append is only
+	 * amortized O(1) when the buffer can grow in place (see sc::realloc_allocator).
+	*/
+	template < std::size_t Chunk >
+	struct chunk_growth{
+		static_assert( Chunk > 0, "sc::chunk_growth needs a positive chunk size" );
+		static constexpr std::size_t next_capacity( std::size_t current, std::size_t required )
+		{ return std::max( required, current + Chunk ); }
+	};
+}// namespace
+#endif
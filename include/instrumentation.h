@@ -0,0 +1,425 @@
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+#include <algorithm> // std::max
+#include <atomic>
+#include <cstddef>
+#include <functional> // std::function
+#include <map>
+#include <memory> // std::unique_ptr, std::shared_ptr
+#include <mutex>
+#include <ostream>
+#include <string>
+
+/**
+ * Instrumentation policies observe what sc::vector does with its memory. A policy is the fourth
+ * template argument of sc::vector and is any type with
+ *
+ *     static constexpr bool enabled;
+ *     void on_growth( const sc::growth_event& e );  // a block was allocated or resized
+ *     void on_shift( std::size_t elements );         // elements moved inside the block (insert/erase)
+ *     void on_copy( std::size_t bytes );             // elements copied from another list
+ *     void on_release( std::size_t size, std::size_t capacity, std::size_t element_size ); // destructor
+ *
+ * When enabled is false sc::vector does not call (or compute the arguments of) any hook, and the
+ * policy, being empty, takes no room in the list: sc::no_instrumentation, the default, costs nothing.
+ * sc::instrumented counts per list and per call-site tag:
+ *
+ *     sc::vector<int, std::allocator<int>, sc::doubling_growth, sc::instrumented> v;
+ *     v.instrumentation().tag( SC_CALL_SITE );
+ *     ...
+ *     sc::instrument_registry::global().write_json( std::cerr );
+*/
+
+#define SC_INSTRUMENT_STR2( x ) #x
+#define SC_INSTRUMENT_STR( x ) SC_INSTRUMENT_STR2( x )
+/// Tag naming the current source line ("file.cpp:42"), for sc::instrumented::tag().
+#define SC_CALL_SITE ( __FILE__ ":" SC_INSTRUMENT_STR( __LINE__ ) )
+
+namespace sc{
+	/// Operation that made a list get a new (or resized) block.
+	enum class growth_cause{
+		construct, //!< Constructor with a size, a range or an initializer list.
+		copy, //!< Copy constructor or copy assignment.
+		assign, //!< assign() or move assignment between different allocators.
+		reserve, //!< Explicit reserve().
+		append, //!< push_back, emplace_back or insertion at end().
+		insert, //!< Insertion before end() (including push_front).
+		shrink //!< shrink_to_fit().
+	};
+
+	/**
+	 * returns the name of cause, as used in the JSON output.
+	*/
+	inline const char* to_string( growth_cause cause )
+	{
+		switch( cause )
+		{
+			case growth_cause::construct: return "construct";
+			case growth_cause::copy: return "copy";
+			case growth_cause::assign: return "assign";
+			case growth_cause::reserve: return "reserve";
+			case growth_cause::append: return "append";
+			case growth_cause::insert: return "insert";
+			case growth_cause::shrink: return "shrink";
+		}
+		return "unknown";
+	}
+
+	/// One allocation or resize of the block of a list.
+	struct growth_event{
+		growth_cause cause;
+		std::size_t element_size; //!< sizeof( T ).
+		std::size_t size; //!< Elements the list held when its block changed.
+		std::size_t old_capacity; //!< Capacity before, in elements (0 for the first block).
+		std::size_t new_capacity; //!< Capacity after, in elements.
+		std::size_t bytes_moved; //!< Bytes relocated from the old block (0 when resized in place).
+		bool in_place; //!< The allocator resized the block itself (see sc::realloc_allocator).
+		const char* tag; //!< Call-site tag of the list (filled in by sc::instrumented).
+	};
+
+	/// Counters kept by sc::instrumented for one list.
+	struct vector_stats{
+		std::size_t allocations = 0; //!< Blocks obtained, counting in-place resizes.
+		std::size_t reallocations = 0; //!< Allocations that replaced a non-empty block.
+		std::size_t bytes_allocated = 0; //!< Sum of the sizes of the blocks obtained (growth only for in-place resizes).
+		std::size_t bytes_moved = 0; //!< Bytes relocated from an old block to a new one.
+		std::size_t bytes_copied = 0; //!< Bytes copied from other lists (copy constructor and assignment).
+		std::size_t elements_shifted = 0; //!< Elements moved inside the block by insert, erase and push_front.
+		std::size_t peak_capacity = 0; //!< Largest capacity reached, in bytes.
+		/// Growths by append or insert after an explicit reserve(): the reserve was too small.
+		std::size_t outgrown_reserves = 0;
+		/// Capacity the list still had unused when destroyed, in bytes: the reserve was too large.
+		std::size_t unused_bytes = 0;
+	};
+
+namespace detail{
+	inline void write_json_string( std::ostream& os, const char* s )
+	{
+		static const char hex[] = "0123456789abcdef";
+		os << '"';
+		for( ; *s != '\0'; ++s )
+		{
+			unsigned char c = static_cast<unsigned char>( *s );
+			if( c == '"' || c == '\\' )
+				os << '\\' << *s;
+			else if( c < 0x20 )
+				os << "\\u00" << hex[c >> 4] << hex[c & 15];
+			else
+				os << *s;
+		}
+		os << '"';
+	}
+
+	/// Writes the fields of a vector_stats (no braces).
+	inline void write_json_fields( std::ostream& os, const vector_stats& s )
+	{
+		os << "\"allocations\": " << s.allocations
+		   << ", \"reallocations\": " << s.reallocations
+		   << ", \"bytes_allocated\": " << s.bytes_allocated
+		   << ", \"bytes_moved\": " << s.bytes_moved
+		   << ", \"bytes_copied\": " << s.bytes_copied
+		   << ", \"elements_shifted\": " << s.elements_shifted
+		   << ", \"peak_capacity\": " << s.peak_capacity
+		   << ", \"outgrown_reserves\": " << s.outgrown_reserves
+		   << ", \"unused_bytes\": " << s.unused_bytes;
+	}
+
+	inline void atomic_max( std::atomic<std::size_t>& target, std::size_t value )
+	{
+		std::size_t cur = target.load( std::memory_order_relaxed );
+		while( cur < value && !target.compare_exchange_weak( cur, value, std::memory_order_relaxed ) )
+		{ /* cur recarregado pela falha */ }
+	}
+}// namespace detail
+
+	/**
+	 * writes s as one JSON object.
+	*/
+	inline void write_json( std::ostream& os, const vector_stats& s )
+	{
+		os << "{ ";
+		detail::write_json_fields( os, s );
+		os << " }";
+	}
+
+	/**
+	 * Process-wide totals of the sc::instrumented lists, one record per call-site tag, plus an optional
+	 * hook called on every growth event. All members are thread-safe.
+	*/
+	class instrument_registry{
+		public:
+			typedef std::function<void( const growth_event& )> hook_type;
+
+			/// Totals of the lists sharing one tag. Updated with relaxed atomics by the lists themselves.
+			struct record{
+				std::string tag;
+				std::atomic<std::size_t> instances{ 0 }; //!< Lists created with (or later tagged with) this tag.
+				std::atomic<std::size_t> allocations{ 0 };
+				std::atomic<std::size_t> reallocations{ 0 };
+				std::atomic<std::size_t> bytes_allocated{ 0 };
+				std::atomic<std::size_t> bytes_moved{ 0 };
+				std::atomic<std::size_t> bytes_copied{ 0 };
+				std::atomic<std::size_t> elements_shifted{ 0 };
+				std::atomic<std::size_t> peak_capacity{ 0 }; //!< Largest capacity of any one list, in bytes.
+				std::atomic<std::size_t> outgrown_reserves{ 0 };
+				std::atomic<std::size_t> unused_bytes{ 0 };
+
+				/**
+				 * returns a consistent-enough copy of the counters (each one is read atomically).
+				*/
+				vector_stats snapshot( void )const
+				{
+					vector_stats s;
+					s.allocations = allocations.load( std::memory_order_relaxed );
+					s.reallocations = reallocations.load( std::memory_order_relaxed );
+					s.bytes_allocated = bytes_allocated.load( std::memory_order_relaxed );
+					s.bytes_moved = bytes_moved.load( std::memory_order_relaxed );
+					s.bytes_copied = bytes_copied.load( std::memory_order_relaxed );
+					s.elements_shifted = elements_shifted.load( std::memory_order_relaxed );
+					s.peak_capacity = peak_capacity.load( std::memory_order_relaxed );
+					s.outgrown_reserves = outgrown_reserves.load( std::memory_order_relaxed );
+					s.unused_bytes = unused_bytes.load( std::memory_order_relaxed );
+					return s;
+				}
+			};
+
+			/**
+			 * the registry used by sc::instrumented.
+			*/
+			static instrument_registry& global( void )
+			{
+				static instrument_registry registry;
+				return registry;
+			}
+
+			/**
+			 * returns the record of tag, creating it on first use. The record lives as long as the registry.
+			*/
+			record& find( const char* tag )
+			{
+				std::lock_guard<std::mutex> lock( m_lock );
+				std::unique_ptr<record>& r = m_records[tag];
+				if( !r )
+				{
+					r.reset( new record );
+					r->tag = tag;
+				}
+				return *r;
+			}
+
+			/**
+			 * installs hook, called (from the thread of the list) for every growth event of every
+			 * sc::instrumented list; an empty hook removes it. The hook must not install another hook.
+			*/
+			void set_hook( hook_type hook )
+			{
+				std::shared_ptr<const hook_type> next;
+				if( hook )
+					next = std::make_shared<const hook_type>( std::move( hook ) );
+				std::lock_guard<std::mutex> lock( m_lock );
+				m_hook = std::move( next );
+				m_has_hook.store( m_hook != nullptr, std::memory_order_release );
+			}
+
+			/**
+			 * calls the hook, if any, with e.
+			*/
+			void notify( const growth_event& e )
+			{
+				if( !m_has_hook.load( std::memory_order_acquire ) ) return;
+				std::shared_ptr<const hook_type> hook;
+				{
+					std::lock_guard<std::mutex> lock( m_lock );
+					hook = m_hook;
+				}
+				if( hook )
+					( *hook )( e );
+			}
+
+			/**
+			 * writes every record as JSON, sorted by tag:
+			 * { "vectors": [ { "tag": "...", "instances": n, "allocations": n, ... }, ... ] }
+			*/
+			void write_json( std::ostream& os )
+			{
+				std::lock_guard<std::mutex> lock( m_lock );
+				os << "{ \"vectors\": [";
+				const char* sep = "\n  ";
+				for( const auto& entry : m_records )
+				{
+					const record& r = *entry.second;
+					os << sep << "{ \"tag\": ";
+					detail::write_json_string( os, r.tag.c_str() );
+					os << ", \"instances\": " << r.instances.load( std::memory_order_relaxed ) << ", ";
+					detail::write_json_fields( os, r.snapshot() );
+					os << " }";
+					sep = ",\n  ";
+				}
+				os << "\n] }\n";
+			}
+
+			/**
+			 * zeroes the counters of every record except instances (the records stay valid).
+			*/
+			void reset( void )
+			{
+				std::lock_guard<std::mutex> lock( m_lock );
+				for( auto& entry : m_records )
+				{
+					record& r = *entry.second;
+					for( std::atomic<std::size_t>* c : { &r.allocations, &r.reallocations, &r.bytes_allocated,
+					                                     &r.bytes_moved, &r.bytes_copied, &r.elements_shifted,
+					                                     &r.peak_capacity, &r.outgrown_reserves, &r.unused_bytes } )
+						c->store( 0, std::memory_order_relaxed );
+				}
+			}
+
+		private:
+			std::mutex m_lock;
+			std::map< std::string, std::unique_ptr<record> > m_records;
+			std::shared_ptr<const hook_type> m_hook;
+			std::atomic<bool> m_has_hook{ false };
+	};
+
+	/**
+	 * The default policy: observes nothing and takes no room.
+	*/
+	struct no_instrumentation{
+		static constexpr bool enabled = false;
+		void on_growth( const growth_event& ) { }
+		void on_shift( std::size_t ) { }
+		void on_copy( std::size_t ) { }
+		void on_release( std::size_t, std::size_t, std::size_t ) { }
+	};
+
+	/**
+	 * Counting policy: keeps a vector_stats for its list and adds every event to the record of the
+	 * list's tag in instrument_registry::global() ("untagged" until tag() is called). Counting costs a few
+	 * relaxed atomic additions per growth, shift or copy; growth events also reach the registry hook.
+	 *
+	 * The counters belong to the list object, not to its elements: moving or swapping lists does not
+	 * move them, and a list constructed from another starts with the other's tag and zeroed counters.
+	*/
+	class instrumented{
+		public:
+			static constexpr bool enabled = true;
+
+			instrumented( void ):
+				m_record{ &untagged() }
+			{ m_record->instances.fetch_add( 1, std::memory_order_relaxed ); }
+
+			instrumented( const instrumented& other ):
+				m_record{ other.m_record }
+			{ m_record->instances.fetch_add( 1, std::memory_order_relaxed ); }
+
+			/// Assignment keeps the tag and counters of the target.
+			instrumented& operator=( const instrumented& )
+			{ return *this; }
+
+			/**
+			 * moves this list to the record of tag (e.g. SC_CALL_SITE). Its counters so far are moved too.
+			*/
+			void tag( const char* tag )
+			{
+				instrument_registry::record& next = instrument_registry::global().find( tag );
+				if( &next == m_record ) return;
+				add( *m_record, m_stats, -1 );
+				add( next, m_stats, +1 );
+				m_record = &next;
+			}
+
+			/**
+			 * returns the tag of this list.
+			*/
+			const char* tag( void )const
+			{ return m_record->tag.c_str(); }
+
+			/**
+			 * returns the counters of this list.
+			*/
+			const vector_stats& stats( void )const
+			{ return m_stats; }
+
+			void on_growth( const growth_event& e )
+			{
+				std::size_t bytes = ( e.in_place ? e.new_capacity - std::min( e.new_capacity, e.old_capacity )
+				                                 : e.new_capacity ) * e.element_size;
+				std::size_t capacity = e.new_capacity * e.element_size;
+				bool outgrown = m_reserved && ( e.cause == growth_cause::append || e.cause == growth_cause::insert );
+				m_reserved = ( e.cause == growth_cause::reserve );
+
+				m_stats.allocations++;
+				m_stats.reallocations += ( e.old_capacity != 0 );
+				m_stats.bytes_allocated += bytes;
+				m_stats.bytes_moved += e.bytes_moved;
+				m_stats.peak_capacity = std::max( m_stats.peak_capacity, capacity );
+				m_stats.outgrown_reserves += outgrown;
+
+				m_record->allocations.fetch_add( 1, std::memory_order_relaxed );
+				if( e.old_capacity != 0 )
+					m_record->reallocations.fetch_add( 1, std::memory_order_relaxed );
+				m_record->bytes_allocated.fetch_add( bytes, std::memory_order_relaxed );
+				m_record->bytes_moved.fetch_add( e.bytes_moved, std::memory_order_relaxed );
+				detail::atomic_max( m_record->peak_capacity, capacity );
+				if( outgrown )
+					m_record->outgrown_reserves.fetch_add( 1, std::memory_order_relaxed );
+
+				growth_event tagged = e;
+				tagged.tag = tag();
+				instrument_registry::global().notify( tagged );
+			}
+
+			void on_shift( std::size_t elements )
+			{
+				m_stats.elements_shifted += elements;
+				m_record->elements_shifted.fetch_add( elements, std::memory_order_relaxed );
+			}
+
+			void on_copy( std::size_t bytes )
+			{
+				m_stats.bytes_copied += bytes;
+				m_record->bytes_copied.fetch_add( bytes, std::memory_order_relaxed );
+			}
+
+			void on_release( std::size_t size, std::size_t capacity, std::size_t element_size )
+			{
+				std::size_t unused = ( capacity - size ) * element_size;
+				m_stats.unused_bytes += unused;
+				m_record->unused_bytes.fetch_add( unused, std::memory_order_relaxed );
+			}
+
+		private:
+			vector_stats m_stats;
+			instrument_registry::record* m_record; //!< Record of the tag (owned by the registry).
+			bool m_reserved = false; //!< The last growth came from reserve().
+
+			static instrument_registry::record& untagged( void )
+			{
+				static instrument_registry::record& r = instrument_registry::global().find( "untagged" );
+				return r;
+			}
+
+			/**
+			 * adds (sign = +1) or subtracts (sign = -1) the counters s to or from r. The peak is only raised.
+			*/
+			static void add( instrument_registry::record& r, const vector_stats& s, int sign )
+			{
+				auto apply = [sign]( std::atomic<std::size_t>& c, std::size_t v ) {
+					if( sign > 0 ) c.fetch_add( v, std::memory_order_relaxed );
+					else c.fetch_sub( v, std::memory_order_relaxed );
+				};
+				apply( r.instances, 1 );
+				apply( r.allocations, s.allocations );
+				apply( r.reallocations, s.reallocations );
+				apply( r.bytes_allocated, s.bytes_allocated );
+				apply( r.bytes_moved, s.bytes_moved );
+				apply( r.bytes_copied, s.bytes_copied );
+				apply( r.elements_shifted, s.elements_shifted );
+				apply( r.outgrown_reserves, s.outgrown_reserves );
+				apply( r.unused_bytes, s.unused_bytes );
+				if( sign > 0 )
+					detail::atomic_max( r.peak_capacity, s.peak_capacity );
+			}
+	};
+}// namespace sc
+#endif
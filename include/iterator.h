@@ -1,129 +1,193 @@
 #ifndef ITERATOR_H
 #define ITERATOR_H
 #include <iterator>
+#include <cstddef>
+#include <type_traits>
 
 namespace sc{
+	/**
+	 * Contiguous iterator over an array of T. sc::iterator<const T> (alias sc::const_iterator<T>)
+	 * is the read-only version, and a sc::iterator<T> converts implicitly to it.
+	*/
 	template < typename T >
-	class iterator{	
+	class iterator{
 		public:
 			typedef T* pointer;
- 			typedef T value_type; //!< Value type the iterator points to. 
+			typedef typename std::remove_cv<T>::type value_type; //!< Value type the iterator points to.
 			typedef T& reference; //!< Alias para uma referência.
-	      	typedef std::ptrdiff_t difference_type;
-	      	/// Identificar a categoria do iterador para algoritmos do STL.
-	  	   	typedef std::bidirectional_iterator_tag iterator_category;
-	  	private:
-	  		T* ptr;
-	  	public:
+			typedef std::ptrdiff_t difference_type;
+			/// Identificar a categoria do iterador para algoritmos do STL.
+			typedef std::random_access_iterator_tag iterator_category;
+#if __cplusplus >= 202002L
+			/// Elements are stored contiguously: std::to_address and the C++20 algorithms may use raw pointers.
+			typedef std::contiguous_iterator_tag iterator_concept;
+#endif
+		private:
+			T* ptr;
+		public:
 			/**
 			 *default constructor.
- 			*/
-	  		iterator( T* pt = nullptr ): ptr{ pt }
-	  		{ /* empty */ }
+			*/
+			constexpr iterator( T* pt = nullptr ): ptr{ pt }
+			{ /* empty */ }
+
+			/**
+			 * converts a mutable iterator into a constant one (only enabled for sc::iterator<const T>).
+			*/
+			template < typename U,
+			           typename = typename std::enable_if< std::is_const<T>::value && std::is_same< const U, T >::value >::type >
+			constexpr iterator( const iterator<U>& other ): ptr{ other.operator->() }
+			{ /* empty */ }
+
+			/**
+			 * advances iterator to the next location within the vector.
+			*/
+			constexpr iterator& operator++( void )
+			{
+				++ptr;
+				return *this;
+			}
 
 			/**
-			 * advances iterator to the next location within the vector. 
- 			*/
-	  		iterator operator++( void )
-	  		{
-	  			++ptr;
-	  			return *this;
-	  		}
+			 * advances iterator to the next location within the vector.
+			*/
+			constexpr iterator operator++( int )
+			{
+				iterator temp( ptr );
+				ptr++;
+				return temp;
+			}
 
 			/**
-			 * advances iterator to the next location within the vector. 
- 			*/
-	  		iterator operator++( int )
-	  		{
-	  			iterator temp( ptr );
-	  			ptr++;
-	  			return temp; 
-	  		}
+			 * retreat iterator to the previous location within the vector.
+			*/
+			constexpr iterator& operator--( void )
+			{
+				--ptr;
+				return *this;
+			}
 
 			/**
-			 * retreat iterator to the previous location within the vector. 
- 			*/
-	  		iterator operator--( void )
-	  		{
-	  			--ptr;
-	  			return *this;
-	  		}
+			 *retreat iterator to the previous location within the vector.
+			*/
+			constexpr iterator operator--( int )
+			{
+				iterator temp( ptr );
+				ptr--;
+				return temp;
+			}
 
 			/**
-			 *retreat iterator to the previous location within the vector. 
- 			*/
-	  		iterator operator--( int )
-	  		{
-	  			iterator temp( ptr );
-	  			ptr--;
-	  			return temp;
-	  		}
+			 * as in it += 2 : advances the iterator n locations within the vector.
+			*/
+			constexpr iterator& operator+=( difference_type n )
+			{
+				ptr += n;
+				return *this;
+			}
 
 			/**
-			 * as in it1 == it2 : returns true if both iterators refer to the same location within the vector, and false otherwise. 
- 			*/
-	  		bool operator==( const iterator &it )const
-	  		{ return this->ptr == it.ptr; }
+			 * as in it -= 2 : retreats the iterator n locations within the vector.
+			*/
+			constexpr iterator& operator-=( difference_type n )
+			{
+				ptr -= n;
+				return *this;
+			}
+
+			/**
+			 * as in it1 == it2 : returns true if both iterators refer to the same location within the vector, and false otherwise.
+			*/
+			friend constexpr bool operator==( const iterator &lhs, const iterator &rhs )
+			{ return lhs.ptr == rhs.ptr; }
 
 			/**
 			 * as in it1 != it2 : returns true if both iterators refer to a diﬀerent location within the vector, and false otherwise.
- 			*/
-	  		bool operator!=( const iterator &it )const
-	  		{ return this->ptr != it.ptr; }
+			*/
+			friend constexpr bool operator!=( const iterator &lhs, const iterator &rhs )
+			{ return lhs.ptr != rhs.ptr; }
+
+			/**
+			 * as in it1 < it2 : returns true if it1 refers to a location before it2.
+			*/
+			friend constexpr bool operator<( const iterator &lhs, const iterator &rhs )
+			{ return lhs.ptr < rhs.ptr; }
 
 			/**
-			 * as in it1-it2 : return the diﬀerence between two iterators. 
- 			*/
-	  		difference_type operator-( const iterator &rhs )
-	  		{ return ptr - rhs.ptr; }
+			 * as in it1 > it2 : returns true if it1 refers to a location after it2.
+			*/
+			friend constexpr bool operator>( const iterator &lhs, const iterator &rhs )
+			{ return lhs.ptr > rhs.ptr; }
+
+			/**
+			 * as in it1 <= it2 : returns true if it1 does not refer to a location after it2.
+			*/
+			friend constexpr bool operator<=( const iterator &lhs, const iterator &rhs )
+			{ return lhs.ptr <= rhs.ptr; }
+
+			/**
+			 * as in it1 >= it2 : returns true if it1 does not refer to a location before it2.
+			*/
+			friend constexpr bool operator>=( const iterator &lhs, const iterator &rhs )
+			{ return lhs.ptr >= rhs.ptr; }
+
+			/**
+			 * as in it1-it2 : return the diﬀerence between two iterators.
+			*/
+			friend constexpr difference_type operator-( const iterator &lhs, const iterator &rhs )
+			{ return lhs.ptr - rhs.ptr; }
 
 			/**
 			 * as in *it : return a reference to the object located at the position pointed by the iterator.The reference may be modiﬁable
- 			*/
-	  		reference operator*(void)
-	  		{ return *ptr;}
+			*/
+			constexpr reference operator*( void )const
+			{ return *ptr; }
 
 			/**
-			 *as in *it : return a reference to the object located at the position pointed by the iterator.The reference may be modiﬁable
- 			*/
-	  		const T& operator*( void )const
-	  		{ return *ptr; }
+			 * as in it[n] : return a reference to the object located n positions after the iterator.
+			*/
+			constexpr reference operator[]( difference_type n )const
+			{ return ptr[n]; }
 
 			/**
-			 * as in it->field : return a pointer to the location in the vector the it points to. 
- 			*/
- 			T* operator->( void ) const
- 			{ return ptr; }
+			 * as in it->field : return a pointer to the location in the vector the it points to.
+			*/
+			constexpr pointer operator->( void ) const
+			{ return ptr; }
 
 			/**
-			 * as in 2+it : return a iterator pointing to the n -th successor in the vector from it . 
- 			*/
-	  		friend sc::iterator<T> operator+( int n, sc::iterator<T> it )
-	  		{ 
-	  			it.ptr += n;
-	  			return it;
-	  		}
+			 * as in 2+it : return a iterator pointing to the n -th successor in the vector from it .
+			*/
+			friend constexpr iterator operator+( difference_type n, iterator it )
+			{
+				it.ptr += n;
+				return it;
+			}
 
 			/**
-			 *as in it+2 : return a iterator pointing to the n -th successor in the vector from it . 
- 			*/
-	  		friend sc::iterator<T> operator+( sc::iterator<T> it, int n )
-	  		{ return n + it; }
+			 *as in it+2 : return a iterator pointing to the n -th successor in the vector from it .
+			*/
+			friend constexpr iterator operator+( iterator it, difference_type n )
+			{ return n + it; }
 
 			/**
-			 *as in 2-it : return a iterator pointing to the n -th predecessor in the vector from it . 
- 			*/
-	  		friend sc::iterator<T> operator-( int n, sc::iterator<T> it )
-	  		{ 
-	  			it.ptr -= n;
-	  			return it;
-	  		}
+			 *as in 2-it : return a iterator pointing to the n -th predecessor in the vector from it .
+			*/
+			friend constexpr iterator operator-( difference_type n, iterator it )
+			{
+				it.ptr -= n;
+				return it;
+			}
 
 			/**
 			 * as in it-2 : return a iterator pointing to the n -th predecessor in the vector from it .
- 			*/
-	  		friend sc::iterator<T> operator-( sc::iterator<T> it, int n )
-	  		{ return n - it; }
+			*/
+			friend constexpr iterator operator-( iterator it, difference_type n )
+			{ return n - it; }
 	};
+
+	/// Read-only iterator: dereferencing it yields const T&.
+	template < typename T >
+	using const_iterator = iterator<const T>;
 }// namespace
-#endif
\ No newline at end of file
+#endif
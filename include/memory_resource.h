@@ -0,0 +1,379 @@
+#ifndef MEMORY_RESOURCE_H
+#define MEMORY_RESOURCE_H
+#include <cstddef>
+#include <cstdint> // std::uintptr_t
+#include <cstring> // std::memcpy
+#include <algorithm> // std::max, std::min
+#include <memory_resource>
+
+namespace sc{
+namespace pmr{
+	/**
+	 * A std::pmr::memory_resource that can sometimes grow or shrink a block where it is, without moving it.
+	 * sc::pmr::polymorphic_allocator asks for this before falling back to allocate + memcpy + deallocate.
+	*/
+	class extendable_resource : public std::pmr::memory_resource{
+		public:
+			/**
+			 * tries to resize the block p of old_bytes (obtained with the given alignment) to new_bytes in place.
+			 * @return true if the block now holds new_bytes; false if it was left untouched.
+			*/
+			bool try_extend( void* p, std::size_t old_bytes, std::size_t new_bytes, std::size_t alignment )
+			{ return do_try_extend( p, old_bytes, new_bytes, alignment ); }
+
+		private:
+			virtual bool do_try_extend( void* p, std::size_t old_bytes, std::size_t new_bytes, std::size_t alignment ) = 0;
+	};
+
+	/**
+	 * Bump-pointer arena. Allocation is a pointer increment; deallocate() is a no-op except for the most
+	 * recent block, which can also be extended in place while the current chunk has room (so a vector
+	 * that is the last thing allocated grows without copying). Chunks come from upstream, doubling in
+	 * size; release() returns them all at once. Not thread safe: use one arena per thread or per request.
+	*/
+	class arena_resource : public extendable_resource{
+		public:
+			/**
+			 * @param initial_size  size of the first chunk taken from upstream (later chunks double).
+			 * @param upstream      where chunks come from.
+			*/
+			explicit arena_resource( std::size_t initial_size = 4096,
+			                         std::pmr::memory_resource* upstream = std::pmr::get_default_resource() ):
+				m_upstream{ upstream },
+				m_initial_size{ std::max( initial_size, sizeof(chunk) + 64 ) },
+				m_next_size{ m_initial_size }
+			{ /* empty */ }
+
+			/**
+			 * uses buffer (not owned) as the first chunk, e.g. a stack array, before going upstream.
+			*/
+			arena_resource( void* buffer, std::size_t size,
+			                std::pmr::memory_resource* upstream = std::pmr::get_default_resource() ):
+				arena_resource( size, upstream )
+			{
+				m_buffer = static_cast<char*>( buffer );
+				m_buffer_size = size;
+				m_cur = m_buffer;
+				m_end = m_buffer + size;
+			}
+
+			arena_resource( const arena_resource& ) = delete;
+			arena_resource& operator=( const arena_resource& ) = delete;
+
+			~arena_resource()
+			{ release(); }
+
+			/**
+			 * frees every block at once, returning all chunks to upstream.
+			*/
+			void release( void )
+			{
+				while( m_chunks != nullptr )
+				{
+					chunk* prev = m_chunks->prev;
+					m_upstream->deallocate( m_chunks, m_chunks->size, alignof(std::max_align_t) );
+					m_chunks = prev;
+				}
+				m_cur = m_buffer;
+				m_end = m_buffer + m_buffer_size;
+				m_last = nullptr;
+				m_next_size = m_initial_size;
+			}
+
+			/**
+			 * frees every block at once but keeps the newest (largest) chunk for the next round, so an arena
+			 * reused request after request stops calling upstream once it has reached its working size.
+			*/
+			void reset( void )
+			{
+				if( m_chunks == nullptr )
+				{
+					release();
+					return;
+				}
+				chunk* keep = m_chunks;
+				m_chunks = keep->prev;
+				std::size_t next_size = m_next_size;
+				release();
+				keep->prev = nullptr;
+				m_chunks = keep;
+				m_cur = reinterpret_cast<char*>( keep ) + sizeof(chunk);
+				m_end = reinterpret_cast<char*>( keep ) + keep->size;
+				m_next_size = next_size;
+			}
+
+			std::pmr::memory_resource* upstream_resource( void ) const
+			{ return m_upstream; }
+
+		private:
+			/// Header at the start of every chunk taken from upstream.
+			struct alignas(std::max_align_t) chunk{
+				chunk* prev;
+				std::size_t size;
+			};
+
+			std::pmr::memory_resource* m_upstream;
+			std::size_t m_initial_size;
+			std::size_t m_next_size; //!< Size of the next chunk.
+			chunk* m_chunks = nullptr; //!< Newest chunk; each one points to the previous.
+			char* m_buffer = nullptr; //!< User supplied first chunk (not owned).
+			std::size_t m_buffer_size = 0;
+			char* m_cur = nullptr; //!< First free byte of the current chunk.
+			char* m_end = nullptr; //!< End of the current chunk.
+			char* m_last = nullptr; //!< Most recent block: the only one that can grow or be given back.
+
+			static char* align_up( char* p, std::size_t alignment )
+			{
+				std::uintptr_t v = reinterpret_cast<std::uintptr_t>( p );
+				return p + ( ( alignment - v % alignment ) % alignment );
+			}
+
+			void* do_allocate( std::size_t bytes, std::size_t alignment ) override
+			{
+				char* p = align_up( m_cur, alignment );
+				if( m_cur == nullptr || p > m_end || static_cast<std::size_t>( m_end - p ) < bytes )
+				{
+					std::size_t size = std::max( m_next_size, sizeof(chunk) + bytes + alignment );
+					chunk* c = static_cast<chunk*>( m_upstream->allocate( size, alignof(std::max_align_t) ) );
+					c->prev = m_chunks;
+					c->size = size;
+					m_chunks = c;
+					m_next_size = size * 2;
+					m_cur = reinterpret_cast<char*>( c ) + sizeof(chunk);
+					m_end = reinterpret_cast<char*>( c ) + size;
+					p = align_up( m_cur, alignment );
+				}
+				m_last = p;
+				m_cur = p + bytes;
+				return p;
+			}
+
+			void do_deallocate( void* p, std::size_t bytes, std::size_t ) override
+			{
+				// Só o último bloco volta para a arena; o resto espera release().
+				if( p == m_last && static_cast<char*>( p ) + bytes == m_cur )
+				{
+					m_cur = m_last;
+					m_last = nullptr;
+				}
+			}
+
+			bool do_try_extend( void* p, std::size_t old_bytes, std::size_t new_bytes, std::size_t ) override
+			{
+				char* q = static_cast<char*>( p );
+				if( q != m_last || q + old_bytes != m_cur || new_bytes > static_cast<std::size_t>( m_end - q ) )
+					return false;
+				m_cur = q + new_bytes;
+				return true;
+			}
+
+			bool do_is_equal( const std::pmr::memory_resource& other ) const noexcept override
+			{ return this == &other; }
+	};
+
+	/**
+	 * Pool of fixed-size blocks in power-of-two size classes (16 bytes up to max_block). Each class carves
+	 * blocks out of chunks taken from upstream and recycles freed blocks through a free list, so
+	 * allocation and deallocation are O(1) and blocks are reused across requests. Larger requests go
+	 * straight to upstream. A block can grow in place while the new size stays in the same class.
+	 * release() returns every chunk to upstream. Not thread safe.
+	*/
+	class pool_resource : public extendable_resource{
+		public:
+			/**
+			 * @param max_block    largest size (bytes, rounded up to a power of two) served from the pools.
+			 * @param chunk_bytes  minimum size of each chunk taken from upstream.
+			 * @param upstream     where chunks and large blocks come from.
+			*/
+			explicit pool_resource( std::size_t max_block = 4096, std::size_t chunk_bytes = 64 * 1024,
+			                        std::pmr::memory_resource* upstream = std::pmr::new_delete_resource() ):
+				m_upstream{ upstream },
+				m_max_block{ std::min( round_up( max_block ), std::size_t( 1 ) << ( min_shift + num_classes - 1 ) ) },
+				m_chunk_bytes{ chunk_bytes }
+			{ /* empty */ }
+
+			pool_resource( const pool_resource& ) = delete;
+			pool_resource& operator=( const pool_resource& ) = delete;
+
+			~pool_resource()
+			{ release(); }
+
+			/**
+			 * returns every pooled chunk to upstream. Blocks larger than max_block are not tracked and must
+			 * have been deallocated already.
+			*/
+			void release( void )
+			{
+				while( m_chunks != nullptr )
+				{
+					chunk* next = m_chunks->next;
+					m_upstream->deallocate( m_chunks->base, m_chunks->size, m_chunks->alignment );
+					m_chunks = next;
+				}
+				for( pool& p : m_pools )
+					p = pool();
+			}
+
+			std::pmr::memory_resource* upstream_resource( void ) const
+			{ return m_upstream; }
+
+		private:
+			static constexpr std::size_t min_shift = 4; //!< Smallest class: 16 bytes.
+			static constexpr std::size_t num_classes = 20; //!< Up to 8 MiB blocks.
+
+			struct free_block{ free_block* next; };
+			/// Chunk record, kept in the first block(s) of the chunk it describes.
+			struct chunk{
+				chunk* next;
+				void* base;
+				std::size_t size;
+				std::size_t alignment;
+			};
+			/// One size class: recycled blocks first, then the untouched tail of the newest chunk.
+			struct pool{
+				free_block* free = nullptr;
+				char* cur = nullptr;
+				char* end = nullptr;
+			};
+
+			std::pmr::memory_resource* m_upstream;
+			std::size_t m_max_block;
+			std::size_t m_chunk_bytes;
+			chunk* m_chunks = nullptr;
+			pool m_pools[num_classes];
+
+			static std::size_t round_up( std::size_t bytes )
+			{
+				std::size_t size = std::size_t( 1 ) << min_shift;
+				while( size < bytes )
+					size <<= 1;
+				return size;
+			}
+
+			static std::size_t class_of( std::size_t block )
+			{
+				std::size_t c = 0;
+				while( ( std::size_t( 1 ) << ( c + min_shift ) ) < block )
+					c++;
+				return c;
+			}
+
+			void* do_allocate( std::size_t bytes, std::size_t alignment ) override
+			{
+				std::size_t block = round_up( std::max( bytes, alignment ) );
+				if( block > m_max_block )
+					return m_upstream->allocate( bytes, alignment );
+				pool& p = m_pools[class_of( block )];
+				if( p.free != nullptr )
+				{
+					free_block* b = p.free;
+					p.free = b->next;
+					return b;
+				}
+				if( p.cur == p.end )
+				{
+					// Chunk novo, alinhado ao tamanho do bloco: todo bloco fica alinhado ao próprio tamanho.
+					std::size_t size = std::max( m_chunk_bytes, 16 * block );
+					char* base = static_cast<char*>( m_upstream->allocate( size, block ) );
+					std::size_t header = ( ( sizeof(chunk) + block - 1 ) / block ) * block;
+					chunk* c = reinterpret_cast<chunk*>( base );
+					c->next = m_chunks;
+					c->base = base;
+					c->size = size;
+					c->alignment = block;
+					m_chunks = c;
+					p.cur = base + header;
+					p.end = base + header + ( ( size - header ) / block ) * block;
+				}
+				void* b = p.cur;
+				p.cur += block;
+				return b;
+			}
+
+			void do_deallocate( void* ptr, std::size_t bytes, std::size_t alignment ) override
+			{
+				std::size_t block = round_up( std::max( bytes, alignment ) );
+				if( block > m_max_block )
+				{
+					m_upstream->deallocate( ptr, bytes, alignment );
+					return;
+				}
+				pool& p = m_pools[class_of( block )];
+				free_block* b = static_cast<free_block*>( ptr );
+				b->next = p.free;
+				p.free = b;
+			}
+
+			bool do_try_extend( void*, std::size_t old_bytes, std::size_t new_bytes, std::size_t alignment ) override
+			{
+				std::size_t block = round_up( std::max( old_bytes, alignment ) );
+				return block <= m_max_block && block == round_up( std::max( new_bytes, alignment ) );
+			}
+
+			bool do_is_equal( const std::pmr::memory_resource& other ) const noexcept override
+			{ return this == &other; }
+	};
+
+	/**
+	 * std::pmr::polymorphic_allocator plus reallocate(): the block is resized in place when its resource
+	 * is an sc::pmr::extendable_resource that allows it, and moved with one memcpy otherwise. With it
+	 * sc::vector grows trivially relocatable elements without relocating them one by one.
+	*/
+	template < typename T >
+	class polymorphic_allocator : public std::pmr::polymorphic_allocator<T>{
+		typedef std::pmr::polymorphic_allocator<T> base;
+		public:
+			template < typename U >
+			struct rebind{ typedef polymorphic_allocator<U> other; };
+
+			polymorphic_allocator( void ) noexcept:
+				m_extendable{ dynamic_cast<extendable_resource*>( this->resource() ) }
+			{ /* empty */ }
+
+			polymorphic_allocator( std::pmr::memory_resource* r ):
+				base( r ),
+				m_extendable{ dynamic_cast<extendable_resource*>( r ) }
+			{ /* empty */ }
+
+			polymorphic_allocator( const polymorphic_allocator& other ) = default;
+
+			template < typename U >
+			polymorphic_allocator( const polymorphic_allocator<U>& other ) noexcept:
+				base( other.resource() ),
+				m_extendable{ other.extendable() }
+			{ /* empty */ }
+
+			/**
+			 * the resource as an extendable_resource, or nullptr if it cannot resize blocks in place.
+			*/
+			extendable_resource* extendable( void ) const noexcept
+			{ return m_extendable; }
+
+			polymorphic_allocator& operator=( const polymorphic_allocator& ) = delete;
+
+			/**
+			 * a copied container uses the default resource, as with std::pmr.
+			*/
+			polymorphic_allocator select_on_container_copy_construction( void ) const
+			{ return polymorphic_allocator(); }
+
+			/**
+			 * resizes the block p of old_n objects to new_n objects, keeping the bytes of the first
+			 * min(old_n, new_n) objects.
+			*/
+			T* reallocate( T* p, std::size_t old_n, std::size_t new_n )
+			{
+				if( m_extendable != nullptr && m_extendable->try_extend( p, old_n * sizeof(T), new_n * sizeof(T), alignof(T) ) )
+					return p;
+				T* q = this->allocate( new_n );
+				std::memcpy( static_cast<void*>( q ), static_cast<const void*>( p ), std::min( old_n, new_n ) * sizeof(T) );
+				this->deallocate( p, old_n );
+				return q;
+			}
+
+		private:
+			extendable_resource* m_extendable; //!< resource(), looked up once so growth needs no dynamic_cast.
+	};
+}// namespace pmr
+}// namespace sc
+#endif
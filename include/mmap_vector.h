@@ -0,0 +1,563 @@
+#ifndef MMAP_VECTOR_H
+#define MMAP_VECTOR_H
+
+#include "iterator.h"
+#include "growth_policy.h"
+#include "simd.h"
+#include <cerrno>
+#include <cstring> // std::memmove, std::memset
+#include <new> // placement new
+#include <stdexcept> // std::out_of_range, std::logic_error
+#include <string>
+#include <system_error> // std::system_error
+#include <type_traits>
+#include <fcntl.h> // open
+#include <sys/mman.h> // mmap, mremap, msync, madvise
+#include <sys/stat.h> // fstat
+#include <unistd.h> // ftruncate, close
+
+namespace sc {
+
+	/// How sc::mmap_vector opens its file.
+	enum class mmap_mode{
+		read_only,  //!< Existing file, mapped read-only: records must not be written through data() or operator[]; push_back, insert, erase, resize and reserve throw std::logic_error.
+		read_write, //!< Existing file or a new empty one; the records already in it are kept.
+		truncate    //!< New empty file; an existing file is emptied.
+	};
+
+	/// Access pattern hints for sc::mmap_vector::advise (madvise).
+	enum class mmap_advice{
+		normal,     //!< Default readahead.
+		sequential, //!< Pages are read in order: read ahead aggressively, drop them soon after.
+		random,     //!< No readahead.
+		willneed,   //!< Start reading the whole mapping in now.
+		dontneed    //!< Pages can be dropped (they are read back from the file when touched again).
+	};
+
+/**
+ * Dynamic array of fixed-size records stored in a file and accessed through mmap. The file is a plain
+ * array of size() records with no header, so an existing dataset is opened with no read and no copy:
+ * pages are loaded when first touched, and the data may be larger than RAM.
+ * Growth extends the file with ftruncate and remaps it (mremap on Linux). While open, the file is
+ * capacity() records long; it is cut back to size() records when the list is closed.
+ *  @tparam T             trivially copyable record type. Records are stored in host byte order.
+ *  @tparam GrowthPolicy  decides the new capacity whenever the list outgrows its file (see growth_policy.h).
+*/
+template< typename T, typename GrowthPolicy = sc::doubling_growth >
+class mmap_vector{
+	static_assert( std::is_trivially_copyable<T>::value, "sc::mmap_vector stores raw bytes: T must be trivially copyable" );
+
+	public:
+		typedef T value_type; //!< Type of the records stored in the list.
+		typedef GrowthPolicy growth_policy; //!< Policy that picks the capacity on growth.
+		typedef std::size_t size_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef T& reference;
+		typedef const T& const_reference;
+		typedef T* pointer;
+		typedef const T* const_pointer;
+		typedef sc::iterator<T> iterator; //!< Contiguous iterator.
+		typedef sc::const_iterator<T> const_iterator; //!< Contiguous read-only iterator.
+		typedef std::reverse_iterator<iterator> reverse_iterator;
+		typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+	private:
+		int m_fd; //!< File descriptor of the backing file (-1 when closed).
+		bool m_writable; //!< False for mmap_mode::read_only.
+		T * m_data; //!< Mapping of the first m_capacity records of the file.
+		size_t m_size; //!< Current list size (or index past-last valid record).
+		size_t m_capacity; //!< Records the file (and the mapping) can hold.
+
+	public:
+		//=== [I] SPECIAL MEMBERS
+		/**
+		 * Constructs a list that is not backed by any file. Use open() or move another list into it.
+		*/
+		mmap_vector( void ):
+			m_fd{ -1 },
+			m_writable{ false },
+			m_data{ nullptr },
+			m_size{ 0 },
+			m_capacity{ 0 }
+		{ /* empty */ }
+
+		/**
+		 * Opens (or creates) path and maps it. Existing records are not read: the call costs the same
+		 * for a 1 KB and a 20 GB file.
+		 *  @param path  file holding the records.
+		 *  @param mode  see sc::mmap_mode.
+		 * @throws std::system_error if the file cannot be opened or mapped, std::length_error if its
+		 *         length is not a multiple of sizeof(T).
+		*/
+		explicit mmap_vector( const std::string& path, mmap_mode mode = mmap_mode::read_write ):
+			mmap_vector()
+		{ open( path, mode ); }
+
+		mmap_vector( const mmap_vector& ) = delete;
+		mmap_vector& operator=( const mmap_vector& ) = delete;
+
+		/**
+		 *Move constructor. Takes over the file and the mapping of other, which is left closed.
+		*/
+		mmap_vector( mmap_vector&& other ) noexcept:
+			mmap_vector()
+		{ swap( other ); }
+
+		/**
+		 *Move assignment operator. Closes the current file, then takes over the one of other.
+		*/
+		mmap_vector& operator=( mmap_vector&& other ) noexcept
+		{
+			if( this == &other ) return *this;
+			close();
+			swap( other );
+			return *this;
+		}
+
+		/**
+		 * Destructor: unmaps the records, trims the file to size() records and closes it.
+		*/
+		~mmap_vector( )
+		{ close(); }
+
+		/**
+		 * Opens (or creates) path and maps it, closing the current file first. See the constructor.
+		*/
+		void open( const std::string& path, mmap_mode mode = mmap_mode::read_write )
+		{
+			close();
+			int flags = O_RDONLY;
+			if( mode == mmap_mode::read_write )
+				flags = O_RDWR | O_CREAT;
+			else if( mode == mmap_mode::truncate )
+				flags = O_RDWR | O_CREAT | O_TRUNC;
+			int fd = ::open( path.c_str(), flags | O_CLOEXEC, 0644 );
+			if( fd < 0 )
+				throw std::system_error( errno, std::generic_category(), "sc::mmap_vector: open " + path );
+
+			struct stat st;
+			if( ::fstat( fd, &st ) != 0 )
+			{
+				int err = errno;
+				::close( fd );
+				throw std::system_error( err, std::generic_category(), "sc::mmap_vector: fstat " + path );
+			}
+			size_t bytes = static_cast<size_t>( st.st_size );
+			if( bytes % sizeof(T) != 0 )
+			{
+				::close( fd );
+				throw std::length_error( "sc::mmap_vector: " + path + " is not a whole number of records" );
+			}
+			m_fd = fd;
+			m_writable = ( mode != mmap_mode::read_only );
+			try {
+				map( bytes / sizeof(T) );
+			}
+			catch( ... ) {
+				::close( m_fd );
+				m_fd = -1;
+				throw;
+			}
+			m_size = m_capacity;
+		}
+
+		/**
+		 * Unmaps the records, trims the file to size() records and closes it. The list is left empty.
+		*/
+		void close( void ) noexcept
+		{
+			if( m_fd < 0 ) return;
+			if( m_data != nullptr )
+				::munmap( static_cast<void*>( m_data ), m_capacity * sizeof(T) );
+			if( m_writable && m_size != m_capacity )
+				(void) ::ftruncate( m_fd, static_cast<off_t>( m_size * sizeof(T) ) );
+			::close( m_fd );
+			m_fd = -1;
+			m_writable = false;
+			m_data = nullptr;
+			m_size = m_capacity = 0;
+		}
+
+		/**
+		 * returns true if the list is backed by an open file.
+		*/
+		bool is_open( void ) const
+		{ return m_fd >= 0; }
+
+		//=== [II] ITERATORS
+		/**
+		 *returns an iterator pointing to the ﬁrst item in the list.
+		*/
+		sc::iterator<T> begin( void )
+		{ return sc::iterator<T>( m_data ); }
+
+		/**
+		 * returns an iterator pointing to the end mark in the list,
+		 *i.e. the position just after the last element of the list.
+		*/
+		sc::iterator<T> end( void )
+		{ return sc::iterator<T>( m_data + m_size ); }
+
+		/**
+		 *returns a constant iterator pointing to the ﬁrst item in the list.
+		*/
+		const_iterator begin( void )const
+		{ return const_iterator( m_data ); }
+
+		/**
+		 * returns a constant iterator pointing to the end mark in the list.
+		*/
+		const_iterator end( void )const
+		{ return const_iterator( m_data + m_size ); }
+
+		/**
+		 * returns a constant iterator pointing to the ﬁrst item in the list.
+		*/
+		const_iterator cbegin( void )const
+		{ return const_iterator( m_data ); }
+
+		/**
+		 * returns a constant iterator pointing to the end mark in the list.
+		*/
+		const_iterator cend( void )const
+		{ return const_iterator( m_data + m_size ); }
+
+		/**
+		 * returns a reverse iterator pointing to the last item in the list.
+		*/
+		reverse_iterator rbegin( void )
+		{ return reverse_iterator( end() ); }
+
+		/**
+		 * returns a reverse iterator pointing to the position just before the first item in the list.
+		*/
+		reverse_iterator rend( void )
+		{ return reverse_iterator( begin() ); }
+
+		/**
+		 * returns a constant reverse iterator pointing to the last item in the list.
+		*/
+		const_reverse_iterator rbegin( void )const
+		{ return const_reverse_iterator( end() ); }
+
+		/**
+		 * returns a constant reverse iterator pointing to the position just before the first item in the list.
+		*/
+		const_reverse_iterator rend( void )const
+		{ return const_reverse_iterator( begin() ); }
+
+		//=== [III] Capacity
+		/**
+		 *return the number of records in the list.
+		*/
+		size_t size( void )const
+		{ return m_size; }
+
+		/**
+		 * return the number of records the file can hold before it must grow.
+		*/
+		size_t capacity( void )const
+		{ return m_capacity; }
+
+		/**
+		 * returns true if the list contains no records, and false otherwise.
+		*/
+		bool empty( void )const
+		{ return m_size == 0; }
+
+		//=== [IV] Modifiers
+		/**
+		 *removes all records. The file keeps its length (the capacity) until close().
+		*/
+		void clear( void )
+		{ m_size = 0; }
+
+		/**
+		 * adds value to the end of the list.
+		*/
+		void push_back( const T& value )
+		{ emplace_back( value ); }
+
+		/**
+		 * constructs a record at the end of the list.
+		*/
+		template< class... Args >
+		void emplace_back( Args&&... args )
+		{
+			require_writable();
+			if( m_size == m_capacity )
+			{
+				// args pode referenciar um registro do mapeamento, que pode mudar de endereço.
+				T temp( std::forward<Args>(args)... );
+				reserve( GrowthPolicy::next_capacity( m_capacity, m_size + 1 ) );
+				m_data[m_size++] = temp;
+				return;
+			}
+			new ( static_cast<void*>( m_data + m_size ) ) T( std::forward<Args>(args)... );
+			m_size++;
+		}
+
+		/**
+		 * removes the record at the end of the list.
+		*/
+		void pop_back( void )
+		{
+			if( empty() ) return;
+			m_size--;
+		}
+
+		/**
+		 * inserts value before pos, shifting the following records with one memmove.
+		*/
+		sc::iterator<T> insert( const_iterator pos, const T& value )
+		{
+			require_writable();
+			size_t idx = pos - cbegin();
+			T temp( value );
+			if( m_size == m_capacity )
+				reserve( GrowthPolicy::next_capacity( m_capacity, m_size + 1 ) );
+			std::memmove( static_cast<void*>( m_data + idx + 1 ), static_cast<const void*>( m_data + idx ), ( m_size - idx ) * sizeof(T) );
+			m_data[idx] = temp;
+			m_size++;
+			return sc::iterator<T>( m_data + idx );
+		}
+
+		/**
+		 * removes the record at pos. Returns an iterator to the record that followed it.
+		*/
+		sc::iterator<T> erase( const_iterator pos )
+		{ return erase( pos, pos + 1 ); }
+
+		/**
+		 * removes the records in [first, last). Returns an iterator to the record that followed them.
+		*/
+		sc::iterator<T> erase( const_iterator first, const_iterator last )
+		{
+			require_writable();
+			size_t idx = first - cbegin();
+			size_t count = last - first;
+			std::memmove( static_cast<void*>( m_data + idx ), static_cast<const void*>( m_data + idx + count ), ( m_size - idx - count ) * sizeof(T) );
+			m_size -= count;
+			return sc::iterator<T>( m_data + idx );
+		}
+
+		/**
+		 * grows the file to new_cap records (ftruncate) and remaps it. Does nothing if new_cap <= capacity().
+		 * New records read as zero bytes. Pointers and iterators are invalidated when the mapping moves.
+		 * @throws std::system_error if the file cannot be extended or remapped; the list is then unchanged.
+		*/
+		void reserve( size_t new_cap )
+		{
+			if( new_cap <= m_capacity ) return;
+			require_writable();
+			if( ::ftruncate( m_fd, static_cast<off_t>( new_cap * sizeof(T) ) ) != 0 )
+				throw std::system_error( errno, std::generic_category(), "sc::mmap_vector: ftruncate" );
+			try {
+				map( new_cap );
+			}
+			catch( ... ) {
+				(void) ::ftruncate( m_fd, static_cast<off_t>( m_capacity * sizeof(T) ) );
+				throw;
+			}
+		}
+
+		/**
+		 * resizes the list to count records. New records are zero bytes.
+		*/
+		void resize( size_t count )
+		{
+			if( count > m_size )
+				require_writable();
+			if( count > m_capacity )
+				reserve( count );
+			if( count > m_size )
+				std::memset( static_cast<void*>( m_data + m_size ), 0, ( count - m_size ) * sizeof(T) );
+			m_size = count;
+		}
+
+		/**
+		 * cuts the file down to size() records.
+		*/
+		void shrink_to_fit( void )
+		{
+			if( m_size == m_capacity ) return;
+			require_writable();
+			map( m_size );
+			// Se falhar, o arquivo só fica maior que o necessário até close().
+			if( ::ftruncate( m_fd, static_cast<off_t>( m_size * sizeof(T) ) ) != 0 )
+				throw std::system_error( errno, std::generic_category(), "sc::mmap_vector: ftruncate" );
+		}
+
+		//=== [V] File operations
+		/**
+		 * writes the modified pages of the first size() records back to the file (msync).
+		 *  @param wait  true: block until written (MS_SYNC); false: only schedule the write (MS_ASYNC).
+		*/
+		void sync( bool wait = true )
+		{
+			if( m_data == nullptr || m_size == 0 ) return;
+			if( ::msync( static_cast<void*>( m_data ), m_size * sizeof(T), wait ? MS_SYNC : MS_ASYNC ) != 0 )
+				throw std::system_error( errno, std::generic_category(), "sc::mmap_vector: msync" );
+		}
+
+		/**
+		 * tells the kernel how the records will be accessed (madvise), e.g. mmap_advice::sequential
+		 * before a full scan or mmap_advice::willneed to prefetch. It is only a hint; errors are ignored.
+		*/
+		void advise( mmap_advice advice )
+		{
+			if( m_data == nullptr ) return;
+			int flag = MADV_NORMAL;
+			switch( advice )
+			{
+				case mmap_advice::normal:     flag = MADV_NORMAL; break;
+				case mmap_advice::sequential: flag = MADV_SEQUENTIAL; break;
+				case mmap_advice::random:     flag = MADV_RANDOM; break;
+				case mmap_advice::willneed:   flag = MADV_WILLNEED; break;
+				case mmap_advice::dontneed:   flag = MADV_DONTNEED; break;
+			}
+			(void) ::madvise( static_cast<void*>( m_data ), m_capacity * sizeof(T), flag );
+		}
+
+		//=== [VI] Element access
+		/**
+		 * returns a pointer to the first record (nullptr while the file is empty).
+		*/
+		T* data( void )
+		{ return m_data; }
+
+		/**
+		 * returns a pointer to the first record (nullptr while the file is empty).
+		*/
+		const T* data( void ) const
+		{ return m_data; }
+
+		/**
+		 *returns the record at the beginning of the list.
+		*/
+		T& front( void )
+		{ return m_data[0]; }
+
+		/**
+		 *returns the record at the beginning of the list.
+		*/
+		const T& front( void ) const
+		{ return m_data[0]; }
+
+		/**
+		 * returns the record at the end of the list.
+		*/
+		T& back( void )
+		{ return m_data[m_size-1]; }
+
+		/**
+		 * returns the record at the end of the list.
+		*/
+		const T& back( void ) const
+		{ return m_data[m_size-1]; }
+
+		/**
+		 *returns the record at the index pos, with no bounds-checking.
+		*/
+		T& operator[]( size_t pos )
+		{ return m_data[pos]; }
+
+		/**
+		 *returns the record at the index pos, with no bounds-checking.
+		*/
+		const T& operator[]( size_t pos ) const
+		{ return m_data[pos]; }
+
+		/**
+		 *returns the record at the index pos, with bounds-checking. If pos is not within the range of the list, an exception of type std::out_of_range is thrown.
+		*/
+		T& at( size_t pos )
+		{
+			if ( pos >= m_size )
+				throw std::out_of_range( "[mmap_vector::at()] out of range error" );
+			return m_data[ pos ];
+		}
+
+		/**
+		 *returns the record at the index pos, with bounds-checking. If pos is not within the range of the list, an exception of type std::out_of_range is thrown.
+		*/
+		const T& at( size_t pos ) const
+		{
+			if ( pos >= m_size )
+				throw std::out_of_range( "[mmap_vector::at() const] out of range error" );
+			return m_data[ pos ];
+		}
+
+		/**
+		 * exchanges the file and contents of this list with those of other.
+		*/
+		void swap( mmap_vector& other ) noexcept
+		{
+			using std::swap;
+			swap( m_fd, other.m_fd );
+			swap( m_writable, other.m_writable );
+			swap( m_data, other.m_data );
+			swap( m_size, other.m_size );
+			swap( m_capacity, other.m_capacity );
+		}
+
+		//=== [VII] Friend functions.
+		/**
+		 * Checks if lhs and rhs hold the same records (see sc::simd::equal).
+		*/
+		friend bool operator==( const mmap_vector& lhs, const mmap_vector& rhs )
+		{ return lhs.m_size == rhs.m_size && sc::simd::equal( lhs.m_data, rhs.m_data, lhs.m_size ); }
+
+		friend bool operator!=( const mmap_vector& lhs, const mmap_vector& rhs )
+		{ return !( lhs == rhs ); }
+
+		/**
+		 * exchanges the contents of A and B in constant time.
+		*/
+		friend void swap( mmap_vector& A, mmap_vector& B ) noexcept
+		{ A.swap( B ); }
+
+	private:
+		//=== [VIII] Mapping helpers.
+		void require_writable( void ) const
+		{
+			if( !m_writable )
+				throw std::logic_error( "sc::mmap_vector: the file was opened read-only" );
+		}
+
+		/**
+		 * maps the first new_cap records of the file, moving the current mapping (mremap on Linux).
+		 * On failure the old mapping is kept.
+		*/
+		void map( size_t new_cap )
+		{
+			size_t new_bytes = new_cap * sizeof(T);
+			if( new_cap == 0 )
+			{
+				if( m_data != nullptr )
+					::munmap( static_cast<void*>( m_data ), m_capacity * sizeof(T) );
+				m_data = nullptr;
+				m_capacity = 0;
+				return;
+			}
+			void* p = MAP_FAILED;
+#ifdef __linux__
+			if( m_data != nullptr )
+				p = ::mremap( static_cast<void*>( m_data ), m_capacity * sizeof(T), new_bytes, MREMAP_MAYMOVE );
+			else
+#endif
+			{
+				int prot = m_writable ? ( PROT_READ | PROT_WRITE ) : PROT_READ;
+				p = ::mmap( nullptr, new_bytes, prot, MAP_SHARED, m_fd, 0 );
+				if( p != MAP_FAILED && m_data != nullptr )
+					::munmap( static_cast<void*>( m_data ), m_capacity * sizeof(T) );
+			}
+			if( p == MAP_FAILED )
+				throw std::system_error( errno, std::generic_category(), "sc::mmap_vector: mmap" );
+			m_data = static_cast<T*>( p );
+			m_capacity = new_cap;
+		}
+};
+
+}// namespace
+#endif
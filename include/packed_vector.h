@@ -0,0 +1,471 @@
+#ifndef PACKED_VECTOR_H
+#define PACKED_VECTOR_H
+#include "vector.h"
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory> // std::allocator
+#include <stdexcept> // std::out_of_range
+#include <type_traits>
+
+namespace sc{
+namespace detail{
+	/// smallest unsigned type that holds Bits bits.
+	template < unsigned Bits >
+	struct uint_for{
+		typedef typename std::conditional< ( Bits <= 8 ), std::uint8_t,
+		        typename std::conditional< ( Bits <= 16 ), std::uint16_t,
+		        typename std::conditional< ( Bits <= 32 ), std::uint32_t, std::uint64_t >::type >::type >::type type;
+	};
+
+	/**
+	 * Access to an array of Bits-bit unsigned values packed back to back into 64-bit words, value i at
+	 * bits [i * Bits, (i + 1) * Bits), least significant bits first. When Bits does not divide 64, a value
+	 * may straddle two words, and the array keeps one spare word at the end so that get() can always
+	 * read the word after the one the value starts in.
+	*/
+	template < unsigned Bits >
+	struct packed_bits{
+		static_assert( Bits >= 1 && Bits <= 64, "sc::packed_vector: Bits must be between 1 and 64" );
+
+		static constexpr std::uint64_t mask = ( Bits == 64 ) ? ~std::uint64_t( 0 ) : ( std::uint64_t( 1 ) << Bits ) - 1;
+		static constexpr bool straddles = ( 64 % Bits ) != 0;
+
+		/// number of words that hold n values (including the spare one).
+		static constexpr std::size_t words_for( std::size_t n )
+		{ return ( n == 0 ) ? 0 : ( n * Bits + 63 ) / 64 + ( straddles ? 1 : 0 ); }
+
+		static std::uint64_t get( const std::uint64_t* words, std::size_t i )
+		{
+			std::size_t bit = i * Bits;
+			const std::uint64_t* w = words + bit / 64;
+			unsigned off = static_cast<unsigned>( bit % 64 );
+			std::uint64_t v = w[0] >> off;
+			if constexpr ( straddles )
+				v |= ( w[1] << 1 ) << ( 63 - off ); // dois deslocamentos: off = 0 não pode virar << 64.
+			return v & mask;
+		}
+
+		static void set( std::uint64_t* words, std::size_t i, std::uint64_t value )
+		{
+			value &= mask;
+			std::size_t bit = i * Bits;
+			std::uint64_t* w = words + bit / 64;
+			unsigned off = static_cast<unsigned>( bit % 64 );
+			w[0] = ( w[0] & ~( mask << off ) ) | ( value << off );
+			if constexpr ( straddles )
+			{
+				if( off + Bits > 64 )
+				{
+					unsigned low = 64 - off; // bits que couberam na primeira palavra.
+					w[1] = ( w[1] & ~( mask >> low ) ) | ( value >> low );
+				}
+			}
+		}
+
+		/**
+		 * out[j] = value j of the 64 values stored in the Bits words at words. Every shift is a constant once
+		 * the loop is unrolled, so a block costs about one shift, one or and one mask per value, and the
+		 * compiler may vectorize it.
+		*/
+		template < typename U >
+		static void unpack_block( const std::uint64_t* words, U* out )
+		{
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC unroll 64
+#endif
+			for( unsigned j = 0; j < 64; j++ )
+			{
+				const unsigned bit = j * Bits, off = bit % 64;
+				std::uint64_t v = words[bit / 64] >> off;
+				if( off + Bits > 64 )
+					v |= words[bit / 64 + 1] << ( 64 - off );
+				out[j] = static_cast<U>( v & mask );
+			}
+		}
+
+		/**
+		 * out[j] = value first + j, for j < count: one value at a time up to a multiple of 64, then whole
+		 * blocks of 64 values, then the rest.
+		*/
+		template < typename U >
+		static void unpack( const std::uint64_t* words, std::size_t first, std::size_t count, U* out )
+		{
+			std::size_t i = first, last = first + count;
+			for( ; i < last && i % 64 != 0; i++ )
+				*out++ = static_cast<U>( get( words, i ) );
+			for( ; i + 64 <= last; i += 64, out += 64 )
+				unpack_block( words + i / 64 * Bits, out );
+			for( ; i < last; i++ )
+				*out++ = static_cast<U>( get( words, i ) );
+		}
+	};
+
+	/**
+	 * Proxy returned by operator[] of the packed containers: reads and writes value index of the words.
+	*/
+	template < unsigned Bits, typename Value >
+	class packed_reference{
+		public:
+			packed_reference( std::uint64_t* words, std::size_t index ): m_words{ words }, m_index{ index }
+			{ /* empty */ }
+
+			operator Value( void )const
+			{ return static_cast<Value>( packed_bits<Bits>::get( m_words, m_index ) ); }
+
+			packed_reference& operator=( Value value )
+			{
+				packed_bits<Bits>::set( m_words, m_index, static_cast<std::uint64_t>( value ) );
+				return *this;
+			}
+
+			packed_reference& operator=( const packed_reference& other )
+			{ return *this = static_cast<Value>( other ); }
+
+			/// swaps the referenced values (the proxies are temporaries, so std::swap does not apply).
+			friend void swap( packed_reference a, packed_reference b )
+			{
+				Value tmp = a;
+				a = static_cast<Value>( b );
+				b = tmp;
+			}
+
+			friend void swap( packed_reference a, Value& b )
+			{
+				Value tmp = a;
+				a = b;
+				b = tmp;
+			}
+
+			friend void swap( Value& a, packed_reference b ) { swap( b, a ); }
+
+		private:
+			std::uint64_t* m_words;
+			std::size_t m_index;
+	};
+
+	/**
+	 * Random-access iterator over a packed array: a word pointer and an index. Dereferencing gives a
+	 * packed_reference (Const: the value itself).
+	*/
+	template < unsigned Bits, typename Value, bool Const >
+	class packed_iterator{
+		public:
+			typedef std::random_access_iterator_tag iterator_category;
+			typedef Value value_type;
+			typedef std::ptrdiff_t difference_type;
+			typedef typename std::conditional< Const, Value, packed_reference<Bits, Value> >::type reference;
+			typedef void pointer;
+			typedef typename std::conditional< Const, const std::uint64_t*, std::uint64_t* >::type word_pointer;
+
+			packed_iterator( void ): m_words{ nullptr }, m_index{ 0 }
+			{ /* empty */ }
+
+			packed_iterator( word_pointer words, std::size_t index ): m_words{ words }, m_index{ index }
+			{ /* empty */ }
+
+			/// a mutable iterator converts to a const one.
+			template < bool C = Const, typename = typename std::enable_if<C>::type >
+			packed_iterator( const packed_iterator<Bits, Value, false>& other ): m_words{ other.words() }, m_index{ other.index() }
+			{ /* empty */ }
+
+			reference operator*( void )const
+			{
+				if constexpr ( Const )
+					return static_cast<Value>( packed_bits<Bits>::get( m_words, m_index ) );
+				else
+					return reference( m_words, m_index );
+			}
+			reference operator[]( difference_type n )const { return *( *this + n ); }
+
+			packed_iterator& operator++( void ) { ++m_index; return *this; }
+			packed_iterator operator++( int ) { packed_iterator old = *this; ++m_index; return old; }
+			packed_iterator& operator--( void ) { --m_index; return *this; }
+			packed_iterator operator--( int ) { packed_iterator old = *this; --m_index; return old; }
+			packed_iterator& operator+=( difference_type n ) { m_index += n; return *this; }
+			packed_iterator& operator-=( difference_type n ) { m_index -= n; return *this; }
+
+			friend packed_iterator operator+( packed_iterator it, difference_type n ) { return it += n; }
+			friend packed_iterator operator+( difference_type n, packed_iterator it ) { return it += n; }
+			friend packed_iterator operator-( packed_iterator it, difference_type n ) { return it -= n; }
+			friend difference_type operator-( const packed_iterator& a, const packed_iterator& b )
+			{ return static_cast<difference_type>( a.m_index ) - static_cast<difference_type>( b.m_index ); }
+
+			friend bool operator==( const packed_iterator& a, const packed_iterator& b ) { return a.m_index == b.m_index; }
+			friend bool operator!=( const packed_iterator& a, const packed_iterator& b ) { return a.m_index != b.m_index; }
+			friend bool operator<( const packed_iterator& a, const packed_iterator& b ) { return a.m_index < b.m_index; }
+			friend bool operator>( const packed_iterator& a, const packed_iterator& b ) { return a.m_index > b.m_index; }
+			friend bool operator<=( const packed_iterator& a, const packed_iterator& b ) { return a.m_index <= b.m_index; }
+			friend bool operator>=( const packed_iterator& a, const packed_iterator& b ) { return a.m_index >= b.m_index; }
+
+			word_pointer words( void )const { return m_words; }
+			std::size_t index( void )const { return m_index; }
+
+		private:
+			word_pointer m_words;
+			std::size_t m_index;
+	};
+}// namespace detail
+
+/**
+ * List of unsigned integers of Bits bits each (1 to 64), packed back to back into 64-bit words: 1M
+ * 20-bit IDs take 2.5 MB instead of the 8 MB of a sc::vector<std::uint64_t>. Values are read and
+ * written through operator[] (a proxy), get() and set(); a value wider than Bits keeps only its low
+ * Bits bits, as a bit-field would.
+ *
+ * unpack() decodes a range into plain integers block by block (64 values from Bits whole words, with
+ * constant shifts), which is the fast way to scan the list.
+ *  @tparam Allocator  allocator of the 64-bit words.
+*/
+template< unsigned Bits, typename Allocator = std::allocator<std::uint64_t> >
+class packed_vector{
+	typedef detail::packed_bits<Bits> bits;
+
+	public:
+		typedef typename detail::uint_for<Bits>::type value_type; //!< Smallest unsigned type that holds Bits bits.
+		typedef Allocator allocator_type;
+		typedef std::size_t size_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef detail::packed_reference<Bits, value_type> reference;
+		typedef value_type const_reference;
+		typedef detail::packed_iterator<Bits, value_type, false> iterator;
+		typedef detail::packed_iterator<Bits, value_type, true> const_iterator;
+		typedef std::reverse_iterator<iterator> reverse_iterator;
+		typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+		typedef sc::vector<std::uint64_t, Allocator> word_container;
+
+		static constexpr unsigned bits_per_value = Bits;
+		static constexpr value_type max_value = static_cast<value_type>( bits::mask ); //!< Largest value that fits.
+
+	private:
+		word_container m_words; //!< Packed values; bits past the last value are zero.
+		size_t m_size;
+
+		/// makes room in m_words for n values, adding zeroed words.
+		void grow_words( size_t n )
+		{
+			size_t need = bits::words_for( n );
+			while( m_words.size() < need )
+				m_words.push_back( 0 );
+		}
+
+	public:
+		//=== [I] SPECIAL MEMBERS
+
+		/**
+		 * Constructs an empty list.
+		*/
+		explicit packed_vector( const Allocator& alloc = Allocator() ): m_words( alloc ), m_size{ 0 }
+		{ /* empty */ }
+
+		/**
+		 * Constructs the list with count copies of value.
+		*/
+		packed_vector( size_t count, value_type value, const Allocator& alloc = Allocator() ): packed_vector( alloc )
+		{ resize( count, value ); }
+
+		/**
+		 * Constructs the list with the values of the range [first, last).
+		*/
+		template< typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category >
+		packed_vector( InputIt first, InputIt last, const Allocator& alloc = Allocator() ): packed_vector( alloc )
+		{ assign( first, last ); }
+
+		/**
+		 * Constructs the list with the values of ilist.
+		*/
+		packed_vector( std::initializer_list<value_type> ilist, const Allocator& alloc = Allocator() ):
+			packed_vector( ilist.begin(), ilist.end(), alloc )
+		{ /* empty */ }
+
+		//=== [II] ITERATORS
+
+		iterator begin( void ) { return iterator( m_words.data(), 0 ); }
+		iterator end( void ) { return iterator( m_words.data(), m_size ); }
+		const_iterator begin( void )const { return const_iterator( m_words.data(), 0 ); }
+		const_iterator end( void )const { return const_iterator( m_words.data(), m_size ); }
+		const_iterator cbegin( void )const { return begin(); }
+		const_iterator cend( void )const { return end(); }
+		reverse_iterator rbegin( void ) { return reverse_iterator( end() ); }
+		reverse_iterator rend( void ) { return reverse_iterator( begin() ); }
+		const_reverse_iterator rbegin( void )const { return const_reverse_iterator( end() ); }
+		const_reverse_iterator rend( void )const { return const_reverse_iterator( begin() ); }
+
+		//=== [III] Capacity
+
+		size_t size( void )const { return m_size; }
+		bool empty( void )const { return m_size == 0; }
+
+		/**
+		 * number of values the current words can hold.
+		*/
+		size_t capacity( void )const
+		{
+			size_t words = m_words.capacity();
+			if( bits::straddles && words > 0 )
+				words--;
+			return words * 64 / Bits;
+		}
+
+		/**
+		 * makes room for new_cap values, so that push_back up to that size does not reallocate.
+		*/
+		void reserve( size_t new_cap ) { m_words.reserve( bits::words_for( new_cap ) ); }
+
+		void shrink_to_fit( void ) { m_words.shrink_to_fit(); }
+
+		/**
+		 * bytes of storage in use (the words holding size() values).
+		*/
+		size_t size_in_bytes( void )const { return m_words.size() * sizeof(std::uint64_t); }
+
+		//=== [IV] Modifiers
+
+		void clear( void )
+		{
+			m_words.clear();
+			m_size = 0;
+		}
+
+		/**
+		 * adds value (its low Bits bits) to the end of the list.
+		*/
+		void push_back( value_type value )
+		{
+			grow_words( m_size + 1 );
+			bits::set( m_words.data(), m_size, value );
+			m_size++;
+		}
+
+		/**
+		 * removes the value at the end of the list.
+		*/
+		void pop_back( void )
+		{
+			if( m_size != 0 )
+				resize( m_size - 1 );
+		}
+
+		/**
+		 * changes the size to count; new values are copies of value.
+		*/
+		void resize( size_t count, value_type value = 0 )
+		{
+			if( count < m_size )
+			{
+				while( m_words.size() > bits::words_for( count ) )
+					m_words.pop_back();
+				// bits a partir do valor count ficam zerados, como exige o invariante.
+				size_t bit = count * Bits, w = bit / 64;
+				if( w < m_words.size() )
+				{
+					m_words[w] &= ( std::uint64_t( 1 ) << ( bit % 64 ) ) - 1;
+					for( size_t k = w + 1; k < m_words.size(); k++ )
+						m_words[k] = 0;
+				}
+				m_size = count;
+				return;
+			}
+			reserve( count );
+			grow_words( count );
+			if( value != 0 )
+				for( size_t i = m_size; i < count; i++ )
+					bits::set( m_words.data(), i, value );
+			m_size = count;
+		}
+
+		/**
+		 * replaces the contents with the values of [first, last).
+		*/
+		template < typename InItr, typename = typename std::iterator_traits<InItr>::iterator_category >
+		void assign( InItr first, InItr last )
+		{
+			clear();
+			if constexpr ( std::is_base_of< std::forward_iterator_tag, typename std::iterator_traits<InItr>::iterator_category >::value )
+				reserve( static_cast<size_t>( std::distance( first, last ) ) );
+			for( ; first != last; ++first )
+				push_back( static_cast<value_type>( *first ) );
+		}
+
+		/**
+		 * writes value (its low Bits bits) at pos, with no bounds-checking.
+		*/
+		void set( size_t pos, value_type value ) { bits::set( m_words.data(), pos, value ); }
+
+		void swap( packed_vector& other ) noexcept
+		{
+			m_words.swap( other.m_words );
+			std::swap( m_size, other.m_size );
+		}
+
+		//=== [V] Element access
+
+		/**
+		 * returns the value at pos, with no bounds-checking.
+		*/
+		value_type get( size_t pos )const { return static_cast<value_type>( bits::get( m_words.data(), pos ) ); }
+
+		value_type operator[]( size_t pos )const { return get( pos ); }
+		reference operator[]( size_t pos ) { return reference( m_words.data(), pos ); }
+
+		/**
+		 * returns the value at pos, with bounds-checking.
+		 * @throws std::out_of_range if pos >= size().
+		*/
+		value_type at( size_t pos )const
+		{
+			if( pos >= m_size )
+				throw std::out_of_range( "[packed_vector::at()] out of range error" );
+			return get( pos );
+		}
+
+		reference at( size_t pos )
+		{
+			if( pos >= m_size )
+				throw std::out_of_range( "[packed_vector::at()] out of range error" );
+			return reference( m_words.data(), pos );
+		}
+
+		value_type front( void )const { return get( 0 ); }
+		value_type back( void )const { return get( m_size - 1 ); }
+
+		/**
+		 * writes values first to first + count - 1 to out, which has room for them.
+		*/
+		template < typename U >
+		void unpack( size_t first, size_t count, U* out )const
+		{ bits::unpack( m_words.data(), first, count, out ); }
+
+		/**
+		 * appends all the values to out.
+		*/
+		template < typename U, typename A, typename G, typename I >
+		void unpack( sc::vector<U, A, G, I>& out )const
+		{
+			out.reserve( out.size() + m_size );
+			U block[64];
+			for( size_t i = 0; i < m_size; i += 64 )
+			{
+				size_t count = ( m_size - i < 64 ) ? m_size - i : 64;
+				bits::unpack( m_words.data(), i, count, block );
+				out.insert( out.cend(), block, block + count );
+			}
+		}
+
+		/**
+		 * returns the packed words.
+		*/
+		const word_container& words( void )const { return m_words; }
+
+		friend bool operator==( const packed_vector& lhs, const packed_vector& rhs )
+		{ return lhs.m_size == rhs.m_size && lhs.m_words == rhs.m_words; }
+
+		friend bool operator!=( const packed_vector& lhs, const packed_vector& rhs )
+		{ return !( lhs == rhs ); }
+
+		friend void swap( packed_vector& A, packed_vector& B ) noexcept
+		{ A.swap( B ); }
+};
+}// namespace sc
+#endif
@@ -0,0 +1,418 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+#include "thread_pool.h"
+#include "sort.h"
+#include <algorithm> // std::sort, std::stable_sort, std::inplace_merge
+#include <array>
+#include <cstddef>
+#include <cstdint> // std::uintptr_t
+#include <cstring> // std::memcpy
+#include <functional> // std::plus, std::less
+#include <iterator>
+#include <numeric> // std::inclusive_scan
+#include <stdexcept> // std::length_error
+#include <type_traits>
+#include <utility> // std::declval
+#include <vector>
+
+/**
+ * Parallel algorithms over contiguous ranges: sc::vector (or anything with data() and size()) and raw
+ * pointer ranges. The range is cut into chunks whose boundaries fall on 64-byte cache lines, so two
+ * threads never write to the same line, and the chunks run on a sc::parallel::thread_pool.
+ *
+ *     sc::parallel::fill( v, 0 );
+ *     double total = sc::parallel::reduce( v, 0.0, std::plus<>(), { &pool, 0, true } );
+*/
+namespace sc{
+namespace parallel{
+	/// Controls how an algorithm is split.
+	struct options{
+		thread_pool* pool = nullptr; //!< Pool to run on; nullptr means thread_pool::default_pool().
+		std::size_t grain = 0; //!< Elements per chunk; 0 picks one (see deterministic).
+		/**
+		 * If true, the chunks depend only on the length of the range (grain or 1 << 16 elements), not on
+		 * the number of threads or on where the range is in memory (no cache-line adjustment), so reduce()
+		 * and inclusive_scan() with a non-associative operation (floating-point +) give bit-identical
+		 * results on any pool and any copy of the data. Otherwise the range is cut into about 4 chunks per
+		 * thread.
+		*/
+		bool deterministic = false;
+	};
+
+namespace detail{
+	constexpr std::size_t cache_line = 64;
+	constexpr std::size_t deterministic_grain = std::size_t( 1 ) << 16;
+	/// Below this many elements per thread the algorithms run on the calling thread only.
+	constexpr std::size_t min_parallel = 4096;
+
+	inline thread_pool& pool_of( const options& opt )
+	{ return ( opt.pool != nullptr ) ? *opt.pool : thread_pool::default_pool(); }
+
+	/**
+	 * chunk boundaries of the n elements at data: bounds[i] is the first element of chunk i and the last
+	 * entry is n. Inner boundaries are moved forward (by less than one cache line) onto a line start,
+	 * except with options::deterministic, where they stay at multiples of the grain.
+	*/
+	template < typename T >
+	std::vector<std::size_t> split( const T* data, std::size_t n, const options& opt )
+	{
+		std::size_t grain = opt.grain;
+		if( grain == 0 )
+		{
+			std::size_t threads = pool_of( opt ).concurrency();
+			if( opt.deterministic )
+				grain = deterministic_grain;
+			else if( threads == 1 || n < threads * min_parallel )
+				grain = n;
+			else
+				grain = n / ( threads * 4 );
+		}
+		grain = std::max<std::size_t>( grain, 1 );
+		std::vector<std::size_t> bounds;
+		bounds.push_back( 0 );
+		for( std::size_t b = grain; b < n; b += grain )
+		{
+			std::size_t aligned = b;
+			for( std::size_t k = 0; !opt.deterministic && k < cache_line && aligned < n; k++, aligned++ )
+				if( reinterpret_cast<std::uintptr_t>( data + aligned ) % cache_line == 0 )
+					break;
+			if( aligned >= n || aligned - b >= cache_line )
+				aligned = b; // tamanho de T não permite alinhar: fica a fronteira original.
+			if( aligned > bounds.back() )
+				bounds.push_back( aligned );
+		}
+		bounds.push_back( n );
+		if( n == 0 )
+			bounds.pop_back();
+		return bounds;
+	}
+
+	/**
+	 * runs body( first, last, chunk ) for every chunk of [data, data + n) on the pool of opt.
+	*/
+	template < typename T, typename Body >
+	void for_chunks( T* data, std::size_t n, const options& opt, Body body )
+	{
+		std::vector<std::size_t> bounds = split( data, n, opt );
+		if( bounds.size() < 2 ) return;
+		pool_of( opt ).run( bounds.size() - 1,
+			[&]( std::size_t c ){ body( bounds[c], bounds[c + 1], c ); } );
+	}
+
+	/// SFINAE guard: the container overloads only apply to types with data() and size().
+	template < typename Container >
+	using if_container = decltype( (void) std::declval<Container&>().data(), (void) std::declval<Container&>().size() );
+
+	template < typename Container >
+	void require_size( const Container& out, std::size_t n )
+	{
+		if( out.size() < n )
+			throw std::length_error( "sc::parallel: the output is smaller than the input" );
+	}
+}// namespace detail
+
+	/**
+	 * calls f( x ) for every element of [first, last). Calls on different chunks run concurrently.
+	*/
+	template < typename T, typename F >
+	void for_each( T* first, T* last, F f, const options& opt = options() )
+	{
+		detail::for_chunks( first, last - first, opt,
+			[&]( std::size_t b, std::size_t e, std::size_t ){
+				for( std::size_t i = b; i < e; i++ )
+					f( first[i] );
+			} );
+	}
+
+	/**
+	 * calls f( x ) for every element of c (sc::vector or any container with data() and size()).
+	*/
+	template < typename Container, typename F, typename = detail::if_container<Container> >
+	void for_each( Container& c, F f, const options& opt = options() )
+	{ for_each( c.data(), c.data() + c.size(), f, opt ); }
+
+	/**
+	 * assigns value to every element of [first, last).
+	*/
+	template < typename T, typename U >
+	void fill( T* first, T* last, const U& value, const options& opt = options() )
+	{
+		detail::for_chunks( first, last - first, opt,
+			[&]( std::size_t b, std::size_t e, std::size_t ){ std::fill( first + b, first + e, value ); } );
+	}
+
+	/**
+	 * assigns value to every element of c.
+	*/
+	template < typename Container, typename U, typename = detail::if_container<Container> >
+	void fill( Container& c, const U& value, const options& opt = options() )
+	{ fill( c.data(), c.data() + c.size(), value, opt ); }
+
+	/**
+	 * copies [first, last) to the constructed elements starting at d_first. The ranges must not overlap.
+	*/
+	template < typename T, typename U >
+	void copy( const T* first, const T* last, U* d_first, const options& opt = options() )
+	{
+		detail::for_chunks( d_first, last - first, opt,
+			[&]( std::size_t b, std::size_t e, std::size_t ){ std::copy( first + b, first + e, d_first + b ); } );
+	}
+
+	/**
+	 * copies in over the first in.size() elements of out.
+	 * @throws std::length_error if out is smaller than in.
+	*/
+	template < typename In, typename Out, typename = detail::if_container<Out> >
+	void copy( const In& in, Out& out, const options& opt = options() )
+	{
+		detail::require_size( out, in.size() );
+		copy( in.data(), in.data() + in.size(), out.data(), opt );
+	}
+
+	/**
+	 * d_first[i] = f( first[i] ) for every element of [first, last). The ranges must not overlap unless
+	 * they are the same range.
+	*/
+	template < typename T, typename U, typename F >
+	void transform( const T* first, const T* last, U* d_first, F f, const options& opt = options() )
+	{
+		detail::for_chunks( d_first, last - first, opt,
+			[&]( std::size_t b, std::size_t e, std::size_t ){
+				for( std::size_t i = b; i < e; i++ )
+					d_first[i] = f( first[i] );
+			} );
+	}
+
+	/**
+	 * out[i] = f( in[i] ) for the first in.size() elements of out.
+	 * @throws std::length_error if out is smaller than in.
+	*/
+	template < typename In, typename Out, typename F, typename = detail::if_container<Out> >
+	void transform( const In& in, Out& out, F f, const options& opt = options() )
+	{
+		detail::require_size( out, in.size() );
+		transform( in.data(), in.data() + in.size(), out.data(), f, opt );
+	}
+
+	/**
+	 * combines init and every element of [first, last) with op, which must be associative. Each chunk
+	 * is folded left to right and the chunk results are then folded in order, so with
+	 * options::deterministic the result does not depend on the number of threads.
+	*/
+	template < typename T, typename R, typename Op = std::plus<> >
+	R reduce( const T* first, const T* last, R init, Op op = Op(), const options& opt = options() )
+	{
+		std::vector<std::size_t> bounds = detail::split( first, last - first, opt );
+		if( bounds.size() < 2 ) return init;
+		std::vector<R> partial( bounds.size() - 1, init );
+		detail::pool_of( opt ).run( partial.size(),
+			[&]( std::size_t c ){
+				R acc = first[bounds[c]];
+				for( std::size_t i = bounds[c] + 1; i < bounds[c + 1]; i++ )
+					acc = op( acc, first[i] );
+				partial[c] = acc;
+			} );
+		for( const R& r : partial )
+			init = op( init, r );
+		return init;
+	}
+
+	/**
+	 * combines init and every element of c with op (see the pointer version).
+	*/
+	template < typename Container, typename R, typename Op = std::plus<>, typename = detail::if_container<Container> >
+	R reduce( const Container& c, R init, Op op = Op(), const options& opt = options() )
+	{ return reduce( c.data(), c.data() + c.size(), init, op, opt ); }
+
+	/**
+	 * d_first[i] = first[0] op first[1] op ... op first[i]. Two passes: every chunk is reduced in
+	 * parallel, the chunk totals are scanned in order, then every chunk is scanned in parallel from its
+	 * offset. In-place (d_first == first) is allowed.
+	*/
+	template < typename T, typename U, typename Op = std::plus<> >
+	void inclusive_scan( const T* first, const T* last, U* d_first, Op op = Op(), const options& opt = options() )
+	{
+		std::vector<std::size_t> bounds = detail::split( d_first, last - first, opt );
+		if( bounds.size() < 2 ) return;
+		std::size_t chunks = bounds.size() - 1;
+		thread_pool& pool = detail::pool_of( opt );
+		if( chunks == 1 )
+		{
+			std::inclusive_scan( first, last, d_first, op );
+			return;
+		}
+		std::vector<U> total( chunks, U( first[0] ) );
+		pool.run( chunks,
+			[&]( std::size_t c ){
+				U acc = first[bounds[c]];
+				for( std::size_t i = bounds[c] + 1; i < bounds[c + 1]; i++ )
+					acc = op( acc, first[i] );
+				total[c] = acc;
+			} );
+		// Prefixo dos totais: offset de cada bloco (o primeiro não tem).
+		for( std::size_t c = 1; c < chunks; c++ )
+			total[c] = op( total[c - 1], total[c] );
+		pool.run( chunks,
+			[&]( std::size_t c ){
+				std::size_t b = bounds[c];
+				U acc = ( c == 0 ) ? U( first[b] ) : op( total[c - 1], first[b] );
+				d_first[b] = acc;
+				for( std::size_t i = b + 1; i < bounds[c + 1]; i++ )
+				{
+					acc = op( acc, first[i] );
+					d_first[i] = acc;
+				}
+			} );
+	}
+
+	/**
+	 * scans in into the first in.size() elements of out (see the pointer version). out may be in.
+	 * @throws std::length_error if out is smaller than in.
+	*/
+	template < typename In, typename Out, typename Op = std::plus<>, typename = detail::if_container<Out> >
+	void inclusive_scan( const In& in, Out& out, Op op = Op(), const options& opt = options() )
+	{
+		detail::require_size( out, in.size() );
+		inclusive_scan( in.data(), in.data() + in.size(), out.data(), op, opt );
+	}
+
+namespace detail{
+	/**
+	 * sorts [first, last): chunk_sort( b, e ) sorts every chunk in parallel, then neighbouring runs are
+	 * merged pairwise, all pairs of a round in parallel, until one run is left. The merges are stable, so
+	 * the whole sort is stable if chunk_sort is.
+	*/
+	template < typename T, typename Compare, typename ChunkSort >
+	void sort_runs( T* first, T* last, Compare comp, const options& opt, ChunkSort chunk_sort )
+	{
+		std::vector<std::size_t> bounds = split( first, last - first, opt );
+		if( bounds.size() < 2 ) return;
+		thread_pool& pool = pool_of( opt );
+		pool.run( bounds.size() - 1,
+			[&]( std::size_t c ){ chunk_sort( first + bounds[c], first + bounds[c + 1] ); } );
+		while( bounds.size() > 2 )
+		{
+			std::size_t runs = bounds.size() - 1;
+			pool.run( runs / 2,
+				[&]( std::size_t p ){
+					std::inplace_merge( first + bounds[2 * p], first + bounds[2 * p + 1], first + bounds[2 * p + 2], comp );
+				} );
+			std::vector<std::size_t> next;
+			for( std::size_t i = 0; i < bounds.size(); i += 2 )
+				next.push_back( bounds[i] );
+			if( next.back() != bounds.back() )
+				next.push_back( bounds.back() );
+			bounds.swap( next );
+		}
+	}
+
+	/**
+	 * stable LSD radix sort of the n elements at data by key (see sc::detail::radix_sort), every pass
+	 * split over the chunks: each chunk counts its bytes, the counts give each chunk its own output
+	 * positions (for one byte value, chunk 0 first, so the sort stays stable), and each chunk scatters
+	 * its elements. Uses the sort buffer of the calling thread.
+	*/
+	template < typename T, typename KeyFn >
+	void radix_sort( T* data, std::size_t n, KeyFn key, const options& opt )
+	{
+		std::vector<std::size_t> bounds = split( data, n, opt );
+		T* buffer = sc::detail::sort_scratch<T>( n );
+		std::size_t chunks = bounds.size() - 1;
+		if( chunks < 2 )
+		{
+			sc::detail::radix_sort( data, n, buffer, key );
+			return;
+		}
+		typedef decltype( key( *data ) ) U;
+		thread_pool& pool = pool_of( opt );
+		std::vector< std::array<std::size_t, 256> > count( chunks );
+		T* src = data;
+		T* dst = buffer;
+		for( unsigned shift = 0; shift < sizeof(U) * 8; shift += 8 )
+		{
+			pool.run( chunks,
+				[&]( std::size_t c ){
+					std::array<std::size_t, 256>& h = count[c];
+					h.fill( 0 );
+					for( std::size_t i = bounds[c]; i < bounds[c + 1]; i++ )
+						h[( key( src[i] ) >> shift ) & 0xFF]++;
+				} );
+			std::size_t digit = ( key( src[0] ) >> shift ) & 0xFF, same = 0;
+			for( std::size_t c = 0; c < chunks; c++ )
+				same += count[c][digit];
+			if( same == n )
+				continue; // todas as chaves têm o mesmo byte aqui.
+			std::size_t sum = 0;
+			for( unsigned b = 0; b < 256; b++ )
+				for( std::size_t c = 0; c < chunks; c++ )
+				{
+					std::size_t t = count[c][b];
+					count[c][b] = sum;
+					sum += t;
+				}
+			pool.run( chunks,
+				[&]( std::size_t c ){
+					std::array<std::size_t, 256>& h = count[c];
+					for( std::size_t i = bounds[c]; i < bounds[c + 1]; i++ )
+						dst[h[( key( src[i] ) >> shift ) & 0xFF]++] = src[i];
+				} );
+			std::swap( src, dst );
+		}
+		if( src != data )
+			for_chunks( data, n, opt,
+				[&]( std::size_t b, std::size_t e, std::size_t ){
+					std::memcpy( static_cast<void*>( data + b ), src + b, ( e - b ) * sizeof(T) );
+				} );
+	}
+}// namespace detail
+
+	/**
+	 * sorts [first, last) by comp. Arithmetic and enum elements with std::less or std::greater are radix
+	 * sorted (see sort.h) with the passes split over the threads; otherwise the chunks are sorted in
+	 * parallel with std::sort and then merged pairwise, all pairs of a round in parallel. Stable only in
+	 * the radix case.
+	*/
+	template < typename T, typename Compare = std::less<> >
+	void sort( T* first, T* last, Compare comp = Compare(), const options& opt = options() )
+	{
+		std::size_t n = static_cast<std::size_t>( last - first );
+		if constexpr ( sc::detail::radix_order<T, Compare>::value )
+		{
+			if( n >= sc::detail::radix_min )
+			{
+				detail::radix_sort( first, n, sc::detail::radix_key< T, sc::detail::is_greater_than<Compare, T>::value >(), opt );
+				return;
+			}
+		}
+		detail::sort_runs( first, last, comp, opt, [&]( T* b, T* e ){ std::sort( b, e, comp ); } );
+	}
+
+	/**
+	 * sorts c by comp (see the pointer version).
+	*/
+	template < typename Container, typename Compare = std::less<>, typename = detail::if_container<Container> >
+	void sort( Container& c, Compare comp = Compare(), const options& opt = options() )
+	{ sort( c.data(), c.data() + c.size(), comp, opt ); }
+
+	/**
+	 * sorts [first, last) by comp, keeping the order of equivalent elements: the radix sort when sort()
+	 * would use it, otherwise std::stable_sort on the chunks and stable merges.
+	*/
+	template < typename T, typename Compare = std::less<> >
+	void stable_sort( T* first, T* last, Compare comp = Compare(), const options& opt = options() )
+	{
+		if constexpr ( sc::detail::radix_order<T, Compare>::value )
+			sort( first, last, comp, opt );
+		else
+			detail::sort_runs( first, last, comp, opt, [&]( T* b, T* e ){ std::stable_sort( b, e, comp ); } );
+	}
+
+	/**
+	 * sorts c by comp, stably (see the pointer version).
+	*/
+	template < typename Container, typename Compare = std::less<>, typename = detail::if_container<Container> >
+	void stable_sort( Container& c, Compare comp = Compare(), const options& opt = options() )
+	{ stable_sort( c.data(), c.data() + c.size(), comp, opt ); }
+}// namespace parallel
+}// namespace sc
+#endif
@@ -0,0 +1,17 @@
+#ifndef PMR_VECTOR_H
+#define PMR_VECTOR_H
+#include "vector.h"
+#include "memory_resource.h"
+
+namespace sc{
+namespace pmr{
+	/**
+	 * sc::vector whose memory comes from a std::pmr::memory_resource, e.g. one sc::pmr::arena_resource per
+	 * request: sc::pmr::vector<int> v( &arena ); Trivially relocatable elements grow in place when the
+	 * resource allows it (see sc::pmr::extendable_resource).
+	*/
+	template < typename T, typename GrowthPolicy = sc::doubling_growth, typename Instrument = sc::no_instrumentation >
+	using vector = sc::vector< T, sc::pmr::polymorphic_allocator<T>, GrowthPolicy, Instrument >;
+}// namespace pmr
+}// namespace sc
+#endif
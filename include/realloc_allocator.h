@@ -0,0 +1,134 @@
+#ifndef REALLOC_ALLOCATOR_H
+#define REALLOC_ALLOCATOR_H
+#include <cstddef>
+#include <cstdlib> // std::malloc, std::realloc, std::free
+#include <cstring> // std::memcpy
+#include <algorithm> // std::min
+#include <new> // std::bad_alloc
+#include <type_traits>
+#include <utility> // std::declval
+#ifdef __linux__
+#include <sys/mman.h> // mmap, mremap, munmap
+#endif
+
+namespace sc{
+	/**
+	 * Detects allocators that can resize a block: a.reallocate( p, old_n, new_n ) returns the (possibly
+	 * moved) block of new_n elements holding the bytes of the old one, or throws. sc::vector uses it to
+	 * grow trivially relocatable elements without copying them itself.
+	*/
+	template < typename Alloc, typename = void >
+	struct has_reallocate : std::false_type
+	{ /* empty */ };
+
+	template < typename Alloc >
+	struct has_reallocate< Alloc, decltype( (void) std::declval<Alloc&>().reallocate(
+		std::declval<typename Alloc::value_type*>(), std::size_t(), std::size_t() ) ) > : std::true_type
+	{ /* empty */ };
+
+	/**
+	 * Stateless allocator backed by malloc/realloc for small blocks and, on Linux, by anonymous
+	 * mmap/mremap for blocks of at least MmapThreshold bytes. Growing a large block remaps its pages
+	 * instead of copying them, so a multi-GB vector grows without a second copy of its data.
+	*/
+	template < typename T, std::size_t MmapThreshold = std::size_t( 1 ) << 20 >
+	class realloc_allocator{
+		public:
+			typedef T value_type;
+			typedef std::true_type is_always_equal;
+
+			template < typename U >
+			struct rebind{ typedef realloc_allocator< U, MmapThreshold > other; };
+
+			realloc_allocator( void ) = default;
+
+			template < typename U >
+			realloc_allocator( const realloc_allocator< U, MmapThreshold >& )
+			{ /* empty */ }
+
+			/**
+			 * obtains raw storage for n objects.
+			*/
+			T* allocate( std::size_t n )
+			{
+				std::size_t bytes = n * sizeof(T);
+				if( is_mapped( bytes ) )
+				{
+#ifdef __linux__
+					void* p = ::mmap( nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+					if( p == MAP_FAILED )
+						throw std::bad_alloc();
+					return static_cast<T*>( p );
+#endif
+				}
+				void* p = std::malloc( bytes );
+				if( p == nullptr )
+					throw std::bad_alloc();
+				return static_cast<T*>( p );
+			}
+
+			/**
+			 * returns storage obtained by allocate() or reallocate().
+			*/
+			void deallocate( T* p, std::size_t n )
+			{
+#ifdef __linux__
+				if( is_mapped( n * sizeof(T) ) )
+				{
+					::munmap( static_cast<void*>( p ), n * sizeof(T) );
+					return;
+				}
+#endif
+				std::free( static_cast<void*>( p ) );
+			}
+
+			/**
+			 * resizes the block p of old_n objects to new_n objects, keeping the bytes of the first
+			 * min(old_n, new_n) objects. Large blocks are remapped by the kernel, small ones realloc'ed.
+			*/
+			T* reallocate( T* p, std::size_t old_n, std::size_t new_n )
+			{
+				std::size_t old_bytes = old_n * sizeof(T);
+				std::size_t new_bytes = new_n * sizeof(T);
+#ifdef __linux__
+				if( is_mapped( old_bytes ) && is_mapped( new_bytes ) )
+				{
+					void* q = ::mremap( static_cast<void*>( p ), old_bytes, new_bytes, MREMAP_MAYMOVE );
+					if( q == MAP_FAILED )
+						throw std::bad_alloc();
+					return static_cast<T*>( q );
+				}
+				if( is_mapped( old_bytes ) || is_mapped( new_bytes ) )
+				{
+					// Troca de regime (heap <-> mmap): uma única cópia.
+					T* q = allocate( new_n );
+					std::memcpy( static_cast<void*>( q ), static_cast<const void*>( p ), std::min( old_bytes, new_bytes ) );
+					deallocate( p, old_n );
+					return q;
+				}
+#endif
+				void* q = std::realloc( static_cast<void*>( p ), new_bytes );
+				if( q == nullptr )
+					throw std::bad_alloc();
+				return static_cast<T*>( q );
+			}
+
+			friend bool operator==( const realloc_allocator&, const realloc_allocator& )
+			{ return true; }
+
+			friend bool operator!=( const realloc_allocator&, const realloc_allocator& )
+			{ return false; }
+
+		private:
+			static bool is_mapped( std::size_t bytes )
+			{
+#ifdef __linux__
+				return bytes >= MmapThreshold;
+#else
+				(void) bytes;
+				return false;
+#endif
+			}
+	};
+}// namespace
+#endif
@@ -0,0 +1,27 @@
+#ifndef RELOCATE_H
+#define RELOCATE_H
+#include <type_traits>
+
+namespace sc{
+	/**
+	 * Relocation trait. A type is trivially relocatable when moving an object to a new address and
+	 * ending the lifetime of the old one is equivalent to copying its bytes (memcpy/memmove) and
+	 * never calling its destructor on the old address.
+	 *
+	 * Every trivially copyable type is trivially relocatable. Many other types also are, e.g. types
+	 * that only own heap memory through a pointer, and can opt in with a specialization:
+	 *
+	 *     template<> struct sc::is_trivially_relocatable< my_buffer > : std::true_type {};
+	 *
+	 * Containers of the sc namespace check this trait at compile time to move their elements in bulk
+	 * on growth, insert and erase.
+	*/
+	template < typename T >
+	struct is_trivially_relocatable : std::is_trivially_copyable<T>
+	{ /* empty */ };
+
+	/// Helper variable template for is_trivially_relocatable.
+	template < typename T >
+	constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+}// namespace
+#endif
@@ -0,0 +1,782 @@
+#ifndef SERIALIZE_H
+#define SERIALIZE_H
+
+#include "vector.h"
+#include <algorithm> // std::min
+#include <cerrno>
+#include <cstdint>
+#include <cstring> // std::memcpy, std::memcmp
+#include <memory> // std::unique_ptr
+#include <stdexcept> // std::runtime_error
+#include <string>
+#include <system_error> // std::system_error
+#include <type_traits>
+#include <utility>
+#include <fcntl.h> // open
+#include <sys/uio.h> // writev
+#include <unistd.h> // read, write, pwrite, lseek, close
+
+/**
+ * Binary save/load of sc::vector and streaming of records to and from a file descriptor.
+ *
+ * File layout: a 24-byte sc::io::header (magic "SCVE", format version, writer byte order, element size,
+ * element count) followed by the elements. Elements whose sc::serializer is "bulk" (every trivially
+ * copyable type) are stored as raw bytes, so save() is a single writev and load() a single read straight
+ * into the vector storage. Other types (std::string, nested sc::vector, user specializations of
+ * sc::serializer) are written one by one through a buffered sc::io::writer.
+*/
+namespace sc{
+namespace io{
+	/// Byte order of the machine that wrote a file.
+	enum class byte_order : std::uint8_t{ little = 1, big = 2 };
+
+	/**
+	 * returns the byte order of this machine.
+	*/
+	inline byte_order host_byte_order( void )
+	{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+		return byte_order::big;
+#else
+		return byte_order::little;
+#endif
+	}
+
+	constexpr std::uint16_t format_version = 1; //!< Version written by this code; newer files are rejected.
+	constexpr std::uint64_t unknown_count = ~std::uint64_t( 0 ); //!< Count of a stream that could not be patched (e.g. a pipe).
+	constexpr std::uint8_t element_wise = 1; //!< header::flags bit: elements were written by sc::serializer, not as raw bytes.
+
+	/// First 24 bytes of every file. Multi-byte fields are in the writer's byte order.
+	struct header{
+		char magic[4]; //!< "SCVE".
+		std::uint16_t version; //!< Format version (format_version).
+		std::uint8_t order; //!< sc::io::byte_order of the writer.
+		std::uint8_t flags; //!< element_wise or 0.
+		std::uint32_t element_size; //!< sizeof(T) of the writer.
+		std::uint32_t reserved; //!< Zero.
+		std::uint64_t count; //!< Number of elements, or unknown_count.
+	};
+	static_assert( sizeof(header) == 24, "sc::io::header must have no padding" );
+
+	/// Most bytes moved by one read()/write() call (Linux caps a single call a little below 2 GiB).
+	constexpr std::size_t max_io = std::size_t( 1 ) << 30;
+
+	/**
+	 * writes the iovcnt buffers of iov to fd, resuming after partial writes and EINTR.
+	 * @throws std::system_error on any other error.
+	*/
+	inline void writev_all( int fd, struct iovec* iov, int iovcnt )
+	{
+		while( iovcnt > 0 )
+		{
+			ssize_t done = ::writev( fd, iov, iovcnt );
+			if( done < 0 )
+			{
+				if( errno == EINTR ) continue;
+				throw std::system_error( errno, std::generic_category(), "sc::io: write" );
+			}
+			std::size_t left = static_cast<std::size_t>( done );
+			while( iovcnt > 0 && left >= iov->iov_len )
+			{
+				left -= iov->iov_len;
+				++iov;
+				--iovcnt;
+			}
+			if( iovcnt > 0 )
+			{
+				iov->iov_base = static_cast<char*>( iov->iov_base ) + left;
+				iov->iov_len -= left;
+			}
+		}
+	}
+
+	/**
+	 * writes head (small) followed by the bytes of data with as few writev calls as possible:
+	 * up to 16 chunks of max_io bytes per call.
+	*/
+	inline void write_blocks( int fd, const void* head, std::size_t head_bytes, const void* data, std::size_t bytes )
+	{
+		const char* p = static_cast<const char*>( data );
+		struct iovec iov[17];
+		int n = 0;
+		if( head_bytes != 0 )
+			iov[n++] = { const_cast<void*>( head ), head_bytes };
+		do {
+			for( ; n < 17 && bytes > 0; n++ )
+			{
+				std::size_t chunk = std::min( bytes, max_io );
+				iov[n] = { const_cast<char*>( p ), chunk };
+				p += chunk;
+				bytes -= chunk;
+			}
+			writev_all( fd, iov, n );
+			n = 0;
+		} while( bytes > 0 );
+	}
+
+	/**
+	 * reads up to bytes bytes from fd into data, stopping early only at end of file.
+	 * @return the number of bytes read.
+	*/
+	inline std::size_t read_full( int fd, void* data, std::size_t bytes )
+	{
+		char* p = static_cast<char*>( data );
+		std::size_t total = 0;
+		while( total < bytes )
+		{
+			ssize_t got = ::read( fd, p + total, std::min( bytes - total, max_io ) );
+			if( got < 0 )
+			{
+				if( errno == EINTR ) continue;
+				throw std::system_error( errno, std::generic_category(), "sc::io: read" );
+			}
+			if( got == 0 ) break;
+			total += static_cast<std::size_t>( got );
+		}
+		return total;
+	}
+
+	/**
+	 * reverses the bytes of n arithmetic values in place (files written on a machine of the other byte order).
+	*/
+	template < typename T >
+	void byteswap( T* p, std::size_t n )
+	{
+		static_assert( std::is_arithmetic<T>::value, "sc::io::byteswap needs an arithmetic type" );
+		if constexpr ( sizeof(T) == 1 )
+		{
+			(void) p;
+			(void) n;
+		}
+		else
+		{
+			for( std::size_t i = 0; i < n; i++ )
+			{
+				unsigned char bytes[sizeof(T)];
+				std::memcpy( bytes, p + i, sizeof(T) );
+				std::reverse( bytes, bytes + sizeof(T) );
+				std::memcpy( p + i, bytes, sizeof(T) );
+			}
+		}
+	}
+
+	/**
+	 * Buffered writer used for element-wise serialization and streaming. Small writes are copied into
+	 * a fixed buffer that is written out when full; writes at least as large as the buffer go straight
+	 * to the file descriptor. Memory use is bounded by the buffer size.
+	*/
+	class writer{
+		public:
+			explicit writer( int fd, std::size_t capacity = std::size_t( 1 ) << 16 ):
+				m_fd{ fd },
+				m_buffer{ new char[capacity] },
+				m_capacity{ capacity },
+				m_used{ 0 }
+			{ /* empty */ }
+
+			writer( const writer& ) = delete;
+			writer& operator=( const writer& ) = delete;
+
+			/**
+			 * appends bytes bytes of data to the output.
+			*/
+			void write( const void* data, std::size_t bytes )
+			{
+				if( bytes == 0 ) return;
+				if( bytes > m_capacity - m_used )
+				{
+					flush();
+					if( bytes >= m_capacity )
+					{
+						write_blocks( m_fd, nullptr, 0, data, bytes );
+						return;
+					}
+				}
+				std::memcpy( m_buffer.get() + m_used, data, bytes );
+				m_used += bytes;
+			}
+
+			/**
+			 * writes the buffered bytes to the file descriptor.
+			*/
+			void flush( void )
+			{
+				if( m_used == 0 ) return;
+				write_blocks( m_fd, nullptr, 0, m_buffer.get(), m_used );
+				m_used = 0;
+			}
+
+			int fd( void ) const
+			{ return m_fd; }
+
+		private:
+			int m_fd;
+			std::unique_ptr<char[]> m_buffer;
+			std::size_t m_capacity;
+			std::size_t m_used; //!< Bytes waiting in m_buffer.
+	};
+
+	/**
+	 * Buffered reader, the counterpart of sc::io::writer. finish() gives back to a seekable file
+	 * descriptor the bytes that were read ahead but not consumed.
+	*/
+	class reader{
+		public:
+			explicit reader( int fd, std::size_t capacity = std::size_t( 1 ) << 16 ):
+				m_fd{ fd },
+				m_buffer{ new char[capacity] },
+				m_capacity{ capacity },
+				m_pos{ 0 },
+				m_end{ 0 }
+			{ /* empty */ }
+
+			reader( const reader& ) = delete;
+			reader& operator=( const reader& ) = delete;
+
+			/**
+			 * reads up to bytes bytes, stopping early only at end of file.
+			 * @return the number of bytes read.
+			*/
+			std::size_t read_some( void* data, std::size_t bytes )
+			{
+				if( bytes == 0 ) return 0;
+				char* out = static_cast<char*>( data );
+				std::size_t got = std::min( bytes, m_end - m_pos );
+				std::memcpy( out, m_buffer.get() + m_pos, got );
+				m_pos += got;
+				if( bytes - got >= m_capacity )
+					return got + read_full( m_fd, out + got, bytes - got );
+				while( got < bytes )
+				{
+					refill();
+					if( m_end == 0 ) break;
+					std::size_t more = std::min( bytes - got, m_end );
+					std::memcpy( out + got, m_buffer.get(), more );
+					m_pos = more;
+					got += more;
+				}
+				return got;
+			}
+
+			/**
+			 * reads exactly bytes bytes.
+			 * @throws std::runtime_error if the file ends first.
+			*/
+			void read( void* data, std::size_t bytes )
+			{
+				if( read_some( data, bytes ) != bytes )
+					throw std::runtime_error( "sc::io: unexpected end of file" );
+			}
+
+			/**
+			 * returns true if there is nothing left to read.
+			*/
+			bool at_end( void )
+			{
+				if( m_pos == m_end )
+					refill();
+				return m_pos == m_end;
+			}
+
+			/**
+			 * moves the file offset back over the bytes read ahead, if the file descriptor is seekable.
+			*/
+			void finish( void )
+			{
+				if( m_end != m_pos )
+					(void) ::lseek( m_fd, -static_cast<off_t>( m_end - m_pos ), SEEK_CUR );
+				m_pos = m_end = 0;
+			}
+
+		private:
+			int m_fd;
+			std::unique_ptr<char[]> m_buffer;
+			std::size_t m_capacity;
+			std::size_t m_pos; //!< Next unread byte of m_buffer.
+			std::size_t m_end; //!< End of the valid bytes of m_buffer.
+
+			void refill( void )
+			{
+				m_pos = 0;
+				m_end = 0;
+				for( ;; )
+				{
+					ssize_t got = ::read( m_fd, m_buffer.get(), m_capacity );
+					if( got < 0 )
+					{
+						if( errno == EINTR ) continue;
+						throw std::system_error( errno, std::generic_category(), "sc::io: read" );
+					}
+					m_end = static_cast<std::size_t>( got );
+					return;
+				}
+			}
+	};
+
+	/// File descriptor owned for the duration of a save()/load() by path.
+	class file{
+		public:
+			file( const std::string& path, int flags ):
+				m_fd{ ::open( path.c_str(), flags | O_CLOEXEC, 0644 ) }
+			{
+				if( m_fd < 0 )
+					throw std::system_error( errno, std::generic_category(), "sc::io: open " + path );
+			}
+
+			file( const file& ) = delete;
+			file& operator=( const file& ) = delete;
+
+			~file()
+			{ ::close( m_fd ); }
+
+			int fd( void ) const
+			{ return m_fd; }
+
+		private:
+			int m_fd;
+	};
+
+	/**
+	 * Gives the serialization code access to the raw storage of sc::vector, so bulk data is read
+	 * straight into place with no value-initialization pass.
+	*/
+	struct access{
+		/**
+		 * makes room for n more elements (growth policy capacity) and returns where they go. Nothing is constructed.
+		*/
+		template < typename T, typename A, typename G, typename I >
+		static T* append_uninitialized( sc::vector<T, A, G, I>& v, std::size_t n )
+		{
+			if( v.m_size + n > v.m_capacity )
+				v.reserve( G::next_capacity( v.m_capacity, v.m_size + n ) );
+			return v.m_data + v.m_size;
+		}
+
+		/**
+		 * marks n elements written after append_uninitialized() as part of the list (trivially copyable T only).
+		*/
+		template < typename T, typename A, typename G, typename I >
+		static void commit( sc::vector<T, A, G, I>& v, std::size_t n )
+		{ v.m_size += n; }
+	};
+}// namespace io
+
+	/**
+	 * How one T is written and read. bulk == true means T is stored as its raw bytes (and whole arrays are
+	 * moved with one system call); otherwise save()/load() are called for every element. Specialize it for
+	 * your own types:
+	 *
+	 *     template<> struct sc::serializer<point>{
+	 *         static constexpr bool bulk = false;
+	 *         static void save( sc::io::writer& w, const point& p );
+	 *         static void load( sc::io::reader& r, point& p );
+	 *     };
+	*/
+	template < typename T, typename = void >
+	struct serializer;
+
+	/// Trivially copyable types: raw bytes.
+	template < typename T >
+	struct serializer< T, typename std::enable_if< std::is_trivially_copyable<T>::value >::type >{
+		static constexpr bool bulk = true;
+
+		static void save( io::writer& w, const T& value )
+		{ w.write( &value, sizeof(T) ); }
+
+		static void load( io::reader& r, T& value )
+		{ r.read( &value, sizeof(T) ); }
+	};
+
+	/// Strings of trivially copyable characters: 64-bit length, then the characters.
+	template < typename C, typename Traits, typename A >
+	struct serializer< std::basic_string<C, Traits, A>, typename std::enable_if< std::is_trivially_copyable<C>::value >::type >{
+		static constexpr bool bulk = false;
+
+		static void save( io::writer& w, const std::basic_string<C, Traits, A>& s )
+		{
+			std::uint64_t length = s.size();
+			w.write( &length, sizeof length );
+			w.write( s.data(), s.size() * sizeof(C) );
+		}
+
+		static void load( io::reader& r, std::basic_string<C, Traits, A>& s )
+		{
+			std::uint64_t length = 0;
+			r.read( &length, sizeof length );
+			s.resize( static_cast<std::size_t>( length ) );
+			r.read( &s[0], s.size() * sizeof(C) );
+		}
+	};
+
+	/// Nested lists: 64-bit count, then the elements.
+	template < typename T, typename A, typename G, typename I >
+	struct serializer< sc::vector<T, A, G, I>, void >{
+		static constexpr bool bulk = false;
+
+		static void save( io::writer& w, const sc::vector<T, A, G, I>& v )
+		{
+			std::uint64_t count = v.size();
+			w.write( &count, sizeof count );
+			if constexpr ( serializer<T>::bulk )
+				w.write( v.data(), v.size() * sizeof(T) );
+			else
+				for( const T& x : v )
+					serializer<T>::save( w, x );
+		}
+
+		static void load( io::reader& r, sc::vector<T, A, G, I>& v )
+		{
+			std::uint64_t count = 0;
+			r.read( &count, sizeof count );
+			v.clear();
+			v.reserve( static_cast<std::size_t>( count ) );
+			if constexpr ( serializer<T>::bulk )
+			{
+				r.read( io::access::append_uninitialized( v, count ), count * sizeof(T) );
+				io::access::commit( v, count );
+			}
+			else
+				for( std::uint64_t i = 0; i < count; i++ )
+				{
+					T x;
+					serializer<T>::load( r, x );
+					v.push_back( std::move( x ) );
+				}
+		}
+	};
+
+namespace io{
+	/**
+	 * builds the header describing count elements of type T.
+	*/
+	template < typename T >
+	header make_header( std::uint64_t count )
+	{
+		header h;
+		std::memcpy( h.magic, "SCVE", 4 );
+		h.version = format_version;
+		h.order = static_cast<std::uint8_t>( host_byte_order() );
+		h.flags = serializer<T>::bulk ? 0 : element_wise;
+		h.element_size = sizeof(T);
+		h.reserved = 0;
+		h.count = count;
+		return h;
+	}
+
+	/**
+	 * checks that h describes elements of type T that this machine can read. Header fields are converted
+	 * to host byte order.
+	 * @return true if the elements must be byte-swapped after reading.
+	 * @throws std::runtime_error if the data is not a sc::vector file, is of a newer version, or was written
+	 *         for another element type or layout.
+	*/
+	template < typename T >
+	bool check_header( header& h )
+	{
+		if( std::memcmp( h.magic, "SCVE", 4 ) != 0 )
+			throw std::runtime_error( "sc::io: not a sc::vector file" );
+		if( h.order != static_cast<std::uint8_t>( byte_order::little ) && h.order != static_cast<std::uint8_t>( byte_order::big ) )
+			throw std::runtime_error( "sc::io: corrupt header" );
+		bool swap = ( h.order != static_cast<std::uint8_t>( host_byte_order() ) );
+		if( swap )
+		{
+			byteswap( &h.version, 1 );
+			byteswap( &h.element_size, 1 );
+			byteswap( &h.count, 1 );
+		}
+		if( h.version == 0 || h.version > format_version )
+			throw std::runtime_error( "sc::io: unsupported format version " + std::to_string( h.version ) );
+		if( h.element_size != sizeof(T) )
+			throw std::runtime_error( "sc::io: element size is " + std::to_string( h.element_size ) + ", expected " + std::to_string( sizeof(T) ) );
+		if( ( h.flags & element_wise ) != ( serializer<T>::bulk ? 0 : element_wise ) )
+			throw std::runtime_error( "sc::io: the file was written with another serializer for this element type" );
+		if( swap && !( serializer<T>::bulk && std::is_arithmetic<T>::value ) )
+			throw std::runtime_error( "sc::io: the file was written with the other byte order" );
+		return swap;
+	}
+
+	/**
+	 * reads and checks the header at the current offset of fd (see check_header).
+	*/
+	template < typename T >
+	bool read_header( int fd, header& h )
+	{
+		if( read_full( fd, &h, sizeof h ) != sizeof h )
+			throw std::runtime_error( "sc::io: not a sc::vector file" );
+		return check_header<T>( h );
+	}
+
+	/**
+	 * byte-swaps n elements when swap is set (only possible for arithmetic T, see check_header).
+	*/
+	template < typename T >
+	void fix_byte_order( T* p, std::size_t n, bool swap )
+	{
+		if constexpr ( std::is_arithmetic<T>::value )
+		{
+			if( swap )
+				byteswap( p, n );
+		}
+		else
+		{
+			(void) p;
+			(void) n;
+			(void) swap;
+		}
+	}
+}// namespace io
+
+	/**
+	 * writes v to fd at its current offset: header, then the elements. Bulk element types go out with a
+	 * single writev (in 1 GiB chunks beyond that size).
+	 * @throws std::system_error if a write fails.
+	*/
+	template < typename T, typename A, typename G, typename I >
+	void save( int fd, const sc::vector<T, A, G, I>& v )
+	{
+		io::header h = io::make_header<T>( v.size() );
+		if constexpr ( serializer<T>::bulk )
+			io::write_blocks( fd, &h, sizeof h, v.data(), v.size() * sizeof(T) );
+		else
+		{
+			io::writer w( fd );
+			w.write( &h, sizeof h );
+			for( const T& x : v )
+				serializer<T>::save( w, x );
+			w.flush();
+		}
+	}
+
+	/**
+	 * writes v to the file path, replacing it.
+	*/
+	template < typename T, typename A, typename G, typename I >
+	void save( const std::string& path, const sc::vector<T, A, G, I>& v )
+	{
+		io::file f( path, O_WRONLY | O_CREAT | O_TRUNC );
+		save( f.fd(), v );
+	}
+
+	/**
+	 * replaces the contents of v with the list stored at the current offset of fd (by save() or by a
+	 * sc::stream_writer). Bulk element types are read with one read() straight into the storage of v.
+	 * @throws std::runtime_error if the data is not a compatible sc::vector file or is truncated;
+	 *         std::system_error if a read fails.
+	*/
+	template < typename T, typename A, typename G, typename I >
+	void load( int fd, sc::vector<T, A, G, I>& v )
+	{
+		io::header h;
+		bool swap = io::read_header<T>( fd, h );
+		v.clear();
+		if constexpr ( serializer<T>::bulk )
+		{
+			if( h.count != io::unknown_count )
+			{
+				std::size_t count = static_cast<std::size_t>( h.count );
+				v.reserve( count );
+				T* p = io::access::append_uninitialized( v, count );
+				if( io::read_full( fd, p, count * sizeof(T) ) != count * sizeof(T) )
+					throw std::runtime_error( "sc::io: unexpected end of file" );
+				io::fix_byte_order( p, count, swap );
+				io::access::commit( v, count );
+				return;
+			}
+			// Fluxo sem contagem (escrito num pipe): ler em lotes até o fim.
+			const std::size_t batch = ( std::size_t( 1 ) << 20 ) / sizeof(T) + 1;
+			for( ;; )
+			{
+				T* p = io::access::append_uninitialized( v, batch );
+				std::size_t got = io::read_full( fd, p, batch * sizeof(T) );
+				if( got % sizeof(T) != 0 )
+					throw std::runtime_error( "sc::io: unexpected end of file" );
+				io::fix_byte_order( p, got / sizeof(T), swap );
+				io::access::commit( v, got / sizeof(T) );
+				if( got < batch * sizeof(T) )
+					return;
+			}
+		}
+		else
+		{
+			io::reader r( fd );
+			for( std::uint64_t i = 0; i < h.count && ( h.count != io::unknown_count || !r.at_end() ); i++ )
+			{
+				T x;
+				serializer<T>::load( r, x );
+				v.push_back( std::move( x ) );
+			}
+			r.finish();
+		}
+	}
+
+	/**
+	 * replaces the contents of v with the list stored in the file path.
+	*/
+	template < typename T, typename A, typename G, typename I >
+	void load( const std::string& path, sc::vector<T, A, G, I>& v )
+	{
+		io::file f( path, O_RDONLY );
+		load( f.fd(), v );
+	}
+
+	/**
+	 * Writes a list of unknown length to a file descriptor with bounded memory: elements are buffered and
+	 * written in batches of batch_bytes. The result has the save() format, so load() reads it back; the
+	 * element count in the header is filled in by close() when fd is seekable (for a pipe it stays
+	 * io::unknown_count and readers stop at end of file).
+	*/
+	template < typename T >
+	class stream_writer{
+		public:
+			explicit stream_writer( int fd, std::size_t batch_bytes = std::size_t( 1 ) << 20 ):
+				m_out{ fd, batch_bytes },
+				m_header_at{ ::lseek( fd, 0, SEEK_CUR ) },
+				m_count{ 0 },
+				m_open{ true }
+			{
+				io::header h = io::make_header<T>( io::unknown_count );
+				m_out.write( &h, sizeof h );
+			}
+
+			stream_writer( const stream_writer& ) = delete;
+			stream_writer& operator=( const stream_writer& ) = delete;
+
+			/**
+			 * closes the stream; errors are ignored here, call close() to see them.
+			*/
+			~stream_writer()
+			{
+				try {
+					close();
+				}
+				catch( ... ) { /* empty */ }
+			}
+
+			/**
+			 * appends one element.
+			*/
+			void push_back( const T& value )
+			{
+				serializer<T>::save( m_out, value );
+				m_count++;
+			}
+
+			/**
+			 * appends count elements starting at first (one write for bulk types when count is large).
+			*/
+			void append( const T* first, std::size_t count )
+			{
+				if constexpr ( serializer<T>::bulk )
+					m_out.write( first, count * sizeof(T) );
+				else
+					for( std::size_t i = 0; i < count; i++ )
+						serializer<T>::save( m_out, first[i] );
+				m_count += count;
+			}
+
+			/**
+			 * appends every element of v.
+			*/
+			template < typename A, typename G, typename I >
+			void append( const sc::vector<T, A, G, I>& v )
+			{ append( v.data(), v.size() ); }
+
+			/**
+			 * writes the buffered elements to the file descriptor.
+			*/
+			void flush( void )
+			{ m_out.flush(); }
+
+			/**
+			 * flushes and, if the file descriptor is seekable, records the final count in the header.
+			*/
+			void close( void )
+			{
+				if( !m_open ) return;
+				m_open = false;
+				m_out.flush();
+				if( m_header_at < 0 ) return;
+				io::header h = io::make_header<T>( m_count );
+				if( ::pwrite( m_out.fd(), &h, sizeof h, m_header_at ) != static_cast<ssize_t>( sizeof h ) )
+					throw std::system_error( errno, std::generic_category(), "sc::io: pwrite" );
+			}
+
+			/**
+			 * returns the number of elements appended so far.
+			*/
+			std::uint64_t size( void ) const
+			{ return m_count; }
+
+		private:
+			io::writer m_out;
+			off_t m_header_at; //!< Offset of the header, or -1 if fd cannot seek.
+			std::uint64_t m_count;
+			bool m_open;
+	};
+
+	/**
+	 * Reads a list written by save() or sc::stream_writer in batches, appending at most a given number
+	 * of elements to a sc::vector per call, so a file larger than memory can be processed piecewise.
+	*/
+	template < typename T >
+	class stream_reader{
+		public:
+			/**
+			 * reads and checks the header.
+			 * @throws std::runtime_error if the data is not a compatible sc::vector file.
+			*/
+			explicit stream_reader( int fd, std::size_t buffer_bytes = std::size_t( 1 ) << 20 ):
+				m_in{ fd, buffer_bytes }
+			{
+				io::header h;
+				m_in.read( &h, sizeof h );
+				m_swap = io::check_header<T>( h );
+				m_remaining = h.count;
+			}
+
+			/**
+			 * appends up to max elements to out.
+			 * @return the number of elements appended; 0 once the list is exhausted.
+			*/
+			template < typename A, typename G, typename I >
+			std::size_t read( sc::vector<T, A, G, I>& out, std::size_t max )
+			{
+				std::size_t want = ( m_remaining < max ) ? static_cast<std::size_t>( m_remaining ) : max;
+				std::size_t got = 0;
+				if constexpr ( serializer<T>::bulk )
+				{
+					T* p = io::access::append_uninitialized( out, want );
+					std::size_t bytes = m_in.read_some( p, want * sizeof(T) );
+					if( bytes % sizeof(T) != 0 || ( bytes < want * sizeof(T) && m_remaining != io::unknown_count ) )
+						throw std::runtime_error( "sc::io: unexpected end of file" );
+					got = bytes / sizeof(T);
+					io::fix_byte_order( p, got, m_swap );
+					io::access::commit( out, got );
+				}
+				else
+				{
+					for( ; got < want && ( m_remaining != io::unknown_count || !m_in.at_end() ); got++ )
+					{
+						T x;
+						serializer<T>::load( m_in, x );
+						out.push_back( std::move( x ) );
+					}
+				}
+				if( m_remaining != io::unknown_count )
+					m_remaining -= got;
+				return got;
+			}
+
+			/**
+			 * returns the number of elements not read yet, or io::unknown_count for a stream written to a pipe.
+			*/
+			std::uint64_t remaining( void ) const
+			{ return m_remaining; }
+
+		private:
+			io::reader m_in;
+			std::uint64_t m_remaining; //!< Elements left, or io::unknown_count.
+			bool m_swap; //!< Elements were written with the other byte order.
+	};
+}// namespace sc
+#endif
@@ -0,0 +1,305 @@
+#ifndef SIMD_H
+#define SIMD_H
+#include <algorithm> // std::find, std::count, std::min_element, std::max_element
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // std::memcmp, std::memcpy
+#include <type_traits>
+
+/**
+ * Vectorized comparison and search kernels over contiguous arrays, with runtime dispatch between
+ * SSE2, AVX2 and AVX-512 (x86 with GCC) and the standard algorithms as the scalar fallback.
+ *
+ * Raw kernels live in sc::simd and take pointers; the sc:: free functions at the end of the file take
+ * any contiguous container with data() and size() (sc::vector, sc::small_vector, sc::devector, ...).
+*/
+#if defined(__GNUC__) && !defined(__clang__) && ( defined(__x86_64__) || defined(__i386__) )
+#define SC_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace sc{
+	/**
+	 * Types whose operator== is the same as comparing their bytes, so equality may use memcmp.
+	 * Integers, enums and pointers qualify; padding-free user types may opt in with a specialization.
+	*/
+	template < typename T >
+	struct is_bitwise_comparable
+		: std::integral_constant< bool, std::is_integral<T>::value || std::is_enum<T>::value || std::is_pointer<T>::value >
+	{ /* empty */ };
+
+	namespace simd{
+		/// Instruction sets known to the dispatcher, in increasing order.
+		enum class isa { scalar = 0, sse2, avx2, avx512 };
+
+		/**
+		 * Types handled by the vector kernels: arithmetic types of 1, 2, 4 or 8 bytes, except bool.
+		*/
+		template < typename T >
+		struct is_vectorizable
+			: std::integral_constant< bool, std::is_arithmetic<T>::value && !std::is_same<T, bool>::value
+			                                && ( sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8 ) >
+		{ /* empty */ };
+
+		/**
+		 * best instruction set supported by this CPU (checked once).
+		*/
+		inline isa detected_isa( void )
+		{
+#ifdef SC_SIMD_X86
+			static const isa level = []{
+				__builtin_cpu_init();
+				if( __builtin_cpu_supports( "avx512f" ) && __builtin_cpu_supports( "avx512bw" ) ) return isa::avx512;
+				if( __builtin_cpu_supports( "avx2" ) ) return isa::avx2;
+				if( __builtin_cpu_supports( "sse2" ) ) return isa::sse2;
+				return isa::scalar;
+			}();
+			return level;
+#else
+			return isa::scalar;
+#endif
+		}
+
+		/**
+		 * upper bound for the dispatcher, e.g. to compare instruction sets in a benchmark or to avoid
+		 * AVX-512 frequency drops. Set it before starting threads that use the kernels.
+		*/
+		inline isa& isa_limit( void )
+		{
+			static isa limit = isa::avx512;
+			return limit;
+		}
+
+		/**
+		 * instruction set the kernels dispatch to: the detected one, capped by isa_limit().
+		*/
+		inline isa active_isa( void )
+		{ return std::min( detected_isa(), isa_limit() ); }
+
+		namespace detail{
+			template < typename T, std::size_t Bytes >
+			struct vector_of{ typedef T type __attribute__(( vector_size( Bytes ) )); };
+
+#ifdef SC_SIMD_X86
+#pragma GCC push_options
+#pragma GCC target("sse2")
+			namespace sse2{
+#define SC_SIMD_BYTES 16
+#define SC_SIMD_MOVEMASK( m ) static_cast<std::uint64_t>( static_cast<unsigned>( _mm_movemask_epi8( (__m128i)( m ) ) ) )
+#include "simd_kernels.h"
+#undef SC_SIMD_MOVEMASK
+#undef SC_SIMD_BYTES
+			}
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx2")
+			namespace avx2{
+#define SC_SIMD_BYTES 32
+#define SC_SIMD_MOVEMASK( m ) static_cast<std::uint64_t>( static_cast<unsigned>( _mm256_movemask_epi8( (__m256i)( m ) ) ) )
+#include "simd_kernels.h"
+#undef SC_SIMD_MOVEMASK
+#undef SC_SIMD_BYTES
+			}
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx512f,avx512bw")
+			namespace avx512{
+#define SC_SIMD_BYTES 64
+#define SC_SIMD_MOVEMASK( m ) static_cast<std::uint64_t>( _mm512_movepi8_mask( (__m512i)( m ) ) )
+#include "simd_kernels.h"
+#undef SC_SIMD_MOVEMASK
+#undef SC_SIMD_BYTES
+			}
+#pragma GCC pop_options
+
+/// Calls detail::<isa>::KERNEL for the active instruction set, if any.
+#define SC_SIMD_DISPATCH( KERNEL, ... ) \
+			switch( sc::simd::active_isa() ) \
+			{ \
+				case sc::simd::isa::avx512: return sc::simd::detail::avx512::KERNEL( __VA_ARGS__ ); \
+				case sc::simd::isa::avx2: return sc::simd::detail::avx2::KERNEL( __VA_ARGS__ ); \
+				case sc::simd::isa::sse2: return sc::simd::detail::sse2::KERNEL( __VA_ARGS__ ); \
+				default: break; \
+			}
+#else
+#define SC_SIMD_DISPATCH( KERNEL, ... )
+#endif
+		}// namespace detail
+
+		/**
+		 * returns a pointer to the first element of [first, last) equal to value, or last.
+		*/
+		template < typename T >
+		const T* find( const T* first, const T* last, const T& value )
+		{
+			if constexpr ( is_vectorizable<T>::value )
+			{
+				SC_SIMD_DISPATCH( find, first, last, value )
+			}
+			return std::find( first, last, value );
+		}
+
+		/**
+		 * returns how many elements of [first, last) are equal to value.
+		*/
+		template < typename T >
+		std::size_t count( const T* first, const T* last, const T& value )
+		{
+			if constexpr ( is_vectorizable<T>::value )
+			{
+				SC_SIMD_DISPATCH( count, first, last, value )
+			}
+			return static_cast<std::size_t>( std::count( first, last, value ) );
+		}
+
+		/**
+		 * returns the index of the first position where a[i] == b[i] is false, or n.
+		*/
+		template < typename T >
+		std::size_t mismatch( const T* a, const T* b, std::size_t n )
+		{
+			if( a == b ) return n;
+			if constexpr ( is_vectorizable<T>::value )
+			{
+				SC_SIMD_DISPATCH( mismatch, a, b, n )
+			}
+			return static_cast<std::size_t>( std::mismatch( a, a + n, b ).first - a );
+		}
+
+		/**
+		 * returns true if a[i] == b[i] for every i < n. Bitwise comparable types go through memcmp
+		 * (itself vectorized by the C library); floating point uses the vector kernels, so NaN != NaN.
+		*/
+		template < typename T >
+		bool equal( const T* a, const T* b, std::size_t n )
+		{
+			if( a == b || n == 0 ) return true;
+			if constexpr ( sc::is_bitwise_comparable<T>::value )
+				return std::memcmp( static_cast<const void*>( a ), static_cast<const void*>( b ), n * sizeof(T) ) == 0;
+			else
+				return mismatch( a, b, n ) == n;
+		}
+
+		/**
+		 * returns a pointer to the first smallest element of [first, last), or last if it is empty.
+		 * For floating point the result is unspecified if the range holds a NaN.
+		*/
+		template < typename T >
+		const T* min_element( const T* first, const T* last )
+		{
+			if constexpr ( is_vectorizable<T>::value )
+			{
+				if( last - first >= 128 )
+				{
+					T best = *first;
+					switch( active_isa() )
+					{
+#ifdef SC_SIMD_X86
+						case isa::avx512: best = detail::avx512::extreme<true>( first, last ); break;
+						case isa::avx2: best = detail::avx2::extreme<true>( first, last ); break;
+						case isa::sse2: best = detail::sse2::extreme<true>( first, last ); break;
+#endif
+						default: return std::min_element( first, last );
+					}
+					const T* pos = sc::simd::find( first, last, best );
+					if( pos != last )
+						return pos;
+				}
+			}
+			return std::min_element( first, last );
+		}
+
+		/**
+		 * returns a pointer to the first largest element of [first, last), or last if it is empty.
+		 * For floating point the result is unspecified if the range holds a NaN.
+		*/
+		template < typename T >
+		const T* max_element( const T* first, const T* last )
+		{
+			if constexpr ( is_vectorizable<T>::value )
+			{
+				if( last - first >= 128 )
+				{
+					T best = *first;
+					switch( active_isa() )
+					{
+#ifdef SC_SIMD_X86
+						case isa::avx512: best = detail::avx512::extreme<false>( first, last ); break;
+						case isa::avx2: best = detail::avx2::extreme<false>( first, last ); break;
+						case isa::sse2: best = detail::sse2::extreme<false>( first, last ); break;
+#endif
+						default: return std::max_element( first, last );
+					}
+					const T* pos = sc::simd::find( first, last, best );
+					if( pos != last )
+						return pos;
+				}
+			}
+			return std::max_element( first, last );
+		}
+
+		/**
+		 * returns true if [a, a+na) is lexicographically less than [b, b+nb).
+		*/
+		template < typename T >
+		bool lexicographical_compare( const T* a, std::size_t na, const T* b, std::size_t nb )
+		{
+			std::size_t n = std::min( na, nb );
+			std::size_t i = 0;
+			while( ( i += sc::simd::mismatch( a + i, b + i, n - i ) ) < n )
+			{
+				if( a[i] < b[i] ) return true;
+				if( b[i] < a[i] ) return false;
+				i++; // Nem menor nem maior (e.g. NaN): seguir adiante.
+			}
+			return na < nb;
+		}
+	}// namespace simd
+
+	/**
+	 * returns true if both contiguous containers hold the same elements.
+	*/
+	template < typename Container >
+	bool equal( const Container& a, const Container& b )
+	{ return a.size() == b.size() && sc::simd::equal( a.data(), b.data(), a.size() ); }
+
+	/**
+	 * returns an iterator to the first element of c equal to value, or c.end().
+	*/
+	template < typename Container >
+	typename Container::const_iterator find( const Container& c, const typename Container::value_type& value )
+	{ return c.cbegin() + ( sc::simd::find( c.data(), c.data() + c.size(), value ) - c.data() ); }
+
+	/**
+	 * returns how many elements of c are equal to value.
+	*/
+	template < typename Container >
+	std::size_t count( const Container& c, const typename Container::value_type& value )
+	{ return sc::simd::count( c.data(), c.data() + c.size(), value ); }
+
+	/**
+	 * returns an iterator to the first smallest element of c, or c.end() if c is empty.
+	*/
+	template < typename Container >
+	typename Container::const_iterator min_element( const Container& c )
+	{ return c.cbegin() + ( sc::simd::min_element( c.data(), c.data() + c.size() ) - c.data() ); }
+
+	/**
+	 * returns an iterator to the first largest element of c, or c.end() if c is empty.
+	*/
+	template < typename Container >
+	typename Container::const_iterator max_element( const Container& c )
+	{ return c.cbegin() + ( sc::simd::max_element( c.data(), c.data() + c.size() ) - c.data() ); }
+
+	/**
+	 * returns true if a is lexicographically less than b.
+	*/
+	template < typename Container >
+	bool lexicographical_compare( const Container& a, const Container& b )
+	{ return sc::simd::lexicographical_compare( a.data(), a.size(), b.data(), b.size() ); }
+}// namespace
+
+#undef SC_SIMD_DISPATCH
+#endif
@@ -0,0 +1,127 @@
+/**
+ * Vectorized kernels used by simd.h. This file has no include guard on purpose: simd.h includes it
+ * once per instruction set, inside a "#pragma GCC target" region and a namespace of its own, after
+ * defining
+ *
+ *   SC_SIMD_BYTES        width of one vector register, in bytes;
+ *   SC_SIMD_MOVEMASK(m)  expression turning a lane mask m into a std::uint64_t with one bit per byte.
+ *
+ * Do not include it directly.
+*/
+
+/// Width of one vector, in bytes.
+constexpr std::size_t bytes = SC_SIMD_BYTES;
+
+/// Vector of T filling one register.
+template < typename T >
+using vec = typename sc::simd::detail::vector_of< T, bytes >::type;
+
+/// Lane mask produced by comparing two vec<T>.
+template < typename T >
+using mask = decltype( vec<T>{} == vec<T>{} );
+
+template < typename T >
+inline vec<T> load( const T* p )
+{
+	vec<T> v;
+	std::memcpy( &v, p, bytes );
+	return v;
+}
+
+/**
+ * one bit per byte of m, set when the byte belongs to a true lane.
+*/
+template < typename T >
+inline std::uint64_t movemask( mask<T> m )
+{ return SC_SIMD_MOVEMASK( m ); }
+
+/**
+ * returns a pointer to the first element equal to value in [first, last), or last.
+*/
+template < typename T >
+const T* find( const T* first, const T* last, T value )
+{
+	constexpr std::ptrdiff_t lanes = bytes / sizeof(T);
+	const vec<T> splat = vec<T>{} + value;
+	for( ; last - first >= lanes; first += lanes )
+	{
+		std::uint64_t m = movemask<T>( load( first ) == splat );
+		if( m != 0 )
+			return first + __builtin_ctzll( m ) / sizeof(T);
+	}
+	for( ; first != last; ++first )
+		if( *first == value )
+			return first;
+	return last;
+}
+
+/**
+ * returns how many elements of [first, last) are equal to value.
+*/
+template < typename T >
+std::size_t count( const T* first, const T* last, T value )
+{
+	constexpr std::ptrdiff_t lanes = bytes / sizeof(T);
+	// Cada contador de lane tem sizeof(T) bytes: esvaziar antes de transbordar.
+	constexpr std::size_t max_rounds = ( sizeof(T) == 1 ) ? 127 : ( sizeof(T) == 2 ) ? 32767 : 0x7fffffff;
+	const vec<T> splat = vec<T>{} + value;
+	std::size_t total = 0;
+	while( last - first >= lanes )
+	{
+		mask<T> acc = mask<T>{};
+		std::size_t rounds = std::min( max_rounds, static_cast<std::size_t>( ( last - first ) / lanes ) );
+		for( std::size_t r = 0; r < rounds; r++, first += lanes )
+			acc -= ( load( first ) == splat );
+		for( std::ptrdiff_t k = 0; k < lanes; k++ )
+			total += static_cast<std::size_t>( acc[k] );
+	}
+	for( ; first != last; ++first )
+		if( *first == value )
+			total++;
+	return total;
+}
+
+/**
+ * returns the index of the first position where a and b differ (by operator==), or n.
+*/
+template < typename T >
+std::size_t mismatch( const T* a, const T* b, std::size_t n )
+{
+	constexpr std::size_t lanes = bytes / sizeof(T);
+	std::size_t i = 0;
+	for( ; i + lanes <= n; i += lanes )
+	{
+		std::uint64_t m = movemask<T>( load( a + i ) != load( b + i ) );
+		if( m != 0 )
+			return i + __builtin_ctzll( m ) / sizeof(T);
+	}
+	for( ; i < n; i++ )
+		if( !( a[i] == b[i] ) )
+			return i;
+	return n;
+}
+
+/**
+ * returns the smallest (Less = true) or largest value of [first, last), which holds at least one
+ * vector of elements.
+*/
+template < bool Less, typename T >
+T extreme( const T* first, const T* last )
+{
+	constexpr std::ptrdiff_t lanes = bytes / sizeof(T);
+	vec<T> best = load( first );
+	const T* p = first + lanes;
+	for( ; last - p >= lanes; p += lanes )
+	{
+		vec<T> v = load( p );
+		best = ( Less ? v < best : best < v ) ? v : best;
+	}
+	T result = best[0];
+	for( std::ptrdiff_t k = 1; k < lanes; k++ )
+		if( Less ? best[k] < result : result < best[k] )
+			result = best[k];
+	for( ; p != last; ++p )
+		if( Less ? *p < result : result < *p )
+			result = *p;
+	return result;
+}
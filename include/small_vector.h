@@ -0,0 +1,895 @@
+#ifndef SMALL_VECTOR_H
+#define SMALL_VECTOR_H
+
+#include "iterator.h"
+#include "relocate.h"
+#include "simd.h"
+#include <iterator>
+#include <algorithm> //std::copy, std::move_backward
+#include <initializer_list> // std::initializer_list
+#include <stdexcept>//std::out_of_range
+#include <memory> // std::allocator, std::allocator_traits
+#include <ostream>
+#include <type_traits>
+#include <cstring> // std::memcpy, std::memmove
+
+namespace sc {
+
+/**
+ * Sequence container with the interface of sc::vector whose first N elements live inside the object itself.
+ * The heap (through Allocator) is only used once the list grows beyond N elements, so short lists never allocate.
+*/
+template< typename T, std::size_t N, typename Allocator = std::allocator<T> >
+class small_vector{
+	static_assert( N > 0, "sc::small_vector needs room for at least one inline element" );
+
+	public:
+		typedef T value_type; //!< Type of the elements stored in the list.
+		typedef Allocator allocator_type; //!< Allocator used once the list spills to the heap.
+		typedef std::size_t size_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef T& reference;
+		typedef const T& const_reference;
+		typedef T* pointer;
+		typedef const T* const_pointer;
+		typedef sc::iterator<T> iterator; //!< Contiguous iterator.
+		typedef sc::const_iterator<T> const_iterator; //!< Contiguous read-only iterator.
+		typedef std::reverse_iterator<iterator> reverse_iterator;
+		typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+		static constexpr size_t inline_capacity = N; //!< Number of elements stored without allocating.
+
+	private:
+		typedef std::allocator_traits<Allocator> alloc_traits;
+		static_assert( std::is_same< typename alloc_traits::pointer, T* >::value,
+		               "sc::small_vector requires an allocator whose pointer type is T*" );
+
+		/// Elements can be moved around as raw bytes (see sc::is_trivially_relocatable).
+		static constexpr bool trivially_relocatable = sc::is_trivially_relocatable<T>::value;
+
+		allocator_type m_alloc; //!< Allocator that owns the heap storage area.
+		T * m_data; //!< Either the inline buffer or a heap block (only [0, m_size) is constructed).
+		size_t m_size; //!< Current list size (or index past-last valid element).
+		size_t m_capacity; //!< List’s storage capacity, N while the list is inline.
+		alignas(T) unsigned char m_buffer[ N * sizeof(T) ]; //!< Inline storage for the first N elements.
+
+	public:
+		//=== [I] SPECIAL MEMBERS
+
+		/**
+		 * Constructs an empty list with room for at least count elements. Nothing is allocated if count <= N.
+		 *  @param count  the number of elements to reserve room for.
+		 *  @param alloc  allocator used if the list spills to the heap.
+		*/
+		small_vector( size_t count=0, const Allocator& alloc = Allocator() ):
+			m_alloc{ alloc },
+			m_data{ inline_data() },
+			m_size{ 0 },
+			m_capacity{ N }
+		{ reserve( count ); }
+
+		/**
+		 * Constructs the list with the contents of the range [first, last) . Input ranges, which can be
+		 * read only once, are appended element by element.
+		 *  @param first first element of the range to copy the elements from.
+		 *  @param last  the position just after the last element of the range.
+		*/
+		template< typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category >
+		small_vector( InputIt first, InputIt last, const Allocator& alloc = Allocator() ):
+			small_vector( 0, alloc )
+		{
+			typedef typename std::iterator_traits<InputIt>::iterator_category category;
+			if constexpr ( std::is_base_of< std::forward_iterator_tag, category >::value )
+			{
+				reserve( static_cast<size_t>( std::distance( first, last ) ) );
+				init_copy( first, last );
+			}
+			else
+			{
+				try {
+					for( ; first != last; ++first )
+						emplace_back( *first );
+				}
+				catch( ... ) {
+					clear();
+					release(); // o destrutor não roda se o construtor lança.
+					throw;
+				}
+			}
+		}
+
+		/**
+		 *Copy constructor. Constructs the list with the deep copy of the contents of other .
+		 *  @param other  another list to be used as source to initialize the elements of the list with.
+		*/
+		small_vector( const small_vector& other ):
+			small_vector( 0, alloc_traits::select_on_container_copy_construction( other.m_alloc ) )
+		{
+			reserve( other.m_size );
+			init_copy( other.m_data, other.m_data + other.m_size );
+		}
+
+		/**
+		 *Move constructor. A heap block is stolen; inline elements are relocated one by one.
+		 *other is left empty.
+		 *  @param other  another list whose contents are taken over.
+		*/
+		small_vector( small_vector&& other ) noexcept( std::is_nothrow_move_constructible<T>::value ):
+			small_vector( 0, other.m_alloc )
+		{ take( other ); }
+
+		/**
+		 * Constructs the list with the contents of the initializer list init .
+		 *  @param ilist initializer list to initialize the elements of the list with.
+		*/
+		small_vector( std::initializer_list<T> ilist, const Allocator& alloc = Allocator() ):
+			small_vector( ilist.begin(), ilist.end(), alloc )
+		{ /*empty*/ }
+
+		/**
+		 * Destructs the list. The destructors of the elements are called and heap storage, if any, is deallocated.
+		*/
+		~small_vector()
+		{
+			destroy( m_data, m_data + m_size );
+			release();
+		}
+
+		/**
+		 *Copy assignment operator. Replaces the contents with a copy of the contents of other.
+		*/
+		small_vector& operator=( const small_vector& other )
+		{
+			if( this == &other ) return *this;
+			clear();
+			if constexpr ( alloc_traits::propagate_on_container_copy_assignment::value )
+			{
+				if( !( m_alloc == other.m_alloc ) )
+					release();
+				m_alloc = other.m_alloc;
+			}
+			reserve( other.m_size );
+			init_copy( other.m_data, other.m_data + other.m_size );
+			return *this;
+		}
+
+		/**
+		 *Move assignment operator. Replaces the contents with those of other using move semantics.
+		 *other is left empty. Does not throw if the allocator propagates or is always equal (a heap block
+		 *is then stolen) and moving T does not throw (inline elements are moved one by one).
+		*/
+		small_vector& operator=( small_vector&& other ) noexcept( ( alloc_traits::propagate_on_container_move_assignment::value
+		                                                            || alloc_traits::is_always_equal::value )
+		                                                          && std::is_nothrow_move_constructible<T>::value )
+		{
+			if( this == &other ) return *this;
+			clear();
+			if constexpr ( alloc_traits::propagate_on_container_move_assignment::value )
+			{
+				release();
+				m_alloc = std::move( other.m_alloc );
+			}
+			take( other );
+			return *this;
+		}
+
+		/**
+		 *Replaces the contents with those identiﬁed by initializer list ilist .
+		*/
+		small_vector& operator=( std::initializer_list<T> ilist )
+		{
+			assign( ilist );
+			return *this;
+		}
+
+		/**
+		 * returns the allocator associated with the container.
+		*/
+		allocator_type get_allocator( void ) const
+		{ return m_alloc; }
+
+		//=== [II] ITERATORS
+		/**
+		 *returns an iterator pointing to the ﬁrst item in the list.
+		*/
+		iterator begin( void )
+		{ return iterator( m_data ); }
+
+		/**
+		 * returns an iterator pointing to the end mark in the list.
+		*/
+		iterator end( void )
+		{ return iterator( m_data + m_size ); }
+
+		/**
+		 *returns a constant iterator pointing to the ﬁrst item in the list.
+		*/
+		const_iterator begin( void )const
+		{ return const_iterator( m_data ); }
+
+		/**
+		 * returns a constant iterator pointing to the end mark in the list.
+		*/
+		const_iterator end( void )const
+		{ return const_iterator( m_data + m_size ); }
+
+		/**
+		 * returns a constant iterator pointing to the ﬁrst item in the list.
+		*/
+		const_iterator cbegin( void )const
+		{ return const_iterator( m_data ); }
+
+		/**
+		 * returns a constant iterator pointing to the end mark in the list.
+		*/
+		const_iterator cend( void )const
+		{ return const_iterator( m_data + m_size ); }
+
+		/**
+		 * returns a reverse iterator pointing to the last item in the list.
+		*/
+		reverse_iterator rbegin( void )
+		{ return reverse_iterator( end() ); }
+
+		/**
+		 * returns a reverse iterator pointing to the position just before the first item in the list.
+		*/
+		reverse_iterator rend( void )
+		{ return reverse_iterator( begin() ); }
+
+		/**
+		 * returns a constant reverse iterator pointing to the last item in the list.
+		*/
+		const_reverse_iterator crbegin( void )const
+		{ return const_reverse_iterator( cend() ); }
+
+		/**
+		 * returns a constant reverse iterator pointing to the position just before the first item in the list.
+		*/
+		const_reverse_iterator crend( void )const
+		{ return const_reverse_iterator( cbegin() ); }
+
+		//=== [III] Capacity
+
+		/**
+		 *return the number of elements in the container.
+		*/
+		size_t size( void )const
+		{ return m_size; }
+
+		/**
+		 * return the internal storage capacity of the array (at least N).
+		*/
+		size_t capacity( void )const
+		{ return m_capacity; }
+
+		/**
+		 * returns true if the container contains no elements, and false otherwise.
+		*/
+		bool empty( void )const
+		{ return m_size == 0; }
+
+		/**
+		 * returns true while the elements are stored in the inline buffer, i.e. no heap memory is in use.
+		*/
+		bool is_inline( void )const
+		{ return m_data == inline_data(); }
+
+		//=== [IV] Modifiers
+		/**
+		 *remove all elements from the container, calling their destructors. The capacity is kept.
+		*/
+		void clear( void )
+		{
+			destroy( m_data, m_data + m_size );
+			m_size = 0;
+		}
+
+		/**
+		 * adds value to the front of the list.
+		*/
+		void push_front( const T& value )
+		{ emplace( cbegin(), value ); }
+
+		/**
+		 * adds value to the front of the list, moving it into place.
+		*/
+		void push_front( T&& value )
+		{ emplace( cbegin(), std::move( value ) ); }
+
+		/**
+		 * adds value to the end of the list.
+		*/
+		void push_back( const T& value )
+		{ emplace_back( value ); }
+
+		/**
+		 * adds value to the end of the list, moving it into place.
+		*/
+		void push_back( T&& value )
+		{ emplace_back( std::move( value ) ); }
+
+		/**
+		 * removes the object at the end of the list.
+		*/
+		void pop_back( void )
+		{
+			if( empty() ) return;
+			m_size--;
+			alloc_traits::destroy( m_alloc, m_data + m_size );
+		}
+
+		/**
+		 * removes the object at the front of the list.
+		*/
+		void pop_front( void )
+		{
+			if( empty() ) return;
+			erase( cbegin() );
+		}
+
+		/**
+		 *increase the storage capacity to a value that’s is greater or equal to new_cap .
+		 If new_cap is greater than the current capacity() the elements move to a heap block and
+		 all iterators and references are invalidated. Otherwise the method does nothing.
+		 * @param new_cap new capacity for the list.
+		*/
+		void reserve( size_t new_cap )
+		{
+			if ( new_cap <= m_capacity ) return;
+			T *temp = alloc_traits::allocate( m_alloc, new_cap );
+			try {
+				uninitialized_relocate( m_data, m_data + m_size, temp );
+			}
+			catch( ... ) {
+				alloc_traits::deallocate( m_alloc, temp, new_cap );
+				throw;
+			}
+			release();
+			m_data = temp;
+			m_capacity = new_cap;
+		}
+
+		/**
+		 * adds value into the list before the position given by the iterator pos .
+		*/
+		iterator insert( const_iterator pos, const T& value )
+		{ return emplace( pos, value ); }
+
+		/**
+		 * moves value into the list before the position given by the iterator pos .
+		*/
+		iterator insert( const_iterator pos, T&& value )
+		{ return emplace( pos, std::move( value ) ); }
+
+		/**
+		 * inserts elements from the range [first; last) before pos . Input ranges, which can be read only
+		 * once, are appended directly at the end, or read into a buffer first elsewhere.
+		*/
+		template < typename InItr, typename = typename std::iterator_traits<InItr>::iterator_category >
+		iterator insert( const_iterator pos, InItr first, InItr last )
+		{
+			size_t idx = pos - cbegin();
+			typedef typename std::iterator_traits<InItr>::iterator_category category;
+			if constexpr ( !std::is_base_of< std::forward_iterator_tag, category >::value )
+			{
+				if( idx == m_size )
+				{
+					for( ; first != last; ++first )
+						emplace_back( *first );
+					return iterator( m_data + idx );
+				}
+				small_vector buffer( 0, m_alloc );
+				for( ; first != last; ++first )
+					buffer.emplace_back( *first );
+				return insert( pos, std::make_move_iterator( buffer.begin() ), std::make_move_iterator( buffer.end() ) );
+			}
+			size_t range = static_cast<size_t>( std::distance( first, last ) );
+			if( range == 0 )
+				return iterator( m_data + idx );
+			if( m_size+range > m_capacity )
+				reserve( std::max( 2*m_capacity, m_size+range ) );
+
+			T* p = m_data + idx;
+			T* old_end = m_data + m_size;
+			size_t elems_after = m_size - idx;
+			if constexpr ( trivially_relocatable )
+			{
+				// Abrir o espaço com um único memmove e construir a faixa nele.
+				std::memmove( static_cast<void*>( p + range ), static_cast<const void*>( p ), elems_after * sizeof(T) );
+				T* cur = p;
+				try {
+					for( ; first != last; ++first, ++cur )
+						alloc_traits::construct( m_alloc, cur, *first );
+				}
+				catch( ... ) {
+					destroy( p, cur );
+					std::memmove( static_cast<void*>( p ), static_cast<const void*>( p + range ), elems_after * sizeof(T) );
+					throw;
+				}
+			}
+			else if( elems_after > range )
+			{
+				uninitialized_copy( std::make_move_iterator( old_end - range ), std::make_move_iterator( old_end ), old_end );
+				m_size += range;
+				std::move_backward( p, old_end - range, old_end );
+				std::copy( first, last, p );
+				return iterator( m_data + idx );
+			}
+			else
+			{
+				InItr mid = first;
+				std::advance( mid, elems_after );
+				T* cur = uninitialized_copy( mid, last, old_end );
+				try {
+					uninitialized_copy( std::make_move_iterator( p ), std::make_move_iterator( old_end ), cur );
+				}
+				catch( ... ) {
+					destroy( old_end, cur );
+					throw;
+				}
+				std::copy( first, mid, p );
+			}
+			m_size += range;
+			return iterator( m_data + idx );
+		}
+
+		/**
+		 *inserts elements from the initializer list ilist before pos .
+		*/
+		iterator insert( const_iterator pos, std::initializer_list<T> ilist )
+		{ return insert( pos, ilist.begin(), ilist.end() ); }
+
+		/**
+		 * Constructs and insert one element before the position given by the iterator pos.
+		 * The method returns an iterator to the position of the inserted item.
+		*/
+		template< class... Args>
+		iterator emplace( const_iterator pos, Args&&... args )
+		{
+			size_t idx = pos - cbegin();
+			if( m_size == m_capacity )
+			{
+				realloc_emplace( idx, std::forward<Args>(args)... );
+			}
+			else if( idx == m_size )
+			{
+				alloc_traits::construct( m_alloc, m_data + m_size, std::forward<Args>(args)... );
+				m_size++;
+			}
+			else if constexpr ( trivially_relocatable )
+			{
+				// args pode referenciar um elemento da própria lista: construir antes de deslocar.
+				alignas(T) unsigned char buffer[sizeof(T)];
+				T* temp = reinterpret_cast<T*>( buffer );
+				alloc_traits::construct( m_alloc, temp, std::forward<Args>(args)... );
+				std::memmove( static_cast<void*>( m_data + idx + 1 ), static_cast<const void*>( m_data + idx ), ( m_size - idx ) * sizeof(T) );
+				std::memcpy( static_cast<void*>( m_data + idx ), static_cast<const void*>( temp ), sizeof(T) );
+				m_size++;
+			}
+			else
+			{
+				T temp( std::forward<Args>(args)... );
+				alloc_traits::construct( m_alloc, m_data + m_size, std::move( m_data[m_size-1] ) );
+				m_size++;
+				std::move_backward( m_data + idx, m_data + m_size - 2, m_data + m_size - 1 );
+				m_data[idx] = std::move( temp );
+			}
+			return iterator( m_data + idx );
+		}
+
+		/**
+		 * Constructs and insert one element into the end of the list.
+		*/
+		template< class... Args>
+		void emplace_back( Args&&... args )
+		{
+			if( m_size == m_capacity )
+			{
+				realloc_emplace( m_size, std::forward<Args>(args)... );
+				return;
+			}
+			alloc_traits::construct( m_alloc, m_data + m_size, std::forward<Args>(args)... );
+			m_size++;
+		}
+
+		/**
+		 * Requests the removal of unused capacity. A heap list that fits in N elements moves back inline.
+		*/
+		void shrink_to_fit( void )
+		{
+			if( is_inline() || m_size == m_capacity ) return;
+
+			T* temp = ( m_size <= N ) ? inline_data() : alloc_traits::allocate( m_alloc, m_size );
+			try {
+				uninitialized_relocate( m_data, m_data + m_size, temp );
+			}
+			catch( ... ) {
+				if( temp != inline_data() )
+					alloc_traits::deallocate( m_alloc, temp, m_size );
+				throw;
+			}
+			release();
+			m_data = temp;
+			m_capacity = ( m_size <= N ) ? N : m_size;
+		}
+
+		/**
+		 *Replaces the contents with count copies of value value .
+		*/
+		void assign( size_t count, const T& value )
+		{
+			clear();
+			reserve( count );
+			for( ; m_size < count; m_size++ )
+				alloc_traits::construct( m_alloc, m_data + m_size, value );
+		}
+
+		/**
+		 * replaces the contents of the list with copies of the elements in the range [first; last) .
+		*/
+		template < typename InItr, typename = typename std::iterator_traits<InItr>::iterator_category >
+		void assign( InItr first, InItr last )
+		{
+			clear();
+			typedef typename std::iterator_traits<InItr>::iterator_category category;
+			if constexpr ( std::is_base_of< std::forward_iterator_tag, category >::value )
+			{
+				reserve( static_cast<size_t>( std::distance( first, last ) ) );
+				init_copy( first, last );
+			}
+			else
+				for( ; first != last; ++first )
+					emplace_back( *first );
+		}
+
+		/**
+		 * replaces the contents of the list with the elements from the initializer list ilist .
+		*/
+		void assign( std::initializer_list<T> ilist )
+		{ assign( ilist.begin(), ilist.end() ); }
+
+		/**
+		 *removes the object at position pos . The method returns an iterator to the element that follows pos before the call.
+		*/
+		iterator erase( const_iterator pos )
+		{ return erase( pos, pos + 1 ); }
+
+		/**
+		 * removes elements in the range [first; last) .
+		*/
+		iterator erase( const_iterator first, const_iterator last )
+		{
+			size_t idx = first - cbegin();
+			size_t count = last - first;
+			if( count == 0 )
+				return iterator( m_data + idx );
+			if constexpr ( trivially_relocatable )
+			{
+				destroy( m_data + idx, m_data + idx + count );
+				std::memmove( static_cast<void*>( m_data + idx ), static_cast<const void*>( m_data + idx + count ), ( m_size - idx - count ) * sizeof(T) );
+			}
+			else
+			{
+				T* new_end = std::move( m_data + idx + count, m_data + m_size, m_data + idx );
+				destroy( new_end, m_data + m_size );
+			}
+			m_size -= count;
+			return iterator( m_data + idx );
+		}
+
+		/**
+		 * exchanges the contents of this list with those of other. Heap blocks are swapped in constant
+		 * time; inline elements are swapped or relocated one by one.
+		*/
+		void swap( small_vector& other )
+		{
+			if( this == &other ) return;
+			if constexpr ( alloc_traits::propagate_on_container_swap::value )
+			{
+				using std::swap;
+				swap( m_alloc, other.m_alloc );
+			}
+			if( !is_inline() && !other.is_inline() )
+			{
+				std::swap( m_data, other.m_data );
+				std::swap( m_size, other.m_size );
+				std::swap( m_capacity, other.m_capacity );
+			}
+			else if( is_inline() && other.is_inline() )
+			{
+				small_vector& longer = ( m_size >= other.m_size ) ? *this : other;
+				small_vector& shorter = ( m_size >= other.m_size ) ? other : *this;
+				using std::swap;
+				for( size_t i = 0; i < shorter.m_size; i++ )
+					swap( m_data[i], other.m_data[i] );
+				uninitialized_relocate( longer.m_data + shorter.m_size, longer.m_data + longer.m_size, shorter.m_data + shorter.m_size );
+				std::swap( m_size, other.m_size );
+			}
+			else
+			{
+				// Um está no heap e o outro inline: o inline vai para o buffer do outro, que herda o bloco.
+				small_vector& heap = is_inline() ? other : *this;
+				small_vector& small = is_inline() ? *this : other;
+				T* block = heap.m_data;
+				size_t block_cap = heap.m_capacity;
+				uninitialized_relocate( small.m_data, small.m_data + small.m_size, heap.inline_data() );
+				heap.m_data = heap.inline_data();
+				heap.m_capacity = N;
+				small.m_data = block;
+				small.m_capacity = block_cap;
+				std::swap( m_size, other.m_size );
+			}
+		}
+
+		// [V] Element access
+
+		/**
+		 * returns a pointer to the contiguous storage, inline or on the heap.
+		*/
+		T* data( void )
+		{ return m_data; }
+
+		/**
+		 * returns a pointer to the contiguous storage, inline or on the heap.
+		*/
+		const T* data( void ) const
+		{ return m_data; }
+
+		/**
+		 * returns the object at the end of the list.
+		*/
+		const T& back( void ) const
+		{ return m_data[m_size-1]; }
+
+		/**
+		 * returns the object at the end of the list.
+		*/
+		T& back( void )
+		{ return m_data[m_size-1]; }
+
+		/**
+		 *returns the object at the beginning of the list.
+		*/
+		const T& front( void ) const
+		{ return m_data[0]; }
+
+		/**
+		 *returns the object at the beginning of the list.
+		*/
+		T& front( void )
+		{ return m_data[0]; }
+
+		/**
+		 *returns the object at the index pos in the array, with no bounds-checking.
+		*/
+		T& operator[]( size_t pos )const{ return m_data[pos]; }
+
+		/**
+		 *returns the object at the index pos in the array, with bounds-checking.
+		*/
+		T at( size_t pos )const
+		{
+			if ( pos >= m_size )
+				throw std::out_of_range( "[small_vector::at() const] out of range error" );
+			return m_data[ pos ];
+		}
+
+		/**
+		 *returns the object at the index pos in the array, with bounds-checking.
+		*/
+		T& at( size_t pos )
+		{
+			if ( pos >= m_size )
+				throw std::out_of_range( "[small_vector::at()] out of range error" );
+			return m_data[ pos ];
+		}
+
+		//=== [VII] Friend functions.
+
+		/**
+		 * extraction operator overload. Only the constructed elements [0, size()) are printed.
+		*/
+		friend std::ostream& operator<<( std::ostream& os, const small_vector& v )
+		{
+			os << "[ ";
+			std::copy( v.m_data, v.m_data + v.m_size, std::ostream_iterator<T>( os, " " ));
+			os << "]";
+			return os;
+		}
+
+		/**
+		 * exchanges the contents of A and B.
+		*/
+		friend void swap( small_vector& A, small_vector& B )
+		{ A.swap( B ); }
+
+	private:
+		//=== [VIII] Raw storage helpers.
+
+		T* inline_data( void )
+		{ return reinterpret_cast<T*>( m_buffer ); }
+
+		const T* inline_data( void ) const
+		{ return reinterpret_cast<const T*>( m_buffer ); }
+
+		/**
+		 * returns the heap block, if any, to the allocator. The list points back to the inline buffer.
+		*/
+		void release( void )
+		{
+			if( !is_inline() )
+				alloc_traits::deallocate( m_alloc, m_data, m_capacity );
+			m_data = inline_data();
+			m_capacity = N;
+		}
+
+		/**
+		 * moves the contents of other, which must not be this list, into this empty list.
+		 * other ends empty and inline.
+		*/
+		void take( small_vector& other )
+		{
+			if( !other.is_inline() && ( m_alloc == other.m_alloc ) )
+			{
+				release();
+				m_data = other.m_data;
+				m_size = other.m_size;
+				m_capacity = other.m_capacity;
+				other.m_data = other.inline_data();
+				other.m_size = 0;
+				other.m_capacity = N;
+				return;
+			}
+			reserve( other.m_size );
+			if constexpr ( trivially_relocatable )
+				uninitialized_relocate( other.m_data, other.m_data + other.m_size, m_data );
+			else
+			{
+				uninitialized_copy( std::make_move_iterator( other.m_data ), std::make_move_iterator( other.m_data + other.m_size ), m_data );
+				other.destroy( other.m_data, other.m_data + other.m_size );
+			}
+			m_size = other.m_size;
+			other.m_size = 0;
+		}
+
+		/**
+		 * calls the destructor of every object in [first, last).
+		*/
+		void destroy( T* first, T* last )
+		{
+			for( ; first != last; ++first )
+				alloc_traits::destroy( m_alloc, first );
+		}
+
+		/**
+		 * copy-constructs [first, last) into the raw memory at dest, destroying what was built if a constructor throws.
+		*/
+		template< typename InputIt >
+		T* uninitialized_copy( InputIt first, InputIt last, T* dest )
+		{
+			T* cur = dest;
+			try {
+				for( ; first != last; ++first, ++cur )
+					alloc_traits::construct( m_alloc, cur, *first );
+			}
+			catch( ... ) {
+				destroy( dest, cur );
+				throw;
+			}
+			return cur;
+		}
+
+		/**
+		 * relocates [first, last) into the raw memory at dest (memcpy or move_if_noexcept, see sc::vector).
+		 * On exception [first, last) is intact.
+		*/
+		T* uninitialized_relocate( T* first, T* last, T* dest )
+		{
+			if constexpr ( trivially_relocatable )
+			{
+				if( first != last )
+					std::memcpy( static_cast<void*>( dest ), static_cast<const void*>( first ), ( last - first ) * sizeof(T) );
+				return dest + ( last - first );
+			}
+			else
+			{
+				T* end = uninitialized_move_if_noexcept( first, last, dest );
+				destroy( first, last );
+				return end;
+			}
+		}
+
+		/**
+		 * move-constructs (or copies, if the move may throw) [first, last) into the raw memory at dest.
+		 * The sources are left alive; on exception [first, last) is intact.
+		*/
+		T* uninitialized_move_if_noexcept( T* first, T* last, T* dest )
+		{
+			T* cur = dest;
+			try {
+				for( ; first != last; ++first, ++cur )
+					alloc_traits::construct( m_alloc, cur, std::move_if_noexcept( *first ) );
+			}
+			catch( ... ) {
+				destroy( dest, cur );
+				throw;
+			}
+			return cur;
+		}
+
+		/**
+		 * fills an empty list, whose storage is already big enough, with copies of [first, last).
+		*/
+		template< typename InputIt >
+		void init_copy( InputIt first, InputIt last )
+		{
+			try {
+				for( ; first != last; ++first, ++m_size )
+					alloc_traits::construct( m_alloc, m_data + m_size, *first );
+			}
+			catch( ... ) {
+				clear();
+				throw;
+			}
+		}
+
+		/**
+		 * moves the list to a heap block twice as large and constructs a new element at index idx,
+		 * before relocating the old elements around it. On exception the list is unchanged.
+		*/
+		template< class... Args >
+		void realloc_emplace( size_t idx, Args&&... args )
+		{
+			size_t new_cap = 2 * m_capacity;
+			T* temp = alloc_traits::allocate( m_alloc, new_cap );
+			T* cur = temp;
+			try {
+				alloc_traits::construct( m_alloc, temp + idx, std::forward<Args>(args)... );
+				if constexpr ( trivially_relocatable )
+				{
+					uninitialized_relocate( m_data, m_data + idx, temp );
+					uninitialized_relocate( m_data + idx, m_data + m_size, temp + idx + 1 );
+				}
+				else
+				{
+					try {
+						cur = uninitialized_move_if_noexcept( m_data, m_data + idx, temp );
+						uninitialized_move_if_noexcept( m_data + idx, m_data + m_size, temp + idx + 1 );
+					}
+					catch( ... ) {
+						destroy( temp, cur );
+						alloc_traits::destroy( m_alloc, temp + idx );
+						throw;
+					}
+				}
+			}
+			catch( ... ) {
+				alloc_traits::deallocate( m_alloc, temp, new_cap );
+				throw;
+			}
+			if constexpr ( !trivially_relocatable )
+				destroy( m_data, m_data + m_size );
+			release();
+			m_data = temp;
+			m_size++;
+			m_capacity = new_cap;
+		}
+};
+
+/**
+ * Checks if the contents of lhs and rhs are equal.
+*/
+template< typename T, std::size_t N, typename Alloc >
+bool operator==( const sc::small_vector<T, N, Alloc>& lhs, const sc::small_vector<T, N, Alloc>& rhs )
+{ return lhs.size() == rhs.size() && sc::simd::equal( lhs.data(), rhs.data(), lhs.size() ); }
+
+/**
+ * Similar to the previous operator, but the opposite result.
+*/
+template< typename T, std::size_t N, typename Alloc >
+bool operator!=( const sc::small_vector<T, N, Alloc>& lhs, const sc::small_vector<T, N, Alloc>& rhs )
+{ return !( lhs == rhs ); }
+}//namespace
+
+#endif
@@ -0,0 +1,662 @@
+#ifndef SOA_VECTOR_H
+#define SOA_VECTOR_H
+
+#include "growth_policy.h"
+#include "relocate.h"
+#include "span.h"
+#include <algorithm> // std::max, std::move
+#include <cstddef>
+#include <cstring> // std::memcpy, std::memmove
+#include <initializer_list> // std::initializer_list
+#include <iterator>
+#include <new> // operator new( size, align_val_t )
+#include <stdexcept> // std::out_of_range, std::length_error
+#include <tuple>
+#include <type_traits>
+#include <utility> // std::index_sequence, std::forward
+
+namespace sc {
+
+/**
+ * Structure-of-arrays list: element i is the tuple ( column<0>()[i], column<1>()[i], ... ), and every
+ * column is its own contiguous array, so a loop that reads one field streams through that field only
+ * instead of dragging the whole record through the cache.
+ *
+ *     sc::soa_vector<int, double, std::string> v;
+ *     v.push_back( 1, 2.5, "a" );
+ *     double total = 0;
+ *     for( double price : v.column<1>() ) total += price;
+ *     for( auto [id, price, name] : v ) price *= 2; // the bindings refer to the stored fields.
+ *
+ * All columns live in one block, each starting on a 64-byte boundary, and grow together (capacity
+ * chosen by sc::doubling_growth), so there is one allocation and one relocation pass per growth.
+ * Trivially relocatable columns are moved with memcpy/memmove, the others are moved if that cannot
+ * throw and copied otherwise. Copies are made before anything is moved, so growth keeps the strong
+ * exception guarantee.
+ *
+ * operator[] and the iterators return proxies (std::tuple of references). They suit loops and
+ * non-permuting algorithms; algorithms that swap elements through iterators (std::sort) are not
+ * supported.
+*/
+template< typename... Ts >
+class soa_vector{
+	static_assert( sizeof...(Ts) > 0, "sc::soa_vector needs at least one column" );
+	public:
+		static constexpr std::size_t columns = sizeof...(Ts); //!< Number of columns.
+		typedef std::tuple<Ts...> value_type; //!< One element, as a tuple of its fields.
+		typedef std::tuple<Ts&...> reference; //!< Proxy to the fields of one element.
+		typedef std::tuple<const Ts&...> const_reference; //!< Read-only proxy to the fields of one element.
+		typedef std::size_t size_type;
+		typedef std::ptrdiff_t difference_type;
+
+		/// Type of column I.
+		template< std::size_t I >
+		using column_type = typename std::tuple_element<I, value_type>::type;
+
+	private:
+		/// Every column starts on a cache line, so SIMD loops over a column begin aligned.
+		static constexpr std::size_t column_alignment = std::max( { std::size_t( 64 ), alignof(Ts)... } );
+
+		typedef std::make_index_sequence<columns> indices;
+
+		unsigned char* m_block; //!< Single block holding every column (raw, only [0, m_size) is constructed).
+		std::tuple<Ts*...> m_columns; //!< First element of each column inside m_block.
+		size_t m_size; //!< Number of elements.
+		size_t m_capacity; //!< Elements each column has room for.
+
+	public:
+		/**
+		 * Random-access iterator over the elements; dereferencing yields a proxy (reference).
+		*/
+		template< bool Const >
+		class basic_iterator{
+			public:
+				typedef typename soa_vector::value_type value_type;
+				typedef typename std::conditional< Const, const_reference, soa_vector::reference >::type reference;
+				typedef void pointer;
+				typedef std::ptrdiff_t difference_type;
+				typedef std::random_access_iterator_tag iterator_category;
+			private:
+				typedef typename std::conditional< Const, const soa_vector, soa_vector >::type owner_type;
+				owner_type* m_owner;
+				size_type m_index;
+			public:
+				basic_iterator( owner_type* owner = nullptr, size_type index = 0 ): m_owner{ owner }, m_index{ index }
+				{ /* empty */ }
+
+				/**
+				 * converts a mutable iterator into a constant one.
+				*/
+				template< bool C = Const, typename = typename std::enable_if<C>::type >
+				basic_iterator( const basic_iterator<false>& other ): m_owner{ other.owner() }, m_index{ other.index() }
+				{ /* empty */ }
+
+				owner_type* owner( void )const { return m_owner; }
+				size_type index( void )const { return m_index; }
+
+				reference operator*( void )const { return ( *m_owner )[m_index]; }
+				reference operator[]( difference_type n )const { return ( *m_owner )[m_index + n]; }
+
+				basic_iterator& operator++( void ) { ++m_index; return *this; }
+				basic_iterator operator++( int ) { basic_iterator t( *this ); ++m_index; return t; }
+				basic_iterator& operator--( void ) { --m_index; return *this; }
+				basic_iterator operator--( int ) { basic_iterator t( *this ); --m_index; return t; }
+				basic_iterator& operator+=( difference_type n ) { m_index += n; return *this; }
+				basic_iterator& operator-=( difference_type n ) { m_index -= n; return *this; }
+
+				friend basic_iterator operator+( basic_iterator it, difference_type n ) { return it += n; }
+				friend basic_iterator operator+( difference_type n, basic_iterator it ) { return it += n; }
+				friend basic_iterator operator-( basic_iterator it, difference_type n ) { return it -= n; }
+				friend difference_type operator-( const basic_iterator& lhs, const basic_iterator& rhs )
+				{ return difference_type( lhs.m_index ) - difference_type( rhs.m_index ); }
+
+				friend bool operator==( const basic_iterator& lhs, const basic_iterator& rhs ) { return lhs.m_index == rhs.m_index; }
+				friend bool operator!=( const basic_iterator& lhs, const basic_iterator& rhs ) { return lhs.m_index != rhs.m_index; }
+				friend bool operator<( const basic_iterator& lhs, const basic_iterator& rhs ) { return lhs.m_index < rhs.m_index; }
+				friend bool operator>( const basic_iterator& lhs, const basic_iterator& rhs ) { return lhs.m_index > rhs.m_index; }
+				friend bool operator<=( const basic_iterator& lhs, const basic_iterator& rhs ) { return lhs.m_index <= rhs.m_index; }
+				friend bool operator>=( const basic_iterator& lhs, const basic_iterator& rhs ) { return lhs.m_index >= rhs.m_index; }
+		};
+
+		typedef basic_iterator<false> iterator;
+		typedef basic_iterator<true> const_iterator;
+
+		//=== [I] SPECIAL MEMBERS
+
+		/**
+		 * Constructs an empty list with room for count elements in every column. No object is constructed.
+		*/
+		explicit soa_vector( size_type count = 0 ):
+			m_block{ nullptr },
+			m_columns{},
+			m_size{ 0 },
+			m_capacity{ 0 }
+		{
+			m_block = allocate( count, m_columns );
+			m_capacity = count;
+		}
+
+		/**
+		 * Constructs the list with the elements of ilist.
+		*/
+		soa_vector( std::initializer_list<value_type> ilist ):
+			soa_vector( ilist.size() )
+		{
+			for( const value_type& t : ilist )
+				push_back( t );
+		}
+
+		/**
+		 * Copy constructor: copies the elements of other into a block of exactly other.size() elements.
+		*/
+		soa_vector( const soa_vector& other ):
+			soa_vector( other.m_size )
+		{
+			for( size_type i = 0; i < other.m_size; i++ )
+				push_back( other[i] );
+		}
+
+		/**
+		 * Move constructor: steals the block of other, which is left empty.
+		*/
+		soa_vector( soa_vector&& other ) noexcept:
+			m_block{ other.m_block },
+			m_columns{ other.m_columns },
+			m_size{ other.m_size },
+			m_capacity{ other.m_capacity }
+		{
+			other.m_block = nullptr;
+			other.m_columns = std::tuple<Ts*...>();
+			other.m_size = other.m_capacity = 0;
+		}
+
+		/**
+		 * Destroys the elements and releases the block.
+		*/
+		~soa_vector()
+		{
+			clear();
+			deallocate( m_block, m_capacity );
+		}
+
+		/**
+		 * Replaces the contents by a copy (or the moved contents) of other.
+		*/
+		soa_vector& operator=( soa_vector other ) noexcept
+		{
+			swap( other );
+			return *this;
+		}
+
+		//=== [II] ITERATORS
+
+		/**
+		 * returns an iterator pointing to the first element.
+		*/
+		iterator begin( void ) { return iterator( this, 0 ); }
+
+		/**
+		 * returns an iterator pointing to the position just after the last element.
+		*/
+		iterator end( void ) { return iterator( this, m_size ); }
+
+		const_iterator begin( void )const { return const_iterator( this, 0 ); }
+		const_iterator end( void )const { return const_iterator( this, m_size ); }
+		const_iterator cbegin( void )const { return begin(); }
+		const_iterator cend( void )const { return end(); }
+
+		//=== [III] CAPACITY
+
+		/**
+		 * returns the number of elements.
+		*/
+		size_type size( void )const { return m_size; }
+
+		/**
+		 * returns the number of elements every column has room for.
+		*/
+		size_type capacity( void )const { return m_capacity; }
+
+		/**
+		 * returns true if the list has no elements.
+		*/
+		bool empty( void )const { return m_size == 0; }
+
+		/**
+		 * makes room for new_cap elements in every column: one new block, one relocation pass.
+		*/
+		void reserve( size_type new_cap )
+		{
+			if( new_cap <= m_capacity ) return;
+			std::tuple<Ts*...> columns;
+			unsigned char* block = allocate( new_cap, columns );
+			relocate_into( columns, block, new_cap );
+			adopt( block, columns, new_cap );
+		}
+
+		/**
+		 * reduces capacity() to size().
+		*/
+		void shrink_to_fit( void )
+		{
+			if( m_size == m_capacity ) return;
+			std::tuple<Ts*...> columns;
+			unsigned char* block = allocate( m_size, columns );
+			relocate_into( columns, block, m_size );
+			adopt( block, columns, m_size );
+		}
+
+		//=== [IV] MODIFIERS
+
+		/**
+		 * appends an element whose column k is constructed from the k-th argument (one per column).
+		 * Arguments may refer to elements of this list.
+		*/
+		template< typename... Args >
+		void emplace_back( Args&&... args )
+		{
+			static_assert( sizeof...(Args) == columns, "sc::soa_vector::emplace_back takes one argument per column" );
+			if( m_size < m_capacity )
+			{
+				construct_at( m_columns, m_size, indices(), std::forward<Args>( args )... );
+				m_size++;
+				return;
+			}
+			// Igual ao sc::vector: o novo elemento é construído no bloco novo antes de realocar,
+			// pois os argumentos podem referenciar elementos antigos.
+			size_type new_cap = sc::doubling_growth::next_capacity( m_capacity, m_size + 1 );
+			std::tuple<Ts*...> columns;
+			unsigned char* block = allocate( new_cap, columns );
+			try {
+				construct_at( columns, m_size, indices(), std::forward<Args>( args )... );
+			}
+			catch( ... ) {
+				deallocate( block, new_cap );
+				throw;
+			}
+			try {
+				relocate_into( columns, block, new_cap, false );
+			}
+			catch( ... ) {
+				destroy_at( columns, m_size );
+				deallocate( block, new_cap );
+				throw;
+			}
+			adopt( block, columns, new_cap );
+			m_size++;
+		}
+
+		/**
+		 * appends an element made of copies of values (one per column).
+		*/
+		void push_back( const Ts&... values )
+		{ emplace_back( values... ); }
+
+		/**
+		 * appends an element whose fields are moved from values.
+		*/
+		void push_back( Ts&&... values )
+		{ emplace_back( std::move( values )... ); }
+
+		/**
+		 * appends a copy of an element given as a tuple (e.g. another list's operator[]).
+		*/
+		template< typename... Us, typename = typename std::enable_if< sizeof...(Us) == columns >::type >
+		void push_back( const std::tuple<Us...>& value )
+		{ push_tuple( value, indices() ); }
+
+		/**
+		 * removes the last element.
+		*/
+		void pop_back( void )
+		{
+			if( empty() ) return;
+			m_size--;
+			destroy_at( m_columns, m_size );
+		}
+
+		/**
+		 * removes the element at pos, shifting the following elements of every column down by one.
+		 * @return iterator to the element that followed pos.
+		*/
+		iterator erase( const_iterator pos )
+		{ return erase( pos, pos + 1 ); }
+
+		/**
+		 * removes the elements in [first, last). If moving a field throws, nothing is removed and the
+		 * elements after first are left valid but possibly moved from.
+		 * @return iterator to the element that followed the last removed one.
+		*/
+		iterator erase( const_iterator first, const_iterator last )
+		{
+			size_type idx = first.index();
+			size_type count = last.index() - idx;
+			if( count == 0 )
+				return iterator( this, idx );
+			erase_columns( idx, count );
+			m_size -= count;
+			return iterator( this, idx );
+		}
+
+		/**
+		 * destroys every element. The capacity is kept.
+		*/
+		void clear( void )
+		{
+			while( m_size > 0 )
+				destroy_at( m_columns, --m_size );
+		}
+
+		/**
+		 * exchanges the contents with other.
+		*/
+		void swap( soa_vector& other ) noexcept
+		{
+			using std::swap;
+			swap( m_block, other.m_block );
+			swap( m_columns, other.m_columns );
+			swap( m_size, other.m_size );
+			swap( m_capacity, other.m_capacity );
+		}
+
+		//=== [V] ELEMENT ACCESS
+
+		/**
+		 * returns a proxy to the fields of element i (no bounds check).
+		*/
+		reference operator[]( size_type i )
+		{ return row( i, indices() ); }
+
+		const_reference operator[]( size_type i )const
+		{ return row( i, indices() ); }
+
+		/**
+		 * returns a proxy to the fields of element i.
+		 * @throws std::out_of_range if i is not below size().
+		*/
+		reference at( size_type i )
+		{
+			if( i >= m_size )
+				throw std::out_of_range( "sc::soa_vector::at: index out of range" );
+			return ( *this )[i];
+		}
+
+		const_reference at( size_type i )const
+		{
+			if( i >= m_size )
+				throw std::out_of_range( "sc::soa_vector::at: index out of range" );
+			return ( *this )[i];
+		}
+
+		reference front( void ) { return ( *this )[0]; }
+		const_reference front( void )const { return ( *this )[0]; }
+		reference back( void ) { return ( *this )[m_size - 1]; }
+		const_reference back( void )const { return ( *this )[m_size - 1]; }
+
+		/**
+		 * returns column I as a contiguous span of size() elements, aligned to 64 bytes.
+		*/
+		template< std::size_t I >
+		sc::span< column_type<I> > column( void )
+		{ return sc::span< column_type<I> >( std::get<I>( m_columns ), m_size ); }
+
+		template< std::size_t I >
+		sc::span< const column_type<I> > column( void )const
+		{ return sc::span< const column_type<I> >( std::get<I>( m_columns ), m_size ); }
+
+		/**
+		 * returns a pointer to the first element of column I.
+		*/
+		template< std::size_t I >
+		column_type<I>* data( void )
+		{ return std::get<I>( m_columns ); }
+
+		template< std::size_t I >
+		const column_type<I>* data( void )const
+		{ return std::get<I>( m_columns ); }
+
+	private:
+		//=== [VI] Block layout and per-column helpers.
+
+		/**
+		 * calls f( std::integral_constant<std::size_t, I>() ) for every column I, in order.
+		*/
+		template< typename F, std::size_t... I >
+		static void for_each_column( F&& f, std::index_sequence<I...> )
+		{ ( f( std::integral_constant<std::size_t, I>() ), ... ); }
+
+		template< typename F >
+		static void for_each_column( F&& f )
+		{ for_each_column( std::forward<F>( f ), indices() ); }
+
+		static size_type align_up( size_type n )
+		{ return ( n + column_alignment - 1 ) / column_alignment * column_alignment; }
+
+		/**
+		 * returns the size of a block for cap elements per column and, if columns is given, the address of
+		 * every column inside base.
+		*/
+		static size_type layout( size_type cap, unsigned char* base, std::tuple<Ts*...>* columns )
+		{
+			size_type offset = 0;
+			for_each_column( [&]( auto ic ){
+				constexpr std::size_t I = decltype( ic )::value;
+				offset = align_up( offset );
+				if( columns != nullptr )
+					std::get<I>( *columns ) = reinterpret_cast< column_type<I>* >( base + offset );
+				offset += cap * sizeof( column_type<I> );
+			} );
+			return offset;
+		}
+
+		/**
+		 * obtains a block for cap elements per column and fills columns with the column addresses.
+		*/
+		static unsigned char* allocate( size_type cap, std::tuple<Ts*...>& columns )
+		{
+			columns = std::tuple<Ts*...>();
+			if( cap == 0 ) return nullptr;
+			size_type max_row = 0;
+			for_each_column( [&]( auto ic ){ max_row += sizeof( column_type< decltype( ic )::value > ) + column_alignment; } );
+			if( cap > size_type( -1 ) / max_row )
+				throw std::length_error( "sc::soa_vector: capacity too large" );
+			size_type bytes = layout( cap, nullptr, nullptr );
+			unsigned char* block = static_cast<unsigned char*>( ::operator new( bytes, std::align_val_t( column_alignment ) ) );
+			layout( cap, block, &columns );
+			return block;
+		}
+
+		static void deallocate( unsigned char* block, size_type cap )
+		{
+			if( block != nullptr )
+				::operator delete( block, layout( cap, nullptr, nullptr ), std::align_val_t( column_alignment ) );
+		}
+
+		template< std::size_t... I >
+		reference row( size_type i, std::index_sequence<I...> )
+		{ return reference( std::get<I>( m_columns )[i]... ); }
+
+		template< std::size_t... I >
+		const_reference row( size_type i, std::index_sequence<I...> )const
+		{ return const_reference( std::get<I>( m_columns )[i]... ); }
+
+		template< typename Tuple, std::size_t... I >
+		void push_tuple( const Tuple& value, std::index_sequence<I...> )
+		{ emplace_back( std::get<I>( value )... ); }
+
+		/**
+		 * constructs the fields of element i of columns from args, one per column. If a constructor throws,
+		 * the fields already built are destroyed.
+		*/
+		template< std::size_t... I, typename... Args >
+		static void construct_at( std::tuple<Ts*...>& columns, size_type i, std::index_sequence<I...>, Args&&... args )
+		{
+			std::size_t built = 0;
+			try {
+				( ( ::new( static_cast<void*>( std::get<I>( columns ) + i ) ) column_type<I>( std::forward<Args>( args ) ), ++built ), ... );
+			}
+			catch( ... ) {
+				for_each_column( [&]( auto ic ){
+					constexpr std::size_t K = decltype( ic )::value;
+					typedef column_type<K> U;
+					if( K < built )
+						std::get<K>( columns )[i].~U();
+				} );
+				throw;
+			}
+		}
+
+		/**
+		 * destroys the fields of element i of columns.
+		*/
+		static void destroy_at( std::tuple<Ts*...>& columns, size_type i )
+		{
+			for_each_column( [&]( auto ic ){
+				constexpr std::size_t I = decltype( ic )::value;
+				typedef column_type<I> U;
+				std::get<I>( columns )[i].~U();
+			} );
+		}
+
+		/// Column type U is relocated by copying (its move may throw), so relocating it can fail.
+		template< typename U >
+		static constexpr bool relocation_may_throw = !sc::is_trivially_relocatable<U>::value && !std::is_nothrow_move_constructible<U>::value;
+
+		/**
+		 * relocates the m_size elements into the columns of a new block: memcpy for trivially relocatable
+		 * columns, move_if_noexcept for the others. Columns that may throw (copied) go first and the
+		 * columns that cannot throw (memcpy or noexcept move) after them, so when a copy throws no old
+		 * element has been moved from yet: this list is unchanged and the new block holds no live element.
+		 * If free_on_error, the new block of new_cap elements is released on exception.
+		*/
+		void relocate_into( std::tuple<Ts*...>& columns, unsigned char* block, size_type new_cap, bool free_on_error = true )
+		{
+			std::size_t copied = 0; // colunas que podem lançar já copiadas, na ordem.
+			try {
+				for_each_column( [&]( auto ic ){
+					constexpr std::size_t I = decltype( ic )::value;
+					typedef column_type<I> U;
+					if constexpr ( relocation_may_throw<U> )
+					{
+						U* src = std::get<I>( m_columns );
+						U* dst = std::get<I>( columns );
+						size_type k = 0;
+						try {
+							for( ; k < m_size; k++ )
+								::new( static_cast<void*>( dst + k ) ) U( src[k] );
+						}
+						catch( ... ) {
+							while( k > 0 )
+								dst[--k].~U();
+							throw;
+						}
+						++copied;
+					}
+				} );
+			}
+			catch( ... ) {
+				std::size_t seen = 0;
+				for_each_column( [&]( auto ic ){
+					constexpr std::size_t I = decltype( ic )::value;
+					typedef column_type<I> U;
+					if constexpr ( relocation_may_throw<U> )
+					{
+						if( seen++ < copied )
+							for( size_type k = 0; k < m_size; k++ )
+								std::get<I>( columns )[k].~U();
+					}
+				} );
+				if( free_on_error )
+					deallocate( block, new_cap );
+				throw;
+			}
+			// Daqui em diante nada lança: memcpy ou move noexcept, e os originais são destruídos.
+			for_each_column( [&]( auto ic ){
+				constexpr std::size_t I = decltype( ic )::value;
+				typedef column_type<I> U;
+				U* src = std::get<I>( m_columns );
+				U* dst = std::get<I>( columns );
+				if constexpr ( sc::is_trivially_relocatable<U>::value )
+				{
+					if( m_size != 0 )
+						std::memcpy( static_cast<void*>( dst ), static_cast<const void*>( src ), m_size * sizeof(U) );
+				}
+				else
+				{
+					if constexpr ( !relocation_may_throw<U> )
+						for( size_type k = 0; k < m_size; k++ )
+							::new( static_cast<void*>( dst + k ) ) U( std::move( src[k] ) );
+					for( size_type k = 0; k < m_size; k++ )
+						src[k].~U();
+				}
+			} );
+		}
+
+		/**
+		 * releases the current block and takes block (already holding the elements) as the storage.
+		*/
+		void adopt( unsigned char* block, const std::tuple<Ts*...>& columns, size_type cap )
+		{
+			deallocate( m_block, m_capacity );
+			m_block = block;
+			m_columns = columns;
+			m_capacity = cap;
+		}
+
+		/**
+		 * removes count elements at idx from every column. The columns that are not trivially relocatable
+		 * are shifted down by move-assignment first; only when all of them are done are their tails
+		 * destroyed and the trivially relocatable columns memmoved, neither of which can throw. So if a
+		 * move-assignment throws, every column still holds m_size live elements (some moved from) and the
+		 * size stays the same for all of them.
+		*/
+		void erase_columns( size_type idx, size_type count )
+		{
+			for_each_column( [&]( auto ic ){
+				constexpr std::size_t I = decltype( ic )::value;
+				typedef column_type<I> U;
+				U* col = std::get<I>( m_columns );
+				if constexpr ( !sc::is_trivially_relocatable<U>::value )
+					std::move( col + idx + count, col + m_size, col + idx );
+			} );
+			for_each_column( [&]( auto ic ){
+				constexpr std::size_t I = decltype( ic )::value;
+				typedef column_type<I> U;
+				U* col = std::get<I>( m_columns );
+				if constexpr ( sc::is_trivially_relocatable<U>::value )
+				{
+					for( size_type k = idx; k < idx + count; k++ )
+						col[k].~U();
+					std::memmove( static_cast<void*>( col + idx ), static_cast<const void*>( col + idx + count ), ( m_size - idx - count ) * sizeof(U) );
+				}
+				else
+				{
+					for( size_type k = m_size - count; k < m_size; k++ )
+						col[k].~U();
+				}
+			} );
+		}
+};
+
+/**
+ * as in a == b : returns true if both lists have the same size and equal fields in every column.
+*/
+template< typename... Ts >
+bool operator==( const soa_vector<Ts...>& lhs, const soa_vector<Ts...>& rhs )
+{
+	if( lhs.size() != rhs.size() ) return false;
+	for( std::size_t i = 0; i < lhs.size(); i++ )
+		if( !( lhs[i] == rhs[i] ) ) return false;
+	return true;
+}
+
+template< typename... Ts >
+bool operator!=( const soa_vector<Ts...>& lhs, const soa_vector<Ts...>& rhs )
+{ return !( lhs == rhs ); }
+
+template< typename... Ts >
+void swap( soa_vector<Ts...>& lhs, soa_vector<Ts...>& rhs ) noexcept
+{ lhs.swap( rhs ); }
+
+}// namespace sc
+#endif
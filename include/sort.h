@@ -0,0 +1,286 @@
+#ifndef SORT_H
+#define SORT_H
+#include "iterator.h"
+#include "vector.h"
+#include <algorithm> // std::sort, std::stable_sort
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // std::memcpy
+#include <functional> // std::less, std::greater
+#include <type_traits>
+#include <utility> // std::declval
+
+/**
+ * Sorting of contiguous ranges (sc::vector, anything with data() and size(), pointer and sc::iterator
+ * ranges). Keys that are integers, floating-point numbers or enums, ordered by std::less or
+ * std::greater, are sorted by an LSD radix sort: one byte of the key per pass, passes on which every
+ * key has the same byte skipped. Anything else falls back to std::sort / std::stable_sort.
+ *
+ *     sc::sort( v );                               // radix sort, ascending
+ *     sc::sort( v, std::greater<>() );             // radix sort, descending
+ *     sc::sort_by_key( people, []( const person& p ){ return p.age; } );
+ *
+ * The radix sort is stable and needs a buffer as large as the range: it is kept per thread and reused
+ * by the following calls (release_sort_buffer() frees it). Floating-point keys are ordered by their
+ * bits: -0.0 comes before +0.0, and NaNs go to the ends by sign, where std::sort with < has no order.
+*/
+namespace sc{
+namespace detail{
+	/**
+	 * Order-preserving map from a key K to an unsigned integer (radix_traits<K>::encode), for the types
+	 * the radix sort handles. enabled is false for the others.
+	*/
+	template < typename K, typename = void >
+	struct radix_traits{
+		static constexpr bool enabled = false;
+	};
+
+	template < typename K >
+	struct radix_traits< K, typename std::enable_if< std::is_integral<K>::value && !std::is_same<K, bool>::value >::type >{
+		static constexpr bool enabled = true;
+		typedef typename std::make_unsigned<K>::type type;
+		static type encode( K key )
+		{
+			// Com sinal: inverter o bit de sinal põe os negativos antes dos positivos.
+			constexpr type flip = std::is_signed<K>::value ? type( type( 1 ) << ( sizeof(K) * 8 - 1 ) ) : type( 0 );
+			return static_cast<type>( static_cast<type>( key ) ^ flip );
+		}
+	};
+
+	template <>
+	struct radix_traits<bool>{
+		static constexpr bool enabled = true;
+		typedef std::uint8_t type;
+		static type encode( bool key ) { return key; }
+	};
+
+	template < typename K >
+	struct radix_traits< K, typename std::enable_if< std::is_floating_point<K>::value &&
+	                                                 ( sizeof(K) == 4 || sizeof(K) == 8 ) >::type >{
+		static constexpr bool enabled = true;
+		typedef typename std::conditional< sizeof(K) == 4, std::uint32_t, std::uint64_t >::type type;
+		static type encode( K key )
+		{
+			type bits;
+			std::memcpy( &bits, &key, sizeof bits );
+			// Negativos: todos os bits invertidos (maior magnitude vem antes); positivos: só o de sinal.
+			constexpr type sign = type( 1 ) << ( sizeof(K) * 8 - 1 );
+			return ( bits & sign ) ? type( ~bits ) : type( bits | sign );
+		}
+	};
+
+	template < typename K >
+	struct radix_traits< K, typename std::enable_if< std::is_enum<K>::value >::type >:
+		radix_traits< typename std::underlying_type<K>::type >{
+		typedef radix_traits< typename std::underlying_type<K>::type > base;
+		static typename base::type encode( K key )
+		{ return base::encode( static_cast< typename std::underlying_type<K>::type >( key ) ); }
+	};
+
+	template < typename Compare, typename T >
+	struct is_less_than: std::integral_constant< bool, std::is_same< Compare, std::less<> >::value ||
+	                                                   std::is_same< Compare, std::less<T> >::value >{};
+
+	template < typename Compare, typename T >
+	struct is_greater_than: std::integral_constant< bool, std::is_same< Compare, std::greater<> >::value ||
+	                                                      std::is_same< Compare, std::greater<T> >::value >{};
+
+	/// true if the radix sort can put elements of T in the order of the key type K.
+	template < typename T, typename K >
+	struct radix_sortable: std::integral_constant< bool, radix_traits<K>::enabled &&
+	                                                     std::is_trivially_copyable<T>::value &&
+	                                                     alignof(T) <= alignof(std::max_align_t) >{};
+
+	/// true if sorting T by comp can be done by the radix sort.
+	template < typename T, typename Compare >
+	struct radix_order: std::integral_constant< bool, radix_sortable<T, T>::value &&
+	                                                  ( is_less_than<Compare, T>::value || is_greater_than<Compare, T>::value ) >{};
+
+	/// Encoded key of an element: ascending, or complemented for descending order.
+	template < typename T, bool Descending >
+	struct radix_key{
+		typename radix_traits<T>::type operator()( const T& x )const
+		{
+			if constexpr ( Descending )
+				return static_cast< typename radix_traits<T>::type >( ~radix_traits<T>::encode( x ) );
+			else
+				return radix_traits<T>::encode( x );
+		}
+	};
+
+	/// Encoded key of key( element ), for sort_by_key.
+	template < typename Key >
+	struct projected_key{
+		Key key;
+		template < typename T >
+		auto operator()( const T& x )const
+		{
+			typedef typename std::decay< decltype( key( x ) ) >::type K;
+			return radix_traits<K>::encode( key( x ) );
+		}
+	};
+
+	/// Below this many elements the radix sort loses to a comparison sort.
+	constexpr std::size_t radix_min = 256;
+
+	/// Per-thread scratch memory of the radix sort, grown on demand and kept between calls.
+	inline sc::vector<std::max_align_t>& sort_buffer( void )
+	{
+		static thread_local sc::vector<std::max_align_t> buffer;
+		return buffer;
+	}
+
+	/**
+	 * returns scratch memory for n elements of T, from the buffer of the calling thread.
+	*/
+	template < typename T >
+	T* sort_scratch( std::size_t n )
+	{
+		sc::vector<std::max_align_t>& buffer = sort_buffer();
+		std::size_t words = ( n * sizeof(T) + sizeof(std::max_align_t) - 1 ) / sizeof(std::max_align_t);
+		if( buffer.capacity() < words )
+		{
+			buffer.clear(); // nada a preservar: reserve não precisa copiar.
+			buffer.reserve( words );
+		}
+		return reinterpret_cast<T*>( buffer.data() );
+	}
+
+	/**
+	 * stable LSD radix sort of the n elements at data by key( element ), an unsigned integer, one byte
+	 * per pass, moving the elements between data and buffer (room for n elements). The byte counts of
+	 * every pass come from one read of the keys; a pass whose byte is the same for every key is skipped.
+	*/
+	template < typename T, typename KeyFn >
+	void radix_sort( T* data, std::size_t n, T* buffer, KeyFn key )
+	{
+		typedef decltype( key( *data ) ) U;
+		constexpr unsigned passes = sizeof(U);
+		std::size_t count[passes][256] = {};
+		for( std::size_t i = 0; i < n; i++ )
+		{
+			U k = key( data[i] );
+			for( unsigned p = 0; p < passes; p++ )
+				count[p][( k >> ( 8 * p ) ) & 0xFF]++;
+		}
+		T* src = data;
+		T* dst = buffer;
+		for( unsigned p = 0; p < passes; p++ )
+		{
+			std::size_t* c = count[p];
+			const unsigned shift = 8 * p;
+			if( c[( key( src[0] ) >> shift ) & 0xFF] == n )
+				continue; // todas as chaves têm o mesmo byte aqui.
+			std::size_t sum = 0;
+			for( unsigned b = 0; b < 256; b++ )
+			{
+				std::size_t t = c[b];
+				c[b] = sum;
+				sum += t;
+			}
+			for( std::size_t i = 0; i < n; i++ )
+				dst[c[( key( src[i] ) >> shift ) & 0xFF]++] = src[i];
+			std::swap( src, dst );
+		}
+		if( src != data )
+			std::memcpy( static_cast<void*>( data ), src, n * sizeof(T) );
+	}
+
+	/// SFINAE guard: the container overloads only apply to types with data() and size().
+	template < typename Container >
+	using if_sortable = decltype( (void) std::declval<Container&>().data(), (void) std::declval<Container&>().size() );
+}// namespace detail
+
+	/**
+	 * frees the radix sort buffer of the calling thread.
+	*/
+	inline void release_sort_buffer( void )
+	{
+		sc::vector<std::max_align_t> empty;
+		detail::sort_buffer().swap( empty );
+	}
+
+	/**
+	 * sorts [first, last) by comp. Arithmetic and enum elements with std::less or std::greater are radix
+	 * sorted, which is also stable; other elements or comparisons go to std::sort.
+	*/
+	template < typename T, typename Compare = std::less<> >
+	void sort( T* first, T* last, Compare comp = Compare() )
+	{
+		std::size_t n = static_cast<std::size_t>( last - first );
+		if constexpr ( detail::radix_order<T, Compare>::value )
+		{
+			constexpr bool descending = detail::is_greater_than<Compare, T>::value;
+			detail::radix_key<T, descending> key;
+			if( n >= detail::radix_min )
+				detail::radix_sort( first, n, detail::sort_scratch<T>( n ), key );
+			else // mesma ordem do radix (-0.0 antes de +0.0), com comparações.
+				std::stable_sort( first, last, [&]( const T& a, const T& b ){ return key( a ) < key( b ); } );
+		}
+		else
+			std::sort( first, last, comp );
+	}
+
+	/**
+	 * sorts [first, last) by comp, keeping the order of equivalent elements.
+	*/
+	template < typename T, typename Compare = std::less<> >
+	void stable_sort( T* first, T* last, Compare comp = Compare() )
+	{
+		if constexpr ( detail::radix_order<T, Compare>::value )
+			sc::sort( first, last, comp ); // o radix sort já é estável.
+		else
+			std::stable_sort( first, last, comp );
+	}
+
+	/**
+	 * sorts [first, last) by key( element ), stably. If the key is arithmetic or an enum and the elements
+	 * are trivially copyable the elements are radix sorted, otherwise std::stable_sort compares keys.
+	*/
+	template < typename T, typename Key >
+	void sort_by_key( T* first, T* last, Key key )
+	{
+		typedef typename std::decay< decltype( key( *first ) ) >::type K;
+		std::size_t n = static_cast<std::size_t>( last - first );
+		if constexpr ( detail::radix_sortable<T, K>::value )
+		{
+			detail::projected_key<Key> encoded{ key };
+			if( n >= detail::radix_min )
+			{
+				detail::radix_sort( first, n, detail::sort_scratch<T>( n ), encoded );
+				return;
+			}
+			std::stable_sort( first, last, [&]( const T& a, const T& b ){ return encoded( a ) < encoded( b ); } );
+		}
+		else
+			std::stable_sort( first, last, [&]( const T& a, const T& b ){ return key( a ) < key( b ); } );
+	}
+
+	template < typename T, typename Compare = std::less<> >
+	void sort( sc::iterator<T> first, sc::iterator<T> last, Compare comp = Compare() )
+	{ sc::sort( first.operator->(), last.operator->(), comp ); }
+
+	template < typename T, typename Compare = std::less<> >
+	void stable_sort( sc::iterator<T> first, sc::iterator<T> last, Compare comp = Compare() )
+	{ sc::stable_sort( first.operator->(), last.operator->(), comp ); }
+
+	template < typename T, typename Key >
+	void sort_by_key( sc::iterator<T> first, sc::iterator<T> last, Key key )
+	{ sc::sort_by_key( first.operator->(), last.operator->(), key ); }
+
+	/**
+	 * sorts c (sc::vector or any container with data() and size()) by comp, in place.
+	*/
+	template < typename Container, typename Compare = std::less<>, typename = detail::if_sortable<Container> >
+	void sort( Container& c, Compare comp = Compare() )
+	{ sc::sort( c.data(), c.data() + c.size(), comp ); }
+
+	template < typename Container, typename Compare = std::less<>, typename = detail::if_sortable<Container> >
+	void stable_sort( Container& c, Compare comp = Compare() )
+	{ sc::stable_sort( c.data(), c.data() + c.size(), comp ); }
+
+	template < typename Container, typename Key, typename = detail::if_sortable<Container> >
+	void sort_by_key( Container& c, Key key )
+	{ sc::sort_by_key( c.data(), c.data() + c.size(), key ); }
+}// namespace sc
+#endif
@@ -0,0 +1,59 @@
+#ifndef SPAN_H
+#define SPAN_H
+#include <cstddef>
+#include <stdexcept> // std::out_of_range
+
+namespace sc{
+	/**
+	 * Non-owning view of size() contiguous objects starting at data(), for the C++17 builds that have no
+	 * std::span. Used to hand a column of sc::soa_vector to SIMD loops and the sc::parallel algorithms.
+	*/
+	template < typename T >
+	class span{
+		public:
+			typedef T element_type;
+			typedef std::size_t size_type;
+			typedef T* iterator;
+
+			constexpr span( void ) = default;
+
+			constexpr span( T* data, std::size_t size ): m_data{ data }, m_size{ size }
+			{ /* empty */ }
+
+			/**
+			 * converts a span of T into a span of const T.
+			*/
+			template < typename U >
+			constexpr span( const span<U>& other ): m_data{ other.data() }, m_size{ other.size() }
+			{ /* empty */ }
+
+			constexpr T* data( void )const { return m_data; }
+			constexpr std::size_t size( void )const { return m_size; }
+			constexpr bool empty( void )const { return m_size == 0; }
+			constexpr T* begin( void )const { return m_data; }
+			constexpr T* end( void )const { return m_data + m_size; }
+			constexpr T& operator[]( std::size_t i )const { return m_data[i]; }
+
+			/**
+			 * returns the element at index i.
+			 * @throws std::out_of_range if i is not below size().
+			*/
+			T& at( std::size_t i )const
+			{
+				if( i >= m_size )
+					throw std::out_of_range( "sc::span::at: index out of range" );
+				return m_data[i];
+			}
+
+			/**
+			 * returns the view of count elements starting at offset (no bounds check).
+			*/
+			constexpr span subspan( std::size_t offset, std::size_t count )const
+			{ return span( m_data + offset, count ); }
+
+		private:
+			T* m_data = nullptr;
+			std::size_t m_size = 0;
+	};
+}// namespace sc
+#endif
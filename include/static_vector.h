@@ -0,0 +1,657 @@
+#ifndef STATIC_VECTOR_H
+#define STATIC_VECTOR_H
+
+#include "constexpr.h"
+#include "iterator.h"
+#include "relocate.h"
+#include <iterator>
+#include <algorithm> // std::move_backward, std::equal, std::lexicographical_compare
+#include <initializer_list> // std::initializer_list
+#include <stdexcept> // std::out_of_range, std::length_error
+#include <memory> // std::destroy_at
+#include <new> // std::launder
+#include <type_traits>
+#include <cstring> // std::memmove
+
+namespace sc {
+
+namespace detail {
+	/**
+	 * Inline storage of sc::static_vector for types that need no constructor or destructor call: a plain
+	 * array, so the list is a literal type and may be a constexpr variable. Slots past size() are only
+	 * value-initialized inside constant expressions (every byte of a constexpr variable must be set);
+	 * at run time constructing the list touches none of them.
+	*/
+	template< typename T, std::size_t N, bool Literal = std::is_trivially_default_constructible<T>::value
+	                                                 && std::is_trivially_destructible<T>::value >
+	class static_storage{
+		protected:
+			SC_CONSTEXPR20 static_storage( void )
+			{
+				if( sc::is_constant_evaluated() )
+					for( std::size_t i = 0; i < N; ++i )
+						sc::construct_at( m_elems + i );
+			}
+
+			SC_CONSTEXPR20 T* slots( void ) { return m_elems; }
+			SC_CONSTEXPR20 const T* slots( void ) const { return m_elems; }
+
+			T m_elems[N]; //!< Element slots (only [0, m_size) hold list elements).
+			std::size_t m_size = 0; //!< Current list size.
+	};
+
+	/**
+	 * Inline storage for every other type: raw bytes, whose elements are destroyed by the destructor.
+	 * Such lists work at run time only.
+	*/
+	template< typename T, std::size_t N >
+	class static_storage< T, N, false >{
+		protected:
+			static_storage( void ) = default;
+			static_storage( const static_storage& ) = delete;
+			static_storage& operator=( const static_storage& ) = delete;
+
+			~static_storage()
+			{
+				for( std::size_t i = 0; i < m_size; ++i )
+					slots()[i].~T();
+			}
+
+			T* slots( void ) { return std::launder( reinterpret_cast<T*>( m_buffer ) ); }
+			const T* slots( void ) const { return std::launder( reinterpret_cast<const T*>( m_buffer ) ); }
+
+			alignas(T) unsigned char m_buffer[ N * sizeof(T) ]; //!< Raw storage for N elements.
+			std::size_t m_size = 0; //!< Current list size.
+	};
+}// namespace detail
+
+/**
+ * Sequence container with a fixed capacity of N elements stored inside the object: it never allocates,
+ * so it fits hot paths and bounded buffers where heap traffic is not acceptable. Adding an element to
+ * a full list throws std::length_error; try_push_back() and try_emplace_back() report it with nullptr.
+ *
+ * With C++20, a list of trivially constructible and destructible elements (int, double, plain structs)
+ * works in constant expressions and may be a constexpr variable, baked into the binary with no startup
+ * cost. sc::to_static_vector copies a sc::vector built at compile time into one.
+*/
+template< typename T, std::size_t N >
+class static_vector : private detail::static_storage< T, N >{
+	static_assert( N > 0, "sc::static_vector needs room for at least one element" );
+	typedef detail::static_storage< T, N > storage;
+	using storage::m_size;
+	using storage::slots;
+
+	public:
+		typedef T value_type; //!< Type of the elements stored in the list.
+		typedef std::size_t size_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef T& reference;
+		typedef const T& const_reference;
+		typedef T* pointer;
+		typedef const T* const_pointer;
+		typedef sc::iterator<T> iterator; //!< Contiguous iterator.
+		typedef sc::const_iterator<T> const_iterator; //!< Contiguous read-only iterator.
+		typedef std::reverse_iterator<iterator> reverse_iterator;
+		typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+	private:
+		/// Elements can be moved around as raw bytes (see sc::is_trivially_relocatable).
+		static constexpr bool trivially_relocatable = sc::is_trivially_relocatable<T>::value;
+
+	public:
+		//=== [I] SPECIAL MEMBERS
+
+		/**
+		 * Constructs an empty list.
+		*/
+		SC_CONSTEXPR20 static_vector( void ) = default;
+
+		/**
+		 * Constructs the list with count copies of value.
+		 * @throws std::length_error if count > N.
+		*/
+		SC_CONSTEXPR20 static_vector( size_t count, const T& value )
+		{ assign( count, value ); }
+
+		/**
+		 * Constructs the list with the contents of the range [first, last) .
+		 * @throws std::length_error if the range has more than N elements.
+		*/
+		template< typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category >
+		SC_CONSTEXPR20 static_vector( InputIt first, InputIt last )
+		{ assign( first, last ); }
+
+		/**
+		 * Constructs the list with the contents of the initializer list init .
+		*/
+		SC_CONSTEXPR20 static_vector( std::initializer_list<T> ilist )
+		{ assign( ilist.begin(), ilist.end() ); }
+
+		/**
+		 *Copy constructor. Copies the elements of other (not the unused slots).
+		*/
+		SC_CONSTEXPR20 static_vector( const static_vector& other ): storage()
+		{ append_copy( other.begin(), other.end() ); }
+
+		/**
+		 *Move constructor. Moves the elements of other one by one; other is left empty.
+		*/
+		SC_CONSTEXPR20 static_vector( static_vector&& other ) noexcept( std::is_nothrow_move_constructible<T>::value ):
+			storage()
+		{
+			append_copy( std::make_move_iterator( other.begin() ), std::make_move_iterator( other.end() ) );
+			other.clear();
+		}
+
+		/**
+		 *Copy assignment operator. Replaces the contents with a copy of the contents of other.
+		*/
+		SC_CONSTEXPR20 static_vector& operator=( const static_vector& other )
+		{
+			if( this != &other )
+				assign( other.begin(), other.end() );
+			return *this;
+		}
+
+		/**
+		 *Move assignment operator. Replaces the contents with those of other, moved element by element.
+		 *other is left empty.
+		*/
+		SC_CONSTEXPR20 static_vector& operator=( static_vector&& other )
+		{
+			if( this == &other ) return *this;
+			clear();
+			append_copy( std::make_move_iterator( other.begin() ), std::make_move_iterator( other.end() ) );
+			other.clear();
+			return *this;
+		}
+
+		/**
+		 *Replaces the contents with those identiﬁed by initializer list ilist .
+		*/
+		SC_CONSTEXPR20 static_vector& operator=( std::initializer_list<T> ilist )
+		{
+			assign( ilist.begin(), ilist.end() );
+			return *this;
+		}
+
+		//=== [II] ITERATORS
+
+		/**
+		 *returns an iterator pointing to the ﬁrst item in the list.
+		*/
+		SC_CONSTEXPR20 iterator begin( void )
+		{ return iterator( slots() ); }
+
+		/**
+		 * returns an iterator pointing to the end mark in the list.
+		*/
+		SC_CONSTEXPR20 iterator end( void )
+		{ return iterator( slots() + m_size ); }
+
+		/**
+		 *returns a constant iterator pointing to the ﬁrst item in the list.
+		*/
+		SC_CONSTEXPR20 const_iterator begin( void )const
+		{ return const_iterator( slots() ); }
+
+		/**
+		 * returns a constant iterator pointing to the end mark in the list.
+		*/
+		SC_CONSTEXPR20 const_iterator end( void )const
+		{ return const_iterator( slots() + m_size ); }
+
+		/**
+		 * returns a constant iterator pointing to the ﬁrst item in the list.
+		*/
+		SC_CONSTEXPR20 const_iterator cbegin( void )const
+		{ return begin(); }
+
+		/**
+		 * returns a constant iterator pointing to the end mark in the list.
+		*/
+		SC_CONSTEXPR20 const_iterator cend( void )const
+		{ return end(); }
+
+		/**
+		 * returns a reverse iterator pointing to the last item in the list.
+		*/
+		SC_CONSTEXPR20 reverse_iterator rbegin( void )
+		{ return reverse_iterator( end() ); }
+
+		/**
+		 * returns a reverse iterator pointing to the position just before the first item in the list.
+		*/
+		SC_CONSTEXPR20 reverse_iterator rend( void )
+		{ return reverse_iterator( begin() ); }
+
+		/**
+		 * returns a constant reverse iterator pointing to the last item in the list.
+		*/
+		SC_CONSTEXPR20 const_reverse_iterator crbegin( void )const
+		{ return const_reverse_iterator( cend() ); }
+
+		/**
+		 * returns a constant reverse iterator pointing to the position just before the first item in the list.
+		*/
+		SC_CONSTEXPR20 const_reverse_iterator crend( void )const
+		{ return const_reverse_iterator( cbegin() ); }
+
+		//=== [III] Capacity
+
+		/**
+		 *return the number of elements in the container.
+		*/
+		SC_CONSTEXPR20 size_t size( void )const
+		{ return m_size; }
+
+		/**
+		 * return the fixed capacity of the list, N.
+		*/
+		static constexpr size_t capacity( void )
+		{ return N; }
+
+		/**
+		 * return the largest possible size, N.
+		*/
+		static constexpr size_t max_size( void )
+		{ return N; }
+
+		/**
+		 * returns true if the container contains no elements, and false otherwise.
+		*/
+		SC_CONSTEXPR20 bool empty( void )const
+		{ return m_size == 0; }
+
+		/**
+		 * returns true if no element can be added.
+		*/
+		SC_CONSTEXPR20 bool full( void )const
+		{ return m_size == N; }
+
+		//=== [IV] Modifiers
+
+		/**
+		 *remove all elements from the container, calling their destructors.
+		*/
+		SC_CONSTEXPR20 void clear( void )
+		{
+			destroy( slots(), slots() + m_size );
+			m_size = 0;
+		}
+
+		/**
+		 * adds value to the end of the list.
+		 * @throws std::length_error if the list is full.
+		*/
+		SC_CONSTEXPR20 void push_back( const T& value )
+		{ emplace_back( value ); }
+
+		/**
+		 * adds value to the end of the list, moving it into place.
+		 * @throws std::length_error if the list is full.
+		*/
+		SC_CONSTEXPR20 void push_back( T&& value )
+		{ emplace_back( std::move( value ) ); }
+
+		/**
+		 * adds value to the end of the list unless it is full.
+		 * @return pointer to the new element, or nullptr if the list was full (it is left unchanged).
+		*/
+		SC_CONSTEXPR20 T* try_push_back( const T& value )
+		{ return try_emplace_back( value ); }
+
+		/**
+		 * moves value to the end of the list unless it is full.
+		 * @return pointer to the new element, or nullptr if the list was full (value is not moved from).
+		*/
+		SC_CONSTEXPR20 T* try_push_back( T&& value )
+		{ return try_emplace_back( std::move( value ) ); }
+
+		/**
+		 * Constructs one element at the end of the list.
+		 * @throws std::length_error if the list is full.
+		 * @return reference to the new element.
+		*/
+		template< class... Args >
+		SC_CONSTEXPR20 T& emplace_back( Args&&... args )
+		{
+			if( m_size == N )
+				throw std::length_error( "sc::static_vector: capacity exceeded" );
+			T* p = sc::construct_at( slots() + m_size, std::forward<Args>(args)... );
+			m_size++;
+			return *p;
+		}
+
+		/**
+		 * Constructs one element at the end of the list unless it is full.
+		 * @return pointer to the new element, or nullptr if the list was full.
+		*/
+		template< class... Args >
+		SC_CONSTEXPR20 T* try_emplace_back( Args&&... args )
+		{
+			if( m_size == N )
+				return nullptr;
+			T* p = sc::construct_at( slots() + m_size, std::forward<Args>(args)... );
+			m_size++;
+			return p;
+		}
+
+		/**
+		 * removes the object at the end of the list.
+		*/
+		SC_CONSTEXPR20 void pop_back( void )
+		{
+			if( empty() ) return;
+			m_size--;
+			destroy( slots() + m_size, slots() + m_size + 1 );
+		}
+
+		/**
+		 * adds value into the list before the position given by the iterator pos .
+		 * @throws std::length_error if the list is full.
+		*/
+		SC_CONSTEXPR20 iterator insert( const_iterator pos, const T& value )
+		{ return emplace( pos, value ); }
+
+		/**
+		 * moves value into the list before the position given by the iterator pos .
+		 * @throws std::length_error if the list is full.
+		*/
+		SC_CONSTEXPR20 iterator insert( const_iterator pos, T&& value )
+		{ return emplace( pos, std::move( value ) ); }
+
+		/**
+		 * inserts elements from the range [first; last) before pos . They are appended and rotated into place.
+		 * @throws std::length_error if they do not fit; the elements read so far are then removed again.
+		*/
+		template < typename InItr, typename = typename std::iterator_traits<InItr>::iterator_category >
+		SC_CONSTEXPR20 iterator insert( const_iterator pos, InItr first, InItr last )
+		{
+			size_t idx = pos - cbegin();
+			size_t old_size = m_size;
+			try {
+				append_copy( first, last );
+			}
+			catch( ... ) {
+				destroy( slots() + old_size, slots() + m_size );
+				m_size = old_size;
+				throw;
+			}
+			std::rotate( slots() + idx, slots() + old_size, slots() + m_size );
+			return iterator( slots() + idx );
+		}
+
+		/**
+		 *inserts elements from the initializer list ilist before pos .
+		*/
+		SC_CONSTEXPR20 iterator insert( const_iterator pos, std::initializer_list<T> ilist )
+		{ return insert( pos, ilist.begin(), ilist.end() ); }
+
+		/**
+		 * Constructs and insert one element before the position given by the iterator pos.
+		 * @throws std::length_error if the list is full.
+		*/
+		template< class... Args >
+		SC_CONSTEXPR20 iterator emplace( const_iterator pos, Args&&... args )
+		{
+			size_t idx = pos - cbegin();
+			if( m_size == N )
+				throw std::length_error( "sc::static_vector: capacity exceeded" );
+			T* data = slots();
+			if( idx == m_size )
+			{
+				sc::construct_at( data + m_size, std::forward<Args>(args)... );
+				m_size++;
+				return iterator( data + idx );
+			}
+			// args pode referenciar um elemento da própria lista: construir antes de deslocar.
+			T temp( std::forward<Args>(args)... );
+			if constexpr ( trivially_relocatable )
+			{
+				if( !sc::is_constant_evaluated() )
+				{
+					std::memmove( static_cast<void*>( data + idx + 1 ), static_cast<const void*>( data + idx ), ( m_size - idx ) * sizeof(T) );
+					sc::construct_at( data + idx, std::move( temp ) );
+					m_size++;
+					return iterator( data + idx );
+				}
+			}
+			sc::construct_at( data + m_size, std::move( data[m_size-1] ) );
+			m_size++;
+			std::move_backward( data + idx, data + m_size - 2, data + m_size - 1 );
+			data[idx] = std::move( temp );
+			return iterator( data + idx );
+		}
+
+		/**
+		 *Replaces the contents with count copies of value value .
+		 * @throws std::length_error if count > N.
+		*/
+		SC_CONSTEXPR20 void assign( size_t count, const T& value )
+		{
+			if( count > N )
+				throw std::length_error( "sc::static_vector: capacity exceeded" );
+			clear();
+			for( ; m_size < count; m_size++ )
+				sc::construct_at( slots() + m_size, value );
+		}
+
+		/**
+		 * replaces the contents of the list with copies of the elements in the range [first; last) .
+		 * @throws std::length_error if the range has more than N elements.
+		*/
+		template < typename InItr, typename = typename std::iterator_traits<InItr>::iterator_category >
+		SC_CONSTEXPR20 void assign( InItr first, InItr last )
+		{
+			clear();
+			append_copy( first, last );
+		}
+
+		/**
+		 * replaces the contents of the list with the elements from the initializer list ilist .
+		*/
+		SC_CONSTEXPR20 void assign( std::initializer_list<T> ilist )
+		{ assign( ilist.begin(), ilist.end() ); }
+
+		/**
+		 *removes the object at position pos . The method returns an iterator to the element that follows pos before the call.
+		*/
+		SC_CONSTEXPR20 iterator erase( const_iterator pos )
+		{ return erase( pos, pos + 1 ); }
+
+		/**
+		 * removes elements in the range [first; last) .
+		*/
+		SC_CONSTEXPR20 iterator erase( const_iterator first, const_iterator last )
+		{
+			size_t idx = first - cbegin();
+			size_t count = last - first;
+			T* data = slots();
+			if( count == 0 )
+				return iterator( data + idx );
+			if constexpr ( trivially_relocatable )
+			{
+				if( !sc::is_constant_evaluated() )
+				{
+					destroy( data + idx, data + idx + count );
+					std::memmove( static_cast<void*>( data + idx ), static_cast<const void*>( data + idx + count ), ( m_size - idx - count ) * sizeof(T) );
+					m_size -= count;
+					return iterator( data + idx );
+				}
+			}
+			T* new_end = std::move( data + idx + count, data + m_size, data + idx );
+			destroy( new_end, data + m_size );
+			m_size -= count;
+			return iterator( data + idx );
+		}
+
+		/**
+		 * exchanges the contents of this list with those of other, element by element.
+		*/
+		SC_CONSTEXPR20 void swap( static_vector& other )
+		{
+			static_vector* shorter = ( m_size < other.m_size ) ? this : &other;
+			static_vector* longer = ( shorter == this ) ? &other : this;
+			size_t common = shorter->m_size;
+			using std::swap;
+			for( size_t i = 0; i < common; ++i )
+				swap( slots()[i], other.slots()[i] );
+			shorter->append_copy( std::make_move_iterator( longer->slots() + common ),
+			                      std::make_move_iterator( longer->slots() + longer->m_size ) );
+			longer->destroy( longer->slots() + common, longer->slots() + longer->m_size );
+			longer->m_size = common;
+		}
+
+		//=== [V] Element access
+
+		/**
+		 * returns a pointer to the inline storage. [data(), data()+size()) is a valid range.
+		*/
+		SC_CONSTEXPR20 T* data( void )
+		{ return slots(); }
+
+		/**
+		 * returns a pointer to the inline storage. [data(), data()+size()) is a valid range.
+		*/
+		SC_CONSTEXPR20 const T* data( void ) const
+		{ return slots(); }
+
+		/**
+		 *returns the object at the beginning of the list.
+		*/
+		SC_CONSTEXPR20 T& front( void )
+		{ return slots()[0]; }
+
+		/**
+		 *returns the object at the beginning of the list.
+		*/
+		SC_CONSTEXPR20 const T& front( void ) const
+		{ return slots()[0]; }
+
+		/**
+		 * returns the object at the end of the list.
+		*/
+		SC_CONSTEXPR20 T& back( void )
+		{ return slots()[m_size-1]; }
+
+		/**
+		 * returns the object at the end of the list.
+		*/
+		SC_CONSTEXPR20 const T& back( void ) const
+		{ return slots()[m_size-1]; }
+
+		/**
+		 *returns the object at the index pos in the array, with no bounds-checking.
+		*/
+		SC_CONSTEXPR20 T& operator[]( size_t pos )
+		{ return slots()[pos]; }
+
+		/**
+		 *returns the object at the index pos in the array, with no bounds-checking.
+		*/
+		SC_CONSTEXPR20 const T& operator[]( size_t pos ) const
+		{ return slots()[pos]; }
+
+		/**
+		 *returns the object at the index pos in the array, with bounds-checking.
+		 * @throws std::out_of_range if pos >= size().
+		*/
+		SC_CONSTEXPR20 T& at( size_t pos )
+		{
+			if( pos >= m_size )
+				throw std::out_of_range( "[static_vector::at()] out of range error" );
+			return slots()[pos];
+		}
+
+		/**
+		 *returns the object at the index pos in the array, with bounds-checking.
+		 * @throws std::out_of_range if pos >= size().
+		*/
+		SC_CONSTEXPR20 const T& at( size_t pos ) const
+		{
+			if( pos >= m_size )
+				throw std::out_of_range( "[static_vector::at() const] out of range error" );
+			return slots()[pos];
+		}
+
+		//=== [VII] Friend functions.
+
+		/**
+		 * exchanges the contents of A and B.
+		*/
+		friend SC_CONSTEXPR20 void swap( static_vector& A, static_vector& B )
+		{ A.swap( B ); }
+
+	private:
+		//=== [VIII] Storage helpers.
+
+		/**
+		 * calls the destructor of every object in [first, last). Trivially destructible elements are left
+		 * alone, so the unused slots of a constexpr list stay initialized.
+		*/
+		SC_CONSTEXPR20 void destroy( T* first, T* last )
+		{
+			if constexpr ( !std::is_trivially_destructible<T>::value )
+				for( ; first != last; ++first )
+					std::destroy_at( first );
+		}
+
+		/**
+		 * constructs copies of [first, last) after the last element.
+		 * @throws std::length_error if they do not fit; the copies already made are kept.
+		*/
+		template< typename InputIt >
+		SC_CONSTEXPR20 void append_copy( InputIt first, InputIt last )
+		{
+			for( ; first != last; ++first )
+			{
+				if( m_size == N )
+					throw std::length_error( "sc::static_vector: capacity exceeded" );
+				sc::construct_at( slots() + m_size, *first );
+				m_size++;
+			}
+		}
+};
+
+/**
+ * Checks if the contents of lhs and rhs are equal.
+*/
+template< typename T, std::size_t N >
+SC_CONSTEXPR20 bool operator==( const sc::static_vector<T, N>& lhs, const sc::static_vector<T, N>& rhs )
+{ return lhs.size() == rhs.size() && std::equal( lhs.begin(), lhs.end(), rhs.begin() ); }
+
+/**
+ * Similar to the previous operator, but the opposite result.
+*/
+template< typename T, std::size_t N >
+SC_CONSTEXPR20 bool operator!=( const sc::static_vector<T, N>& lhs, const sc::static_vector<T, N>& rhs )
+{ return !( lhs == rhs ); }
+
+/**
+ * Compares the contents of lhs and rhs lexicographically.
+*/
+template< typename T, std::size_t N >
+SC_CONSTEXPR20 bool operator<( const sc::static_vector<T, N>& lhs, const sc::static_vector<T, N>& rhs )
+{ return std::lexicographical_compare( lhs.begin(), lhs.end(), rhs.begin(), rhs.end() ); }
+
+/**
+ * Copies the list returned by gen() (a sc::vector or any range of known size) into a static_vector of
+ * capacity N. Memory allocated inside a constant expression must be freed before it ends, so this is how
+ * a table computed at compile time with sc::vector is kept in the binary:
+ *
+ *     constexpr auto make_squares = []{ sc::vector<int> v; for( int i = 0; i < 100; ++i ) v.push_back( i * i ); return v; };
+ *     constexpr auto squares = sc::to_static_vector< make_squares().size() >( make_squares );
+ *
+ * @throws std::length_error if gen() returns more than N elements (a compile error in a constant expression).
+*/
+template< std::size_t N, typename Generator >
+SC_CONSTEXPR20 auto to_static_vector( Generator gen )
+{
+	auto list = gen();
+	typedef typename std::remove_cv< typename std::remove_reference< decltype( *list.begin() ) >::type >::type value_type;
+	return sc::static_vector< value_type, N >( list.begin(), list.end() );
+}
+}//namespace
+
+#endif
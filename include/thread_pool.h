@@ -0,0 +1,213 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception> // std::exception_ptr
+#include <functional> // std::function
+#include <memory> // std::unique_ptr
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sc{
+namespace parallel{
+	/**
+	 * Work-stealing thread pool. Every worker owns a task deque: it pops its own tasks from the back
+	 * (newest first, still warm in cache) and, when it runs dry, steals the oldest task from the front
+	 * of another worker's deque. The thread that waits for a batch of tasks (run()) executes tasks too,
+	 * so nested parallel calls (e.g. the recursion of sort) never deadlock.
+	*/
+	class thread_pool{
+		public:
+			/**
+			 * @param concurrency  threads that execute tasks, counting the caller of run(): concurrency - 1
+			 *                     workers are started. 0 means std::thread::hardware_concurrency().
+			*/
+			explicit thread_pool( unsigned concurrency = 0 ):
+				m_pending{ 0 },
+				m_stop{ false }
+			{
+				if( concurrency == 0 )
+					concurrency = std::thread::hardware_concurrency();
+				if( concurrency == 0 )
+					concurrency = 1;
+				// Fila 0 recebe as tarefas de quem não é worker (a thread que chama run()).
+				for( unsigned i = 0; i < concurrency; i++ )
+					m_queues.emplace_back( new queue );
+				for( unsigned i = 1; i < concurrency; i++ )
+					m_threads.emplace_back( [this, i]{ work( i ); } );
+			}
+
+			thread_pool( const thread_pool& ) = delete;
+			thread_pool& operator=( const thread_pool& ) = delete;
+
+			/**
+			 * waits for the workers to finish their current task and joins them.
+			*/
+			~thread_pool()
+			{
+				{
+					std::lock_guard<std::mutex> lock( m_sleep );
+					m_stop = true;
+				}
+				m_wake.notify_all();
+				for( std::thread& t : m_threads )
+					t.join();
+			}
+
+			/**
+			 * returns the number of threads that execute tasks, counting the caller of run().
+			*/
+			unsigned concurrency( void ) const
+			{ return static_cast<unsigned>( m_queues.size() ); }
+
+			/**
+			 * runs task( i ) for every i in [0, count) and returns when all of them have finished. Tasks are
+			 * dealt in contiguous blocks to the deques so neighbouring chunks start on the same thread.
+			 * If tasks throw, the first exception is rethrown here after every task has ended.
+			*/
+			template < typename F >
+			void run( std::size_t count, F task )
+			{
+				if( count == 0 ) return;
+				if( count == 1 || concurrency() == 1 )
+				{
+					for( std::size_t i = 0; i < count; i++ )
+						task( i );
+					return;
+				}
+				std::atomic<std::size_t> left{ count };
+				std::exception_ptr error;
+				std::mutex error_lock;
+				std::size_t queues = m_queues.size();
+				m_pending.fetch_add( count, std::memory_order_release );
+				for( std::size_t q = 0; q < queues; q++ )
+				{
+					std::size_t first = count * q / queues;
+					std::size_t last = count * ( q + 1 ) / queues;
+					if( first == last ) continue;
+					std::lock_guard<std::mutex> lock( m_queues[q]->lock );
+					for( std::size_t i = first; i < last; i++ )
+						m_queues[q]->tasks.emplace_back( [&, i]{
+							try {
+								task( i );
+							}
+							catch( ... ) {
+								std::lock_guard<std::mutex> guard( error_lock );
+								if( !error )
+									error = std::current_exception();
+							}
+							left.fetch_sub( 1, std::memory_order_acq_rel );
+						} );
+				}
+				{
+					std::lock_guard<std::mutex> lock( m_sleep );
+				}
+				m_wake.notify_all();
+
+				// Quem espera também trabalha: executa tarefas (deste lote ou de outros) até o lote acabar.
+				std::size_t self = current_index();
+				while( left.load( std::memory_order_acquire ) != 0 )
+				{
+					if( !run_one( self ) )
+						std::this_thread::yield();
+				}
+				if( error )
+					std::rethrow_exception( error );
+			}
+
+			/**
+			 * the pool shared by the sc::parallel algorithms when no other is given, with one thread per core.
+			*/
+			static thread_pool& default_pool( void )
+			{
+				static thread_pool pool;
+				return pool;
+			}
+
+		private:
+			/// Task deque of one thread. The owner uses the back, thieves the front.
+			struct queue{
+				std::mutex lock;
+				std::deque< std::function<void()> > tasks;
+			};
+
+			std::vector< std::unique_ptr<queue> > m_queues;
+			std::vector<std::thread> m_threads;
+			std::atomic<std::size_t> m_pending; //!< Tasks queued and not yet taken.
+			std::mutex m_sleep;
+			std::condition_variable m_wake;
+			bool m_stop;
+
+			/**
+			 * index of the deque owned by the calling thread: its worker index, or 0 for other threads.
+			*/
+			std::size_t current_index( void ) const
+			{
+				const thread_pool* owner = worker_owner();
+				return ( owner == this ) ? worker_index() : 0;
+			}
+
+			static const thread_pool*& worker_owner( void )
+			{
+				static thread_local const thread_pool* owner = nullptr;
+				return owner;
+			}
+
+			static std::size_t& worker_index( void )
+			{
+				static thread_local std::size_t index = 0;
+				return index;
+			}
+
+			/**
+			 * takes one task (own deque first, then steals round the others) and runs it.
+			 * @return false if every deque was empty.
+			*/
+			bool run_one( std::size_t self )
+			{
+				std::function<void()> task;
+				std::size_t queues = m_queues.size();
+				for( std::size_t k = 0; k < queues && !task; k++ )
+				{
+					queue& q = *m_queues[( self + k ) % queues];
+					std::lock_guard<std::mutex> lock( q.lock );
+					if( q.tasks.empty() ) continue;
+					if( k == 0 )
+					{
+						task = std::move( q.tasks.back() );
+						q.tasks.pop_back();
+					}
+					else
+					{
+						task = std::move( q.tasks.front() );
+						q.tasks.pop_front();
+					}
+				}
+				if( !task )
+					return false;
+				m_pending.fetch_sub( 1, std::memory_order_relaxed );
+				task();
+				return true;
+			}
+
+			void work( std::size_t index )
+			{
+				worker_owner() = this;
+				worker_index() = index;
+				for( ;; )
+				{
+					if( run_one( index ) )
+						continue;
+					std::unique_lock<std::mutex> lock( m_sleep );
+					m_wake.wait( lock, [this]{ return m_stop || m_pending.load( std::memory_order_acquire ) != 0; } );
+					if( m_stop )
+						return;
+				}
+			}
+	};
+}// namespace parallel
+}// namespace sc
+#endif
@@ -1,588 +1,1666 @@
 #ifndef VECTOR_H
 #define VECTOR_H
 
+#include "constexpr.h"
 #include "iterator.h"
+#include "relocate.h"
+#include "growth_policy.h"
+#include "instrumentation.h"
+#include "realloc_allocator.h"
+#include "simd.h"
 #include <iterator>
 #include <algorithm> //std::min, std::copy
 #include <initializer_list> // std::initializer_list
 #include <stdexcept>//std::out_of_range
+#include <memory> // std::allocator, std::allocator_traits
+#include <ostream>
+#include <type_traits>
+#include <cstring> // std::memcpy, std::memmove
 
 namespace sc {
 
-template< typename T>
+namespace io { struct access; }
+namespace expr {
+	/// Base of the lazy element-wise expressions of expr.h, which sc::vector evaluates on construction and assignment.
+	struct node { /* empty */ };
+}
+
+/**
+ * Dynamic array. With C++20 and std::allocator the whole list can be used in constant expressions
+ * (see constexpr.h); a table computed that way is kept with sc::to_static_vector (static_vector.h).
+ *  @tparam Allocator     allocator used to obtain raw storage. If it has a reallocate() member
+ *                        (see sc::realloc_allocator), trivially relocatable elements grow in place.
+ *  @tparam GrowthPolicy  decides the new capacity whenever the list outgrows its storage (see growth_policy.h).
+ *  @tparam Instrument    observes allocations and element moves (see instrumentation.h); the default,
+ *                        sc::no_instrumentation, compiles to nothing.
+*/
+template< typename T, typename Allocator = std::allocator<T>, typename GrowthPolicy = sc::doubling_growth,
+          typename Instrument = sc::no_instrumentation >
 class vector{
+	public:
+		typedef T value_type; //!< Type of the elements stored in the list.
+		typedef Allocator allocator_type; //!< Allocator used to obtain raw storage.
+		typedef GrowthPolicy growth_policy; //!< Policy that picks the capacity on growth.
+		typedef Instrument instrumentation_type; //!< Policy that observes allocations and element moves.
+		typedef std::size_t size_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef T& reference;
+		typedef const T& const_reference;
+		typedef T* pointer;
+		typedef const T* const_pointer;
+		typedef sc::iterator<T> iterator; //!< Contiguous iterator.
+		typedef sc::const_iterator<T> const_iterator; //!< Contiguous read-only iterator.
+		typedef std::reverse_iterator<iterator> reverse_iterator;
+		typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
 	private:
-        T * data; //!<  Data storage area for the dynamic array.
-        size_t m_size; //!< Current list size (or index past-last valid element). 
-        size_t m_capacity; //!< List’s storage capacity. 
+		typedef std::allocator_traits<Allocator> alloc_traits;
+		static_assert( std::is_same< typename alloc_traits::pointer, T* >::value,
+		               "sc::vector requires an allocator whose pointer type is T*" );
+
+		/// Elements can be moved around as raw bytes (see sc::is_trivially_relocatable).
+		static constexpr bool trivially_relocatable = sc::is_trivially_relocatable<T>::value;
+		/// Storage can be resized by the allocator itself (realloc/mremap) with no element-wise relocation.
+		static constexpr bool resize_in_place = trivially_relocatable && sc::has_reallocate<Allocator>::value;
+
+		friend struct sc::io::access; // leitura em bloco direto para a memória bruta (serialize.h).
 
-   	public:
-   		 //=== [I] SPECIAL MEMBERS 
+		allocator_type m_alloc; //!< Allocator that owns the storage area.
+		T * m_data; //!<  Data storage area for the dynamic array (raw, only [0, m_size) is constructed).
+		size_t m_size; //!< Current list size (or index past-last valid element).
+		size_t m_capacity; //!< List’s storage capacity.
+		[[no_unique_address]] Instrument m_instr; //!< Instrumentation state (empty unless enabled).
 
-   		/**
-		 * Constructs the list with count default-inserted instances of T .
-		 *  @param count  the size of the list. 
- 		*/
-   		vector( size_t count=0 ):
-   			data{ new T[count*2] },
-			   m_size{ 0 },
-			   m_capacity{ count*2 } 
-		    { /*empty*/ }
+	public:
+		//=== [I] SPECIAL MEMBERS
+
+		/**
+		 * Constructs an empty list with room for exactly count elements. No object is constructed.
+		 *  @param count  the capacity of the list.
+		 *  @param alloc  allocator used for all memory of this list.
+		*/
+		SC_CONSTEXPR20 vector( size_t count=0, const Allocator& alloc = Allocator() ):
+			m_alloc{ alloc },
+			m_data{ nullptr },
+			m_size{ 0 },
+			m_capacity{ 0 }
+		{
+			m_data = allocate( count );
+			m_capacity = count;
+			note_growth( growth_cause::construct, 0, count, 0, false );
+		}
+
+		/**
+		 * Constructs an empty list that takes its memory from alloc (e.g. sc::pmr::vector<int> v( &arena ) ).
+		*/
+		SC_CONSTEXPR20 explicit vector( const Allocator& alloc ):
+			vector( 0, alloc )
+		{ /* empty */ }
 
 		/**
-		 * Constructs the list with the contents of the range [first, last) .
+		 * Constructs the list with the contents of the range [first, last) . Forward ranges are measured
+		 * once and allocated exactly; input ranges (read only once) are appended element by element.
 		 *  @param first first element of the range to copy the elements from.
-		 *  @param last  the position just after the last element of the range. 
- 		*/
-   		template< typename InputIt >
-   		vector( InputIt first, InputIt last ):
-   			m_size{ std::distance( first, last ) },
-   			m_capacity{ m_size*2 }
-   		{
-   			data = new T[m_capacity];
-   			std::copy( first, last, data);
-   		}
-
-		/**
-		 *Copy constructor. Constructs the list with the deep copy of the contents of other . 
+		 *  @param last  the position just after the last element of the range.
+		*/
+		template< typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category >
+		SC_CONSTEXPR20 vector( InputIt first, InputIt last, const Allocator& alloc = Allocator() ):
+			m_alloc{ alloc },
+			m_data{ nullptr },
+			m_size{ 0 },
+			m_capacity{ 0 }
+		{
+			typedef typename std::iterator_traits<InputIt>::iterator_category category;
+			if constexpr ( std::is_base_of< std::forward_iterator_tag, category >::value )
+			{
+				size_t count = static_cast<size_t>( std::distance( first, last ) );
+				m_data = allocate( count );
+				m_capacity = count;
+				note_growth( growth_cause::construct, 0, count, 0, false );
+				init_copy( first, last );
+			}
+			else
+				append_input( first, last );
+		}
+
+		/**
+		 *Copy constructor. Constructs the list with the deep copy of the contents of other . Only other.size()
+		 *elements are allocated (the spare capacity of other is not copied); trivially copyable elements go with one memcpy.
 		 *  @param other  another list to be used as source to initialize the elements of the list with.
- 		*/
-      	vector( const vector& other ):
-      			m_size{ other.m_size },
-   			   m_capacity{ other.m_capacity }
-   		{
-   	 		// [1] Alocar o espaço de dados.
-      			data = new T[m_capacity];
-     			// [2] Copiar os elementos do source para o atual (this).
-      			std::copy( &other.data[0], &other.data[m_size], data );
-   		}
+		*/
+		SC_CONSTEXPR20 vector( const vector& other ):
+			m_alloc{ alloc_traits::select_on_container_copy_construction( other.m_alloc ) },
+			m_data{ nullptr },
+			m_size{ 0 },
+			m_capacity{ 0 },
+			m_instr{ other.m_instr }
+		{
+			// [1] Alocar o espaço de dados (só o necessário: a folga de other não é copiada).
+			m_data = allocate( other.m_size );
+			m_capacity = other.m_size;
+			// [2] Construir cópias dos elementos do source no atual (this).
+			note_growth( growth_cause::copy, 0, m_capacity, 0, false );
+			init_copy( other.m_data, other.m_data + other.m_size );
+			note_copy( m_size );
+		}
+
+		/**
+		 *Move constructor. Steals the storage of other, which is left empty. No element is copied or moved.
+		 *  @param other  another list whose contents are taken over.
+		*/
+		SC_CONSTEXPR20 vector( vector&& other ) noexcept:
+			m_alloc{ std::move( other.m_alloc ) },
+			m_data{ other.m_data },
+			m_size{ other.m_size },
+			m_capacity{ other.m_capacity },
+			m_instr{ other.m_instr }
+		{
+			other.m_data = nullptr;
+			other.m_size = other.m_capacity = 0;
+		}
 
 		/**
 		 * Constructs the list with the contents of the initializer list init .
 		 *  @param ilist initializer list to initialize the elements of the list with.
- 		*/
-   		vector( std::initializer_list<T> ilist ):
-   			m_size{ ilist.size() },
-   			m_capacity{ 2*m_size }
-   		{
-   			data = new T[m_capacity];
-   			std::copy( ilist.begin(), ilist.end(), data );
-   		}
+		*/
+		SC_CONSTEXPR20 vector( std::initializer_list<T> ilist, const Allocator& alloc = Allocator() ):
+			m_alloc{ alloc },
+			m_data{ nullptr },
+			m_size{ 0 },
+			m_capacity{ 0 }
+		{
+			m_data = allocate( ilist.size() );
+			m_capacity = ilist.size();
+			note_growth( growth_cause::construct, 0, m_capacity, 0, false );
+			init_copy( ilist.begin(), ilist.end() );
+		}
+
+		/**
+		 * Constructs the list with the values of an element-wise expression (see expr.h), computed in one
+		 * pass straight into the new storage.
+		 *  @param e expression such as a * b + c over lists of arithmetic T.
+		*/
+		template< typename Expr, typename = typename std::enable_if< std::is_base_of< sc::expr::node, Expr >::value >::type >
+		vector( const Expr& e, const Allocator& alloc = Allocator() ):
+			m_alloc{ alloc },
+			m_data{ nullptr },
+			m_size{ 0 },
+			m_capacity{ 0 }
+		{
+			static_assert( std::is_same< typename Expr::value_type, T >::value, "sc::vector: the expression yields another element type" );
+			m_data = allocate( e.size() );
+			m_capacity = e.size();
+			note_growth( growth_cause::construct, 0, m_capacity, 0, false );
+			e.evaluate( m_data );
+			m_size = m_capacity;
+		}
 
 		/**
 		 * Destructs the list. The destructors of the elements are called and the used storage is deallocated.
 		 *Note, that if the elements are pointers, the pointed-to objects are not destroyed.
- 		*/
-   		~vector()
-   		{
- 			delete[] data;
-         }
+		*/
+		SC_CONSTEXPR20 ~vector()
+		{
+			if constexpr ( Instrument::enabled )
+				m_instr.on_release( m_size, m_capacity, sizeof(T) );
+			destroy( m_data, m_data + m_size );
+			deallocate( m_data, m_capacity );
+		}
+
+		/**
+		 *Copy assignment operator. Replaces the contents with a copy of the contents of other. The current
+		 *storage is reused when it is large enough.
+		 *  @param other another list to be used as source to initialize the elements of the list with.
+		*/
+		SC_CONSTEXPR20 vector& operator=( const vector& other )
+		{
+			if( this == &other ) return *this;
+
+			clear();
+			// O bloco atual é reaproveitado se couber other e o alocador não mudar.
+			bool reallocate = m_capacity < other.m_size;
+			if constexpr ( alloc_traits::propagate_on_container_copy_assignment::value )
+				reallocate = reallocate || !( m_alloc == other.m_alloc );
+			if( reallocate )
+			{
+				deallocate( m_data, m_capacity );
+				m_data = nullptr;
+				m_capacity = 0;
+			}
+
+			if constexpr ( alloc_traits::propagate_on_container_copy_assignment::value )
+				m_alloc = other.m_alloc;
+
+			if( reallocate )
+			{
+				m_data = allocate( other.m_size );
+				m_capacity = other.m_size;
+				note_growth( growth_cause::copy, 0, m_capacity, 0, false );
+			}
+			init_copy( other.m_data, other.m_data + other.m_size );
+			note_copy( m_size );
+			return *this;
+		}
 
 		/**
-		 *Copy assignment operator. Replaces the contents with a copy of the contents of other. 
+		 *Move assignment operator. Replaces the contents with those of other using move semantics
 		 *(i.e. the data in other is moved from other into this container).
-		 *other is in a valid but unspeciﬁed state afterwards. 
+		 *other is in a valid but unspeciﬁed state afterwards.
 		 *  @param other another list to be used as source to initialize the elements of the list with.
- 		*/
-   		vector& operator=( const vector& other )
-   		{
-   			m_size = other.m_size;
-   			m_capacity = other.m_capacity;
-   			delete[] data;
-      		data = new T[m_capacity];
-   			std::copy( other.data, other.data+m_size, data );
-   			return *this;
-   		}
+		*/
+		SC_CONSTEXPR20 vector& operator=( vector&& other ) noexcept( alloc_traits::propagate_on_container_move_assignment::value
+		                                             || alloc_traits::is_always_equal::value )
+		{
+			if( this == &other ) return *this;
+
+			if( alloc_traits::propagate_on_container_move_assignment::value || m_alloc == other.m_alloc )
+			{
+				// Mesma memória pode ser compartilhada: basta roubar o buffer.
+				destroy( m_data, m_data + m_size );
+				deallocate( m_data, m_capacity );
+				if constexpr ( alloc_traits::propagate_on_container_move_assignment::value )
+					m_alloc = std::move( other.m_alloc );
+				m_data = other.m_data;
+				m_size = other.m_size;
+				m_capacity = other.m_capacity;
+				other.m_data = nullptr;
+				other.m_size = other.m_capacity = 0;
+			}
+			else
+			{
+				// Alocadores diferentes: mover elemento a elemento para memória própria.
+				clear();
+				grow_to( other.m_size, growth_cause::assign );
+				init_copy( std::make_move_iterator( other.m_data ), std::make_move_iterator( other.m_data + other.m_size ) );
+				other.clear();
+			}
+			return *this;
+		}
 
 		/**
 		 *Replaces the contents with those identiﬁed by initializer list ilist .
 		 *  @param ilist initializer list to initialize the elements of the list with.
- 		*/
-   		vector& operator=( std::initializer_list<T> ilist )
-   		{
-   			m_size = ilist.size();
-   			m_capacity = m_size*2;
-   			delete[] data;
-   			data = new T[m_capacity];
-   			std::copy( ilist.begin(), ilist.end(), data );
-   			return *this;
-   		} 
-
-   		//=== [II] ITERATORS
+		*/
+		SC_CONSTEXPR20 vector& operator=( std::initializer_list<T> ilist )
+		{
+			assign( ilist );
+			return *this;
+		}
+
+		/**
+		 * Replaces the contents with the values of an element-wise expression (see expr.h). The current
+		 * storage is reused when it is large enough; otherwise the values go into a new block, and the old
+		 * one, which the expression may be reading, is released afterwards.
+		 *  @param e expression such as a * b + c over lists of arithmetic T.
+		*/
+		template< typename Expr, typename = typename std::enable_if< std::is_base_of< sc::expr::node, Expr >::value >::type >
+		vector& operator=( const Expr& e )
+		{
+			static_assert( std::is_same< typename Expr::value_type, T >::value, "sc::vector: the expression yields another element type" );
+			size_t count = e.size();
+			if( count <= m_capacity )
+			{
+				// Cada elemento depende só da mesma posição dos operandos: pode escrever por cima.
+				e.evaluate( m_data );
+				m_size = count;
+				return *this;
+			}
+			T* fresh = allocate( count );
+			e.evaluate( fresh );
+			note_growth( growth_cause::assign, m_capacity, count, 0, false );
+			deallocate( m_data, m_capacity );
+			m_data = fresh;
+			m_size = m_capacity = count;
+			return *this;
+		}
+
+		/**
+		 * returns the allocator associated with the container.
+		*/
+		SC_CONSTEXPR20 allocator_type get_allocator( void ) const
+		{ return m_alloc; }
+
+		/**
+		 * returns the instrumentation policy of this list, e.g. v.instrumentation().stats() with
+		 * sc::instrumented (see instrumentation.h).
+		*/
+		SC_CONSTEXPR20 Instrument& instrumentation( void )
+		{ return m_instr; }
+
+		/**
+		 * returns the instrumentation policy of this list.
+		*/
+		SC_CONSTEXPR20 const Instrument& instrumentation( void ) const
+		{ return m_instr; }
+
+		//=== [II] ITERATORS
 		/**
 		 *returns an iterator pointing to the ﬁrst item in the list.
- 		*/
-   		sc::iterator<T> begin( void )
-   		{ return sc::iterator<T>( &data[0] ); }
+		*/
+		SC_CONSTEXPR20 sc::iterator<T> begin( void )
+		{ return sc::iterator<T>( m_data ); }
 
 		/**
 		 * returns an iterator pointing to the end mark in the list,
-		 *i.e. the position just after the last element of the list. 
- 		*/
-   		sc::iterator<T> end( void )
-   		{ return sc::iterator<T>( &data[m_size] ); }
+		 *i.e. the position just after the last element of the list.
+		*/
+		SC_CONSTEXPR20 sc::iterator<T> end( void )
+		{ return sc::iterator<T>( m_data + m_size ); }
+
+		/**
+		 *returns a constant iterator pointing to the ﬁrst item in the list.
+		*/
+		SC_CONSTEXPR20 const_iterator begin( void )const
+		{ return const_iterator( m_data ); }
+
+		/**
+		 * returns a constant iterator pointing to the end mark in the list.
+		*/
+		SC_CONSTEXPR20 const_iterator end( void )const
+		{ return const_iterator( m_data + m_size ); }
 
 		/**
 		 * returns a constant iterator pointing to the ﬁrst item in the list.
- 		*/
-   		const sc::iterator<T> cbegin( void )const
-   		{ return sc::iterator<T>( &data[0] ); }
+		*/
+		SC_CONSTEXPR20 const_iterator cbegin( void )const
+		{ return const_iterator( m_data ); }
 
 		/**
-		 * returns a constant iterator pointing to the end mark in the list, 
+		 * returns a constant iterator pointing to the end mark in the list,
 		 i.e. the position just after the last element of the list.
- 		*/
-   		const sc::iterator<T> cend( void )const
-   		{ return sc::iterator<T>( &data[m_size] ); }
+		*/
+		SC_CONSTEXPR20 const_iterator cend( void )const
+		{ return const_iterator( m_data + m_size ); }
 
-   		//=== [III] Capacity 
+		/**
+		 * returns a reverse iterator pointing to the last item in the list.
+		*/
+		SC_CONSTEXPR20 reverse_iterator rbegin( void )
+		{ return reverse_iterator( end() ); }
 
 		/**
-		 *return the number of elements in the container.
- 		*/
-   		size_t size( void )const
-   		{ return m_size; }
+		 * returns a reverse iterator pointing to the position just before the first item in the list.
+		*/
+		SC_CONSTEXPR20 reverse_iterator rend( void )
+		{ return reverse_iterator( begin() ); }
 
 		/**
-		 * return the internal storage capacity of the array. 
- 		*/
-   		size_t capacity( void )const
-   		{ return m_capacity; }
+		 * returns a constant reverse iterator pointing to the last item in the list.
+		*/
+		SC_CONSTEXPR20 const_reverse_iterator rbegin( void )const
+		{ return const_reverse_iterator( end() ); }
 
 		/**
-		 * returns true if the container contains no elements, and false otherwise. 
- 		*/
-   		bool empty( void )const
-   		{ return m_size == 0; }
+		 * returns a constant reverse iterator pointing to the position just before the first item in the list.
+		*/
+		SC_CONSTEXPR20 const_reverse_iterator rend( void )const
+		{ return const_reverse_iterator( begin() ); }
 
-		//=== [IV] Modifiers 
 		/**
-		 *remove (either logically or physically) all elements from the container. 
- 		*/
-		void clear( void )
-		{ m_size = 0; }
+		 * returns a constant reverse iterator pointing to the last item in the list.
+		*/
+		SC_CONSTEXPR20 const_reverse_iterator crbegin( void )const
+		{ return const_reverse_iterator( cend() ); }
 
 		/**
-		 * adds value to the front of the list.
-		 * @param value  the value to append to the list. 
- 		*/
-		void push_front( const T& value )
+		 * returns a constant reverse iterator pointing to the position just before the first item in the list.
+		*/
+		SC_CONSTEXPR20 const_reverse_iterator crend( void )const
+		{ return const_reverse_iterator( cbegin() ); }
+
+		//=== [III] Capacity
+
+		/**
+		 *return the number of elements in the container.
+		*/
+		SC_CONSTEXPR20 size_t size( void )const
+		{ return m_size; }
+
+		/**
+		 * return the internal storage capacity of the array.
+		*/
+		SC_CONSTEXPR20 size_t capacity( void )const
+		{ return m_capacity; }
+
+		/**
+		 * returns true if the container contains no elements, and false otherwise.
+		*/
+		SC_CONSTEXPR20 bool empty( void )const
+		{ return m_size == 0; }
+
+		//=== [IV] Modifiers
+		/**
+		 *remove all elements from the container, calling their destructors. The capacity is kept.
+		*/
+		SC_CONSTEXPR20 void clear( void )
 		{
-			if( m_size == m_capacity )
-   				reserve( ( m_capacity == 0 ) ? 1 : (2 * m_capacity) );
-   			
-   			for( int i = m_size; i > -1 ; i-- )
-   			{
-   				data[i+1] = data[i];
-   			}
-			data[0] = value;
-			m_size++;
+			destroy( m_data, m_data + m_size );
+			m_size = 0;
 		}
 
+		/**
+		 * adds value to the front of the list.
+		 * @param value  the value to append to the list.
+		*/
+		SC_CONSTEXPR20 void push_front( const T& value )
+		{ emplace( begin(), value ); }
+
+		/**
+		 * adds value to the front of the list, moving it into place.
+		 * @param value  the value to append to the list.
+		*/
+		SC_CONSTEXPR20 void push_front( T&& value )
+		{ emplace( begin(), std::move( value ) ); }
+
 		/**
 		 * adds value to the end of the list.
 		 * @param value  the value to append to the list.
- 		*/
-   		void push_back( const T& value )
-   		{
-   			if( m_size == m_capacity )
-   				 reserve( ( m_capacity == 0 ) ? 1 : (2 * m_capacity) );
-   			data[m_size++] = value;
-   		}
-
-		/**
-		 * removes the object at the end of the list. 
- 		*/
-   		void pop_back( void )
-   		{ 
-   			if( empty() ) return;
-   			m_size--; 
-   		}
-
-		/**
-		 * removes the object at the front of the list. 
- 		*/
-   		void pop_front( void )
-   		{
-   			if( empty() ) return;
-   			for( size_t i = 0; i < m_size ; i++ )
-   			{
-   				data[i] = data[i+1];
-   			}
-   			m_size--;
-   		}
+		*/
+		SC_CONSTEXPR20 void push_back( const T& value )
+		{ emplace_back( value ); }
+
+		/**
+		 * adds value to the end of the list, moving it into place.
+		 * @param value  the value to append to the list.
+		*/
+		SC_CONSTEXPR20 void push_back( T&& value )
+		{ emplace_back( std::move( value ) ); }
+
+		/**
+		 * removes the object at the end of the list.
+		*/
+		SC_CONSTEXPR20 void pop_back( void )
+		{
+			if( empty() ) return;
+			m_size--;
+			alloc_traits::destroy( m_alloc, m_data + m_size );
+		}
+
+		/**
+		 * removes the object at the front of the list.
+		*/
+		SC_CONSTEXPR20 void pop_front( void )
+		{
+			if( empty() ) return;
+			erase( begin() );
+		}
 
 		/**
 		 *increase the storage capacity of the array to a value that’s is greater or equal to new_cap .
-		  If new_cap is greater than the current capacity() , new storage is allocated, otherwise the method does nothing. 
+		  If new_cap is greater than the current capacity() , new storage is allocated, otherwise the method does nothing.
 		  If new_cap is greater than the current capacity, all iterators and references, including the past-the-end iterator/index, are invalidated.
-		   Otherwise, no iterators or references are invalidated. This function also preserve the data elements already stored in the list, as well as their original order. 
+		   Otherwise, no iterators or references are invalidated. This function also preserve the data elements already stored in the list, as well as their original order.
 		 * @param new_cap new capacity for the vector.
- 		*/
-   		void reserve( size_t new_cap )
-   		{
-   			// Se a capacidade nova < capacidade atual, não faço nada.
-            if ( new_cap <= m_capacity ) return;
+		*/
+		SC_CONSTEXPR20 void reserve( size_t new_cap )
+		{ grow_to( new_cap, growth_cause::reserve ); }
 
-            // Passo 1: alocar nova memória com tamanho solicitado.
-            T *temp = new T[ new_cap ];
+		/**
+		 * adds value into the list before the position given by the iterator pos . The method returns an iterator to the position of the inserted item.
+		 *  @param value the object to insert.
+		*/
+		SC_CONSTEXPR20 sc::iterator<T> insert( const_iterator pos, const T& value )
+		{ return emplace( pos, value ); }
 
-            // Passo 2: copiar os dados da memória antiga para a nova.
-            std::copy( &data[0], &data[m_size],  temp );
-            //std::copy( begin(), end(), temp );
+		/**
+		 * moves value into the list before the position given by the iterator pos . The method returns an iterator to the position of the inserted item.
+		 *  @param value the object to insert.
+		*/
+		SC_CONSTEXPR20 sc::iterator<T> insert( const_iterator pos, T&& value )
+		{ return emplace( pos, std::move( value ) ); }
 
-            // Passo 3: Liberar a memória antiga.
-            delete[] data;
+		/**
+		 * inserts elements from the range [first; last) before pos . The storage grows at most once and, when it
+		 * does, the new block is built directly (prefix, range, suffix) with no shifting afterwards.
+		 * Forward ranges are measured once; input ranges are read into a buffer first unless pos is end().
+		 * [first; last) must not refer to elements of this list.
+		*/
+		template < typename InItr, typename = typename std::iterator_traits<InItr>::iterator_category >
+		SC_CONSTEXPR20 sc::iterator<T> insert( const_iterator pos, InItr first, InItr last )
+		{
+			size_t idx = pos - cbegin();
+			if( pos-cend() > 0 )
+			{
+				return sc::iterator<T>( m_data + idx );
+			}
+			typedef typename std::iterator_traits<InItr>::iterator_category category;
+			if constexpr ( std::is_base_of< std::forward_iterator_tag, category >::value )
+			{
+				size_t range = static_cast<size_t>( std::distance( first, last ) );
+				return sc::iterator<T>( insert_forward( idx, first, last, range ) );
+			}
+			else if( idx == m_size )
+			{
+				for( ; first != last; ++first )
+					emplace_back( *first );
+				return sc::iterator<T>( m_data + idx );
+			}
+			else
+			{
+				// Iterador de entrada só pode ser lido uma vez: guardar a faixa antes de abrir espaço.
+				vector buffer( 0, m_alloc );
+				for( ; first != last; ++first )
+					buffer.emplace_back( *first );
+				return sc::iterator<T>( insert_forward( idx, std::make_move_iterator( buffer.m_data ),
+				                                        std::make_move_iterator( buffer.m_data + buffer.m_size ), buffer.m_size ) );
+			}
+		}
 
-            // Passo 4: Redirecionar ponteiro para a nova (maior) memória.
-            data = temp;
+		/**
+		 *inserts elements from the initializer list ilist before pos .
+		  Initializer list supports the user of insert as in myList.insert( pos, {1, 2, 3, 4} ) ,
+		  which would insert the elements 1, 2, 3, and 4 in the list before pos , assuming that myList is a list of int .
+		*  @param pos position before position to insert a new element
+		*  @param ilist the list with the objects to insert.
+		*/
+		SC_CONSTEXPR20 sc::iterator<T> insert( const_iterator pos, std::initializer_list<T> ilist )
+		{ return insert( pos, ilist.begin(), ilist.end() ); }
 
-            // Passo 5: Atualizações internas.
-            m_capacity = new_cap;
-   		}
+		/**
+		 * inserts copies of the elements of rg (anything with begin()/end(), e.g. another container) before pos .
+		 * Same guarantees as insert( pos, first, last ).
+		*/
+		template < typename Range >
+		SC_CONSTEXPR20 sc::iterator<T> insert_range( const_iterator pos, Range&& rg )
+		{
+			using std::begin;
+			using std::end;
+			return insert( pos, begin( rg ), end( rg ) );
+		}
 
 		/**
-		 * adds value into the list before the position given by the iterator pos . The method returns an iterator to the position of the inserted item.
-		 *  @param value the object to insert. 
- 		*/
-   		sc::iterator<T> insert( sc::iterator<T> pos, const T& value )
-   		{
-   			if( m_size == m_capacity )
-   			{
-   				int pos_correct =  pos-begin();
-   				reserve( ( m_capacity == 0 ) ? 1 : (2 * m_capacity) );
-   				pos = begin()+pos_correct;
-   			}
-
-   			auto aux = end();
-   			while( aux != pos )
-   			{
-   				*aux = *(aux-1);
-   				aux--;
-   			}
-   			*pos = value;
-   			m_size++;
-   			return pos;
-   		}
-
-		/**
-		 * inserts elements from the range [first; last) before pos . 
- 		*/
-   		template < typename InItr> 
-   		sc::iterator<T> insert( sc::iterator<T> pos, InItr first, InItr last )
-   		{
-            if( pos-end() > 0 ) 
-            {
-               return pos;
-            }
-   			auto range = std::distance(first,last);
-   			if( m_size+range >= m_capacity ) 
-   			{
-   				int pos_correct =  pos-begin();
-   				reserve( ( m_capacity == 0 ) ? range : ( (2*m_capacity)+range ));
-   				pos = begin()+pos_correct;
-   			}
-
-   			m_size += range;
-   			auto aux = end();
-   			while( aux != pos )
-   			{
-               aux--;
-   				*aux = *(aux-range);
-   			}
-   			auto aux2 = first;
-   			aux = pos;
-   			while( aux2 != last )
-   			{
-   				*aux = *aux2;
-   				aux++;
-   				aux2++;
-
-   			}
-   			return pos;
-   		}
+		 * appends copies of the elements of rg to the end of the list, growing the storage at most once.
+		*/
+		template < typename Range >
+		SC_CONSTEXPR20 void append_range( Range&& rg )
+		{
+			using std::begin;
+			using std::end;
+			insert( cend(), begin( rg ), end( rg ) );
+		}
 
 		/**
-		 *inserts elements from the initializer list ilist before pos .
-		  Initializer list supports the user of insert as in myList.insert( pos, {1, 2, 3, 4} ) , 
-		  which would insert the elements 1, 2, 3, and 4 in the list before pos , assuming that myList is a list of int . 
-        @param pos position before position to insert a new element 
-		*  @param ilist the list with the objects to insert. 
- 		*/
-   		sc::iterator<T> insert( sc::iterator<T> pos, std::initializer_list<T> ilist )
-   		{
-            if( pos-end() > 0 ) 
-            {
-               return pos;
-            }
-   			if( (m_size+ilist.size()) >= m_capacity ) 
-   			{
-   				int pos_correct =  pos-begin();
-   				reserve( ( m_capacity == 0 ) ? ilist.size() : ( (2*m_capacity)+ilist.size() ));
-   				pos = begin()+pos_correct;
-   			}
-   			m_size += ilist.size();
-   			auto aux = end();
-   			while( aux != pos+(ilist.size())-1 )
-   			{
-   				*aux = *(aux-(ilist.size()));
-   				aux--;
-   			}
-   			auto aux2 = ilist.begin();
-   			aux = pos;
-   			while( aux2 != ilist.end() )
-   			{
-   				*aux = *aux2;
-   				aux++;
-   				aux2++;
-   			}
-   			return pos;
-   		}
+		 * inserts several values at several positions in one pass: *values is inserted before the element that
+		 * had index *idx_first before the call, the next value before the next index, and so on.
+		 * Indices must be sorted in non-decreasing order and <= size(); values sharing an index keep their order.
+		 * Every old element is moved at most once and the storage grows at most once, so merging k values
+		 * into a list of n elements costs O(n + k) instead of O(n * k) with repeated insert().
+		 *  @param idx_first  first of the sorted indices (bidirectional iterator over integers).
+		 *  @param idx_last   end of the indices.
+		 *  @param values     first of the values to insert, one per index (read once, in order).
+		*/
+		template < typename IndexIt, typename InItr >
+		SC_CONSTEXPR20 void insert_at( IndexIt idx_first, IndexIt idx_last, InItr values )
+		{
+			static_assert( std::is_base_of< std::bidirectional_iterator_tag, typename std::iterator_traits<IndexIt>::iterator_category >::value,
+			               "sc::vector::insert_at needs bidirectional iterators over the indices" );
+			size_t count = static_cast<size_t>( std::distance( idx_first, idx_last ) );
+			if( count == 0 ) return;
+
+			// Os valores são lidos antes de mexer na lista: podem referenciar elementos dela.
+			vector scratch( count, m_alloc );
+			for( size_t j = 0; j < count; ++j, ++values )
+				scratch.emplace_back( *values );
+
+			if( m_size + count > m_capacity )
+			{
+				size_t new_cap = GrowthPolicy::next_capacity( m_capacity, m_size + count );
+				if( !resize_in_place || m_data == nullptr )
+				{
+					realloc_insert_at( idx_first, idx_last, scratch, new_cap );
+					return;
+				}
+				// O alocador redimensiona o bloco no lugar: intercalar dentro dele.
+				grow_to( new_cap, growth_cause::insert );
+			}
+			note_shift( m_size - static_cast<size_t>( *idx_first ) );
+
+			// Da direita para a esquerda: cada bloco entre dois índices anda uma única vez.
+			if constexpr ( trivially_relocatable )
+			{
+				T* src_end = m_data + m_size;
+				for( size_t j = count; j > 0; )
+				{
+					--idx_last;
+					T* at = m_data + static_cast<size_t>( *idx_last );
+					move_bytes( at + j, at, src_end - at );
+					--j;
+					copy_bytes( at + j, scratch.m_data + j, 1 );
+					src_end = at;
+				}
+				scratch.m_size = 0; // os valores agora pertencem a esta lista.
+				m_size += count;
+			}
+			else
+			{
+				size_t src = m_size;
+				size_t dst = m_size + count;
+				size_t tail = dst; // [tail, m_size+count) já construídos na memória bruta.
+				auto place = [&]( T& value ) {
+					--dst;
+					if( dst >= m_size )
+					{
+						alloc_traits::construct( m_alloc, m_data + dst, std::move( value ) );
+						tail = dst;
+					}
+					else
+						m_data[dst] = std::move( value );
+				};
+				try {
+					for( size_t j = count; j > 0; )
+					{
+						--idx_last;
+						size_t at = static_cast<size_t>( *idx_last );
+						while( src > at )
+							place( m_data[--src] );
+						place( scratch.m_data[--j] );
+					}
+				}
+				catch( ... ) {
+					destroy( m_data + tail, m_data + m_size + count );
+					throw;
+				}
+				m_size += count;
+			}
+		}
 
 		/**
 		 * Constructs and insert one element into the underlaying array before the position given by the iterator pos.
+		 * The element is constructed in place through the allocator.
 		 * The method returns an iterator to the position of the inserted item.
-		 * TODO: implement using std::allocator
-		 *  @param pos the iterator pointing to the position right after 
+		 *  @param pos the iterator pointing to the position right after
 		 *  @param args arguments used to construct one object of type T
- 		*/
-	 		template< class... Args>
-   		void emplace( sc::iterator<T> pos, Args&&... args )
-   		{
-   			if( m_size == m_capacity )
-   			{
-   				int pos_correct =  pos-begin();
-   				reserve( ( m_capacity == 0 ) ? 1 : (2 * m_capacity) );
-   				pos = begin()+pos_correct;
-   			}
-
-   			auto aux = end();
-   			while( aux != pos )
-   			{
-   				*aux = *(aux-1);
-   				aux--;
-   			}
-
-				*pos = T(std::forward<Args>(args)...);
-   			
-   			m_size++;
-   		}
+		*/
+		template< class... Args>
+		SC_CONSTEXPR20 sc::iterator<T> emplace( const_iterator pos, Args&&... args )
+		{
+			size_t idx = pos - cbegin();
+			if( m_size == m_capacity )
+			{
+				realloc_emplace( idx, std::forward<Args>(args)... );
+			}
+			else if( idx == m_size )
+			{
+				alloc_traits::construct( m_alloc, m_data + m_size, std::forward<Args>(args)... );
+				m_size++;
+			}
+			else if constexpr ( trivially_relocatable )
+			{
+				// args pode referenciar um elemento do próprio vector: construir antes de deslocar.
+				if( sc::is_constant_evaluated() )
+				{
+					T temp( std::forward<Args>(args)... );
+					move_bytes( m_data + idx + 1, m_data + idx, m_size - idx );
+					alloc_traits::construct( m_alloc, m_data + idx, std::move( temp ) );
+				}
+				else
+				{
+					alignas(T) unsigned char buffer[sizeof(T)];
+					T* temp = reinterpret_cast<T*>( buffer );
+					alloc_traits::construct( m_alloc, temp, std::forward<Args>(args)... );
+					move_bytes( m_data + idx + 1, m_data + idx, m_size - idx );
+					copy_bytes( m_data + idx, temp, 1 );
+				}
+				note_shift( m_size - idx );
+				m_size++;
+			}
+			else
+			{
+				// args pode referenciar um elemento do próprio vector: construir antes de deslocar.
+				T temp( std::forward<Args>(args)... );
+				alloc_traits::construct( m_alloc, m_data + m_size, std::move( m_data[m_size-1] ) );
+				m_size++;
+				std::move_backward( m_data + idx, m_data + m_size - 2, m_data + m_size - 1 );
+				m_data[idx] = std::move( temp );
+				note_shift( m_size - 1 - idx );
+			}
+			return sc::iterator<T>( m_data + idx );
+		}
 
 		/**
 		 * Constructs and insert one element into the end of the underlaying array.
-		 * TODO: implement using std::allocator
+		 * The element is constructed in place through the allocator.
 		 *  @param args arguments used to construct one object of type T
- 		*/
-	 		template< class... Args>
-   		void emplace_back(Args&&... args )
-   		{
-   			if( m_size == m_capacity )
-   			{
-   				reserve( ( m_capacity == 0 ) ? 1 : (2 * m_capacity) );
-   			}
-
-   			auto aux = end();
-				*aux = T(std::forward<Args>(args)...);
-   			
-   			m_size++;
-   		}
-
-		/**
-		 * Requests the removal of unused capacity. It is a non-binding request to reduce capacity() to size() . It depends on the implementation if the request is fulﬁlled. 
- 		*/
-   		void shrink_to_fit( void )
-   		{
-   			if( m_size == m_capacity ) return;
-
-   			T *temp = new T[m_size];
-   			std::copy( &data[0], &data[m_size], temp );
-   			delete[] data;
-   			data = temp;
-   			m_capacity = m_size;
-   		}
-
-		/**
-		 *Replaces the contents with count copies of value value . 
- 		*/
-   		void assign( size_t count, const T& value )
-   		{
-   			if( count >= m_capacity )
-   				reserve( ( m_capacity == 0 ) ? count : (2*count) );
-   			m_size = count;
-   			for( size_t i = 0; i < m_size; i++ )
-   				data[i] = value;
-   		}
-
-		/**
-		 * replaces the contents of the list with copies of the elements in the range [first; last) . 
- 		*/
-   		template < typename InItr> 
-   		void assign( InItr first, InItr last )
-   		{
-   			auto range = last-first;
-   			if( range >= m_capacity )
-   				reserve( ( m_capacity == 0 ) ? range : (2*range) );
-   			m_size = range;
-   			std::copy( first, last, data);
-   		}
-		/**
-		 * replaces the contents of the list with the elements from the initializer list ilist . 
- 		*/
-   		void assign( std::initializer_list<T> ilist ) 
-   		{
-   			m_size = ilist.size();
-   			if( m_size >= m_capacity )
-   				reserve( ( m_capacity == 0 ) ? m_size : (2*m_size) );
-   			std::copy( ilist.begin(), ilist.end(), data );
-   		}
-
-		/**
-		 *removes the object at position pos . The method returns an iterator to the element that follows pos before the call. 
-		 This operation invalidates pos , since the item it pointed to was removed from the list. 
- 		*/
-   		 sc::iterator<T> erase( sc::iterator<T> pos )
-   		 {
-   		 	auto aux = pos;
-   		 	m_size--;
-   			while( aux != end() )
-   			{
-   				*(aux) = *(aux+1);
-   				aux++;
-   			}
-   			return pos;
-   		 }
+		*/
+		template< class... Args>
+		SC_CONSTEXPR20 void emplace_back( Args&&... args )
+		{
+			if( m_size == m_capacity )
+			{
+				realloc_emplace( m_size, std::forward<Args>(args)... );
+				return;
+			}
+			alloc_traits::construct( m_alloc, m_data + m_size, std::forward<Args>(args)... );
+			m_size++;
+		}
+
+		/**
+		 * Requests the removal of unused capacity. It is a non-binding request to reduce capacity() to size() . It depends on the implementation if the request is fulﬁlled.
+		*/
+		SC_CONSTEXPR20 void shrink_to_fit( void )
+		{
+			if( m_size == m_capacity ) return;
+			if( m_size == 0 )
+			{
+				// Nada a realocar: só devolver o bloco.
+				deallocate( m_data, m_capacity );
+				m_data = nullptr;
+				m_capacity = 0;
+				return;
+			}
+
+			if constexpr ( resize_in_place )
+			{
+				m_data = m_alloc.reallocate( m_data, m_capacity, m_size );
+				note_growth( growth_cause::shrink, m_capacity, m_size, 0, true );
+				m_capacity = m_size;
+				return;
+			}
+
+			T *temp = allocate( m_size );
+			try {
+				uninitialized_relocate( m_data, m_data + m_size, temp );
+			}
+			catch( ... ) {
+				deallocate( temp, m_size );
+				throw;
+			}
+			deallocate( m_data, m_capacity );
+			m_data = temp;
+			note_growth( growth_cause::shrink, m_capacity, m_size, m_size, false );
+			m_capacity = m_size;
+		}
+
+		/**
+		 *Replaces the contents with count copies of value value .
+		*/
+		SC_CONSTEXPR20 void assign( size_t count, const T& value )
+		{
+			clear();
+			grow_to( count, growth_cause::assign );
+			for( ; m_size < count; m_size++ )
+				alloc_traits::construct( m_alloc, m_data + m_size, value );
+		}
+
+		/**
+		 * replaces the contents of the list with copies of the elements in the range [first; last) .
+		*/
+		template < typename InItr, typename = typename std::iterator_traits<InItr>::iterator_category >
+		SC_CONSTEXPR20 void assign( InItr first, InItr last )
+		{
+			typedef typename std::iterator_traits<InItr>::iterator_category category;
+			if constexpr ( std::is_base_of< std::forward_iterator_tag, category >::value )
+			{
+				size_t range = static_cast<size_t>( std::distance( first, last ) );
+				clear();
+				grow_to( range, growth_cause::assign );
+				init_copy( first, last );
+			}
+			else
+			{
+				clear();
+				append_input( first, last );
+			}
+		}
+		/**
+		 * replaces the contents of the list with the elements from the initializer list ilist .
+		*/
+		SC_CONSTEXPR20 void assign( std::initializer_list<T> ilist )
+		{ assign( ilist.begin(), ilist.end() ); }
+
+		/**
+		 *removes the object at position pos . The method returns an iterator to the element that follows pos before the call.
+		 This operation invalidates pos , since the item it pointed to was removed from the list.
+		*/
+		SC_CONSTEXPR20 sc::iterator<T> erase( const_iterator pos )
+		{
+			size_t idx = pos - cbegin();
+			if constexpr ( trivially_relocatable )
+			{
+				alloc_traits::destroy( m_alloc, m_data + idx );
+				move_bytes( m_data + idx, m_data + idx + 1, m_size - idx - 1 );
+				m_size--;
+			}
+			else
+			{
+				std::move( m_data + idx + 1, m_data + m_size, m_data + idx );
+				m_size--;
+				alloc_traits::destroy( m_alloc, m_data + m_size );
+			}
+			note_shift( m_size - idx );
+			return sc::iterator<T>( m_data + idx );
+		}
 
 		/**
 		 * removes elements in the range [first; last) .
-		  The entire list may be erased by calling a.erase(a.begin(), a.end()); 
- 		*/
-   		 sc::iterator<T> erase( sc::iterator<T> first, sc::iterator<T> last )
-   		 {
-   		 	auto aux = first;
-   		 	m_size -= (last-first);
-   			while( aux != last )
-   			{
-   				*(aux) = *(aux+(last-first));
-   				aux++;
-   			}
-   			return first;
-   		 } 
-
-   		 // [V] Element access
-
-		/**
-		 * returns the object at the end of the list. 
- 		*/
-   		const T& back( void ) const
-   		{ return data[m_size-1]; }
+		  The entire list may be erased by calling a.erase(a.begin(), a.end());
+		*/
+		SC_CONSTEXPR20 sc::iterator<T> erase( const_iterator first, const_iterator last )
+		{
+			size_t idx = first - cbegin();
+			size_t count = last - first;
+			if( count == 0 )
+				return sc::iterator<T>( m_data + idx );
+			if constexpr ( trivially_relocatable )
+			{
+				destroy( m_data + idx, m_data + idx + count );
+				move_bytes( m_data + idx, m_data + idx + count, m_size - idx - count );
+			}
+			else
+			{
+				T* new_end = std::move( m_data + idx + count, m_data + m_size, m_data + idx );
+				destroy( new_end, m_data + m_size );
+			}
+			note_shift( m_size - idx - count );
+			m_size -= count;
+			return sc::iterator<T>( m_data + idx );
+		}
 
-      /**
-       * returns the object at the end of the list. 
-      */
-         T& back( void ) 
-         { return data[m_size-1]; }
+		/**
+		 * removes every element for which pred returns true, in one pass: each remaining element moves at most
+		 * once, so removing k scattered elements costs O(n) instead of the O(n * k) of repeated erase().
+		 * Trivially copyable elements are copied without a branch per element, other trivially relocatable
+		 * ones in runs with one memmove. pred is called once per element, in order.
+		 * If pred throws, the elements already matched are removed and the others are kept.
+		 *  @param shrink  if true, shrink_to_fit() is called when something was removed.
+		 *  @return the number of elements removed.
+		*/
+		template< typename Pred >
+		SC_CONSTEXPR20 size_t erase_if( Pred pred, bool shrink = false )
+		{
+			if constexpr ( std::is_trivially_copyable<T>::value )
+			{
+				if( !sc::is_constant_evaluated() )
+				{
+					// Sem destrutor a chamar: copiar sempre e avançar só nos mantidos (sem desvio por trecho).
+					size_t i = 0;
+					while( i < m_size && !pred( m_data[i] ) )
+						++i;
+					size_t first_drop = i;
+					size_t write = i;
+					if( i < m_size )
+						++i; // o primeiro removido já foi testado.
+					try {
+						for( ; i < m_size; ++i )
+						{
+							bool drop = static_cast<bool>( pred( m_data[i] ) );
+							std::memcpy( static_cast<void*>( m_data + write ), static_cast<const void*>( m_data + i ), sizeof(T) );
+							write += !drop;
+						}
+					}
+					catch( ... ) {
+						close_tail( write, i );
+						throw;
+					}
+					size_t removed = m_size - write;
+					if( removed != 0 )
+						note_shift( write - first_drop );
+					m_size = write;
+					if( shrink && removed != 0 )
+						shrink_to_fit();
+					return removed;
+				}
+			}
+			size_t write = 0; // [0, write) já compactados.
+			size_t read = 0; // [read, i) é o trecho mantido ainda não deslocado.
+			try {
+				for( size_t i = 0; i < m_size; ++i )
+				{
+					if( !pred( m_data[i] ) )
+						continue;
+					close_gap( write, read, i - read );
+					write += i - read;
+					if constexpr ( trivially_relocatable )
+						alloc_traits::destroy( m_alloc, m_data + i );
+					read = i + 1;
+				}
+			}
+			catch( ... ) {
+				close_tail( write, read );
+				throw;
+			}
+			size_t removed = close_tail( write, read );
+			if( shrink && removed != 0 )
+				shrink_to_fit();
+			return removed;
+		}
+
+		/**
+		 * removes the elements at several positions in one pass, moving every remaining element at most once.
+		 * Indices must be sorted in non-decreasing order and < size(); a repeated index is removed once.
+		 *  @param idx_first  first of the sorted indices (input iterator over integers).
+		 *  @param idx_last   end of the indices.
+		 *  @param shrink     if true, shrink_to_fit() is called when something was removed.
+		 *  @return the number of elements removed.
+		*/
+		template< typename IndexIt >
+		SC_CONSTEXPR20 size_t erase_indices( IndexIt idx_first, IndexIt idx_last, bool shrink = false )
+		{
+			size_t write = 0;
+			size_t read = 0;
+			bool first = true;
+			for( ; idx_first != idx_last; ++idx_first )
+			{
+				size_t at = static_cast<size_t>( *idx_first );
+				if( first )
+					write = read = at;
+				else if( at < read )
+					continue; // índice repetido.
+				first = false;
+				close_gap( write, read, at - read );
+				write += at - read;
+				if constexpr ( trivially_relocatable )
+					alloc_traits::destroy( m_alloc, m_data + at );
+				read = at + 1;
+			}
+			if( first )
+				return 0;
+			size_t removed = close_tail( write, read );
+			if( shrink )
+				shrink_to_fit();
+			return removed;
+		}
 
+		// [V] Element access
 
 		/**
-		 *returns the object at the beginning of the list. 
- 		*/
-   		const T& front( void ) const
-   		{ return data[0]; } 
+		 * returns a pointer to the underlying contiguous storage. [data(), data()+size()) is a valid range.
+		*/
+		SC_CONSTEXPR20 T* data( void )
+		{ return m_data; }
 
-      /**
-       *returns the object at the beginning of the list. 
-      */
-         T& front( void ) 
-         { return data[0]; }
+		/**
+		 * returns a pointer to the underlying contiguous storage. [data(), data()+size()) is a valid range.
+		*/
+		SC_CONSTEXPR20 const T* data( void ) const
+		{ return m_data; }
+
+		/**
+		 * returns the object at the end of the list.
+		*/
+		SC_CONSTEXPR20 const T& back( void ) const
+		{ return m_data[m_size-1]; }
 
 		/**
-		 *returns the object at the index pos in the array, with no bounds-checking. 
- 		*/
-   		T& operator[]( size_t pos )const{ return data[pos]; }
+		 * returns the object at the end of the list.
+		*/
+		SC_CONSTEXPR20 T& back( void )
+		{ return m_data[m_size-1]; }
+
 
 		/**
-		 *returns the object at the index pos in the array, with bounds-checking. If pos is not within the range of the list, an exception of type std::out_of_range is thrown. 
- 		*/
-   		T at( size_t pos )const
-   		{
-   			if ( pos >= m_size )
-            	throw std::out_of_range( "[vector::at() const] out of range error" );
+		 *returns the object at the beginning of the list.
+		*/
+		SC_CONSTEXPR20 const T& front( void ) const
+		{ return m_data[0]; }
 
-          	return data[ pos ];
-   		}
+		/**
+		 *returns the object at the beginning of the list.
+		*/
+		SC_CONSTEXPR20 T& front( void )
+		{ return m_data[0]; }
+
+		/**
+		 *returns the object at the index pos in the array, with no bounds-checking.
+		*/
+		SC_CONSTEXPR20 T& operator[]( size_t pos )const{ return m_data[pos]; }
+
+		/**
+		 *returns the object at the index pos in the array, with bounds-checking. If pos is not within the range of the list, an exception of type std::out_of_range is thrown.
+		*/
+		SC_CONSTEXPR20 T at( size_t pos )const
+		{
+			if ( pos >= m_size )
+				throw std::out_of_range( "[vector::at() const] out of range error" );
+
+			return m_data[ pos ];
+		}
 		/**
 		 **returns the object at the index pos in the array, with bounds-checking. If pos is not within the range of the list, an exception of type std::out_of_range is thrown.
- 		*/
-   		T& at( size_t pos )
-   		{
-   			if ( pos >= m_size )
-          		throw std::out_of_range( "[vector::at()] out of range error" );
-
-          	return data[ pos ];
-   		}
-
-   		//=== [VII] Friend functions. 
-
-		/**
-		 * extraction operator overload
- 		*/
-   		friend std::ostream& operator<<( std::ostream& os, const vector& v )
-        {
-            os << "[ ";
-            std::copy( &v.data[0], &v.data[v.m_size], std::ostream_iterator<T>( os, " " ));
-            os << "| ";
-            std::copy( &v.data[v.m_size], &v.data[v.m_capacity], std::ostream_iterator<T>( os, " " ));
-            os << "]";
-
-            return os;
-        }
-
-       	/*friend void swap( vector<T>& A, vector<T>& B )
-       	{
-       		for( int i = 0; i < std::min( A.m_size, B.m_size ); i++ )
-           		std::swap( A.data[i], B.data[i]);
-       	}*/
+		*/
+		SC_CONSTEXPR20 T& at( size_t pos )
+		{
+			if ( pos >= m_size )
+				throw std::out_of_range( "[vector::at()] out of range error" );
+
+			return m_data[ pos ];
+		}
+
+		/**
+		 * exchanges the contents of this list with those of other. No element is moved, copied or swapped.
+		*/
+		SC_CONSTEXPR20 void swap( vector& other ) noexcept
+		{
+			using std::swap;
+			if constexpr ( alloc_traits::propagate_on_container_swap::value )
+				swap( m_alloc, other.m_alloc );
+			swap( m_data, other.m_data );
+			swap( m_size, other.m_size );
+			swap( m_capacity, other.m_capacity );
+		}
+
+		//=== [VII] Friend functions.
+
+		/**
+		 * extraction operator overload. Only the constructed elements [0, size()) are printed.
+		*/
+		friend std::ostream& operator<<( std::ostream& os, const vector& v )
+		{
+			os << "[ ";
+			std::copy( v.m_data, v.m_data + v.m_size, std::ostream_iterator<T>( os, " " ));
+			os << "]";
+
+			return os;
+		}
+
+		/**
+		 * exchanges the contents of A and B in constant time.
+		*/
+		friend SC_CONSTEXPR20 void swap( vector& A, vector& B ) noexcept
+		{ A.swap( B ); }
+
+	private:
+		//=== [VIII] Raw storage helpers.
+
+		/**
+		 * obtains raw storage for n objects from the allocator. No object is constructed.
+		*/
+		SC_CONSTEXPR20 T* allocate( size_t n )
+		{ return ( n == 0 ) ? nullptr : alloc_traits::allocate( m_alloc, n ); }
+
+		/**
+		 * returns storage obtained by allocate() to the allocator.
+		*/
+		SC_CONSTEXPR20 void deallocate( T* p, size_t n )
+		{
+			if( p != nullptr )
+				alloc_traits::deallocate( m_alloc, p, n );
+		}
+
+		/**
+		 * relocates count elements from src to the raw memory at dest (the ranges do not overlap) with one memcpy.
+		 * Only for trivially relocatable types. In constant expressions, where objects cannot be copied as bytes,
+		 * each element is moved and its source destroyed.
+		*/
+		SC_CONSTEXPR20 void copy_bytes( T* dest, T* src, size_t count )
+		{
+			if( sc::is_constant_evaluated() )
+			{
+				for( size_t i = 0; i < count; ++i )
+				{
+					alloc_traits::construct( m_alloc, dest + i, std::move( src[i] ) );
+					alloc_traits::destroy( m_alloc, src + i );
+				}
+			}
+			else if( count != 0 )
+				std::memcpy( static_cast<void*>( dest ), static_cast<const void*>( src ), count * sizeof(T) );
+		}
+
+		/**
+		 * same as copy_bytes(), but the ranges may overlap (memmove). In constant expressions the elements
+		 * are relocated one by one, starting from the end that never overwrites a live source.
+		*/
+		SC_CONSTEXPR20 void move_bytes( T* dest, T* src, size_t count )
+		{
+			if( sc::is_constant_evaluated() )
+			{
+				if( dest < src )
+					copy_bytes( dest, src, count );
+				else
+					for( size_t i = count; i > 0; --i )
+					{
+						alloc_traits::construct( m_alloc, dest + i - 1, std::move( src[i-1] ) );
+						alloc_traits::destroy( m_alloc, src + i - 1 );
+					}
+			}
+			else if( count != 0 )
+				std::memmove( static_cast<void*>( dest ), static_cast<const void*>( src ), count * sizeof(T) );
+		}
+
+		/**
+		 * calls the destructor of every object in [first, last).
+		*/
+		SC_CONSTEXPR20 void destroy( T* first, T* last )
+		{
+			for( ; first != last; ++first )
+				alloc_traits::destroy( m_alloc, first );
+		}
+
+		/**
+		 * copy-constructs [first, last) into the raw memory at dest. If a constructor throws,
+		 * the objects already built are destroyed and the exception is rethrown.
+		 * @return pointer just past the last constructed object.
+		*/
+		template< typename InputIt >
+		SC_CONSTEXPR20 T* uninitialized_copy( InputIt first, InputIt last, T* dest )
+		{
+			T* cur = dest;
+			try {
+				for( ; first != last; ++first, ++cur )
+					alloc_traits::construct( m_alloc, cur, *first );
+			}
+			catch( ... ) {
+				destroy( dest, cur );
+				throw;
+			}
+			return cur;
+		}
+
+		/**
+		 * relocates [first, last) into the raw memory at dest, moving each element if its move
+		 * constructor cannot throw and copying it otherwise, so [first, last) is intact if this throws.
+		 * @return pointer just past the last constructed object.
+		*/
+		SC_CONSTEXPR20 T* uninitialized_move_if_noexcept( T* first, T* last, T* dest )
+		{
+			T* cur = dest;
+			try {
+				for( ; first != last; ++first, ++cur )
+					alloc_traits::construct( m_alloc, cur, std::move_if_noexcept( *first ) );
+			}
+			catch( ... ) {
+				destroy( dest, cur );
+				throw;
+			}
+			return cur;
+		}
+
+		/**
+		 * relocates [first, last) into the raw memory at dest: afterwards the objects live at dest and
+		 * [first, last) is raw memory. Trivially relocatable types are copied as bytes with one memcpy;
+		 * other types go through move_if_noexcept and the sources are destroyed only after every
+		 * construction succeeded, so on exception [first, last) is intact.
+		 * @return pointer just past the last relocated object.
+		*/
+		SC_CONSTEXPR20 T* uninitialized_relocate( T* first, T* last, T* dest )
+		{
+			if constexpr ( trivially_relocatable )
+			{
+				if( first != last )
+					copy_bytes( dest, first, last - first );
+				return dest + ( last - first );
+			}
+			else
+			{
+				T* end = uninitialized_move_if_noexcept( first, last, dest );
+				destroy( first, last );
+				return end;
+			}
+		}
+
+		/**
+		 * erase_if()/erase_indices() step: moves the count kept elements at read down to write. Trivially
+		 * relocatable elements go with one memmove (the removed ones were already destroyed); others are
+		 * move-assigned over the removed ones, which close_tail() destroys at the end.
+		*/
+		SC_CONSTEXPR20 void close_gap( size_t write, size_t read, size_t count )
+		{
+			if( write == read || count == 0 )
+				return;
+			if constexpr ( trivially_relocatable )
+				move_bytes( m_data + write, m_data + read, count );
+			else
+				std::move( m_data + read, m_data + read + count, m_data + write );
+			note_shift( count );
+		}
+
+		/**
+		 * finishes a compaction: moves the last kept run [read, size()) down to write and drops what is left.
+		 * @return the number of elements removed.
+		*/
+		SC_CONSTEXPR20 size_t close_tail( size_t write, size_t read )
+		{
+			close_gap( write, read, m_size - read );
+			size_t new_size = write + ( m_size - read );
+			if constexpr ( !trivially_relocatable )
+				destroy( m_data + new_size, m_data + m_size );
+			size_t removed = m_size - new_size;
+			m_size = new_size;
+			return removed;
+		}
+
+		/**
+		 * appends the elements of the input range [first, last), which can be read only once, one by one.
+		 * If a constructor throws, the list releases its storage and is left empty.
+		*/
+		template< typename InputIt >
+		SC_CONSTEXPR20 void append_input( InputIt first, InputIt last )
+		{
+			try {
+				for( ; first != last; ++first )
+					emplace_back( *first );
+			}
+			catch( ... ) {
+				destroy( m_data, m_data + m_size );
+				deallocate( m_data, m_capacity );
+				m_data = nullptr;
+				m_size = m_capacity = 0;
+				throw;
+			}
+		}
+
+		/**
+		 * fills an empty list, whose storage is already big enough, with copies of [first, last).
+		 * A range of trivially copyable T given by pointers is copied with one memcpy.
+		 * If a constructor throws, the list releases its storage and is left empty.
+		*/
+		template< typename InputIt >
+		SC_CONSTEXPR20 void init_copy( InputIt first, InputIt last )
+		{
+			if constexpr ( std::is_trivially_copyable<T>::value
+			               && ( std::is_same< InputIt, T* >::value || std::is_same< InputIt, const T* >::value ) )
+			{
+				// Cópia de outro bloco de T: um memcpy, nada pode lançar.
+				if( !sc::is_constant_evaluated() )
+				{
+					if( first != last )
+						std::memcpy( static_cast<void*>( m_data + m_size ), static_cast<const void*>( first ), ( last - first ) * sizeof(T) );
+					m_size += last - first;
+					return;
+				}
+			}
+			try {
+				for( ; first != last; ++first, ++m_size )
+					alloc_traits::construct( m_alloc, m_data + m_size, *first );
+			}
+			catch( ... ) {
+				destroy( m_data, m_data + m_size );
+				deallocate( m_data, m_capacity );
+				m_data = nullptr;
+				m_size = m_capacity = 0;
+				throw;
+			}
+		}
+
+		/**
+		 * grows the storage (capacity chosen by GrowthPolicy) and constructs a new element at index idx in a single pass:
+		 * the new element is built first (args may refer to an old element), then the
+		 * prefix and suffix are relocated around it (memcpy or move_if_noexcept). On exception
+		 * the list is unchanged; std::length_error if the allocator cannot hold one more element.
+		*/
+		template< class... Args >
+		SC_CONSTEXPR20 void realloc_emplace( size_t idx, Args&&... args )
+		{
+			// Também impede que m_size + 1 dê a volta.
+			if( m_size >= alloc_traits::max_size( m_alloc ) )
+				throw std::length_error( "sc::vector: size exceeds max_size()" );
+			size_t new_cap = GrowthPolicy::next_capacity( m_capacity, m_size + 1 );
+			if constexpr ( resize_in_place )
+			{
+				if( m_data != nullptr )
+				{
+					// O novo elemento é construído antes: args pode referenciar a memória antiga.
+					alignas(T) unsigned char buffer[sizeof(T)];
+					T* temp = reinterpret_cast<T*>( buffer );
+					alloc_traits::construct( m_alloc, temp, std::forward<Args>(args)... );
+					try {
+						m_data = m_alloc.reallocate( m_data, m_capacity, new_cap );
+					}
+					catch( ... ) {
+						alloc_traits::destroy( m_alloc, temp );
+						throw;
+					}
+					note_growth( ( idx == m_size ) ? growth_cause::append : growth_cause::insert, m_capacity, new_cap, 0, true );
+					m_capacity = new_cap;
+					move_bytes( m_data + idx + 1, m_data + idx, m_size - idx );
+					copy_bytes( m_data + idx, temp, 1 );
+					note_shift( m_size - idx );
+					m_size++;
+					return;
+				}
+			}
+			T* temp = allocate( new_cap );
+			T* cur = temp;
+			try {
+				alloc_traits::construct( m_alloc, temp + idx, std::forward<Args>(args)... );
+				if constexpr ( trivially_relocatable )
+				{
+					// Nada pode lançar daqui em diante: prefixo e sufixo vão por memcpy.
+					uninitialized_relocate( m_data, m_data + idx, temp );
+					uninitialized_relocate( m_data + idx, m_data + m_size, temp + idx + 1 );
+				}
+				else
+				{
+					try {
+						cur = uninitialized_move_if_noexcept( m_data, m_data + idx, temp );
+						uninitialized_move_if_noexcept( m_data + idx, m_data + m_size, temp + idx + 1 );
+					}
+					catch( ... ) {
+						destroy( temp, cur );
+						alloc_traits::destroy( m_alloc, temp + idx );
+						throw;
+					}
+				}
+			}
+			catch( ... ) {
+				deallocate( temp, new_cap );
+				throw;
+			}
+			if constexpr ( !trivially_relocatable )
+				destroy( m_data, m_data + m_size );
+			deallocate( m_data, m_capacity );
+			m_data = temp;
+			note_growth( ( idx == m_size ) ? growth_cause::append : growth_cause::insert, m_capacity, new_cap, m_size, false );
+			m_size++;
+			m_capacity = new_cap;
+		}
+
+		/**
+		 * inserts the count elements of the forward range [first, last) before index idx, growing the storage at
+		 * most once (see insert_grow). Without growth the tail is opened with one memmove, or for other types
+		 * the libstdc++ way: only the part of the tail that lands in raw memory is move-constructed.
+		 * @return pointer to the first inserted element.
+		*/
+		template< typename ForwardIt >
+		SC_CONSTEXPR20 T* insert_forward( size_t idx, ForwardIt first, ForwardIt last, size_t count )
+		{
+			if( count == 0 )
+				return m_data + idx;
+			if( m_size + count > m_capacity )
+			{
+				size_t new_cap = GrowthPolicy::next_capacity( m_capacity, m_size + count );
+				if( !resize_in_place || m_data == nullptr )
+				{
+					insert_grow( idx, first, last, count, new_cap );
+					return m_data + idx;
+				}
+				// O alocador redimensiona o bloco no lugar: abrir o espaço dentro dele.
+				grow_to( new_cap, ( idx == m_size ) ? growth_cause::append : growth_cause::insert );
+			}
+
+			T* p = m_data + idx;
+			T* old_end = m_data + m_size;
+			size_t elems_after = m_size - idx;
+			note_shift( elems_after );
+			if constexpr ( trivially_relocatable )
+			{
+				// Abrir o espaço com um único memmove e construir a faixa nele.
+				move_bytes( p + count, p, elems_after );
+				T* cur = p;
+				try {
+					for( ; first != last; ++first, ++cur )
+						alloc_traits::construct( m_alloc, cur, *first );
+				}
+				catch( ... ) {
+					destroy( p, cur );
+					move_bytes( p, p + count, elems_after );
+					throw;
+				}
+				m_size += count;
+			}
+			else if( elems_after > count )
+			{
+				// A cauda ultrapassa a faixa: os últimos `count` elementos vão para memória bruta.
+				uninitialized_copy( std::make_move_iterator( old_end - count ), std::make_move_iterator( old_end ), old_end );
+				m_size += count;
+				std::move_backward( p, old_end - count, old_end );
+				std::copy( first, last, p );
+			}
+			else
+			{
+				// A faixa ultrapassa a cauda: parte da faixa e toda a cauda vão para memória bruta.
+				ForwardIt mid = first;
+				std::advance( mid, elems_after );
+				T* cur = uninitialized_copy( mid, last, old_end );
+				try {
+					uninitialized_copy( std::make_move_iterator( p ), std::make_move_iterator( old_end ), cur );
+				}
+				catch( ... ) {
+					destroy( old_end, cur );
+					throw;
+				}
+				m_size += count;
+				std::copy( first, mid, p );
+			}
+			return p;
+		}
+
+		/**
+		 * moves the list into a new block of new_cap elements with the count elements of [first, last) inserted
+		 * before index idx: the range is constructed at its final place, then the prefix and suffix are relocated
+		 * around it, so no element is moved twice. On exception the list is unchanged.
+		*/
+		template< typename ForwardIt >
+		SC_CONSTEXPR20 void insert_grow( size_t idx, ForwardIt first, ForwardIt last, size_t count, size_t new_cap )
+		{
+			T* temp = allocate( new_cap );
+			T* mid = temp + idx;
+			try {
+				T* mid_end = uninitialized_copy( first, last, mid );
+				if constexpr ( trivially_relocatable )
+				{
+					uninitialized_relocate( m_data, m_data + idx, temp );
+					uninitialized_relocate( m_data + idx, m_data + m_size, mid_end );
+				}
+				else
+				{
+					T* cur = temp;
+					try {
+						cur = uninitialized_move_if_noexcept( m_data, m_data + idx, temp );
+						uninitialized_move_if_noexcept( m_data + idx, m_data + m_size, mid_end );
+					}
+					catch( ... ) {
+						destroy( temp, cur );
+						destroy( mid, mid_end );
+						throw;
+					}
+				}
+			}
+			catch( ... ) {
+				deallocate( temp, new_cap );
+				throw;
+			}
+			if constexpr ( !trivially_relocatable )
+				destroy( m_data, m_data + m_size );
+			deallocate( m_data, m_capacity );
+			m_data = temp;
+			note_growth( ( idx == m_size ) ? growth_cause::append : growth_cause::insert, m_capacity, new_cap, m_size, false );
+			m_size += count;
+			m_capacity = new_cap;
+		}
+
+		/**
+		 * insert_at() when the list must grow: builds the new block of new_cap elements left to right, alternating
+		 * a relocated block of old elements and one value taken from scratch. On exception the list is unchanged.
+		*/
+		template< typename IndexIt >
+		SC_CONSTEXPR20 void realloc_insert_at( IndexIt idx_first, IndexIt idx_last, vector& scratch, size_t new_cap )
+		{
+			T* temp = allocate( new_cap );
+			T* cur = temp;
+			size_t src = 0;
+			size_t j = 0;
+			try {
+				for( ; idx_first != idx_last; ++idx_first, ++j )
+				{
+					size_t at = static_cast<size_t>( *idx_first );
+					if constexpr ( trivially_relocatable )
+					{
+						if( at != src )
+							copy_bytes( cur, m_data + src, at - src );
+						cur += at - src;
+						copy_bytes( cur, scratch.m_data + j, 1 );
+						++cur;
+					}
+					else
+					{
+						cur = uninitialized_move_if_noexcept( m_data + src, m_data + at, cur );
+						alloc_traits::construct( m_alloc, cur, std::move( scratch.m_data[j] ) );
+						++cur;
+					}
+					src = at;
+				}
+				if constexpr ( trivially_relocatable )
+				{
+					if( m_size != src )
+						copy_bytes( cur, m_data + src, m_size - src );
+					scratch.m_size = 0; // os valores agora pertencem ao novo bloco.
+				}
+				else
+					uninitialized_move_if_noexcept( m_data + src, m_data + m_size, cur );
+			}
+			catch( ... ) {
+				destroy( temp, cur );
+				deallocate( temp, new_cap );
+				throw;
+			}
+			if constexpr ( !trivially_relocatable )
+				destroy( m_data, m_data + m_size );
+			deallocate( m_data, m_capacity );
+			m_data = temp;
+			note_growth( growth_cause::insert, m_capacity, new_cap, m_size, false );
+			m_size += j;
+			m_capacity = new_cap;
+		}
+
+		/**
+		 * reserve() with the cause reported to the instrumentation: grows the storage to exactly new_cap
+		 * elements if it is smaller, relocating the elements (or letting the allocator resize in place).
+		*/
+		SC_CONSTEXPR20 void grow_to( size_t new_cap, growth_cause cause )
+		{
+			// Se a capacidade nova < capacidade atual, não faço nada.
+			if ( new_cap <= m_capacity ) return;
+
+			// Alocador capaz de redimensionar (realloc/mremap): nenhuma cópia feita aqui.
+			if constexpr ( resize_in_place )
+			{
+				if( m_data != nullptr )
+				{
+					m_data = m_alloc.reallocate( m_data, m_capacity, new_cap );
+					note_growth( cause, m_capacity, new_cap, 0, true );
+					m_capacity = new_cap;
+					return;
+				}
+			}
+
+			// Passo 1: alocar memória bruta (nenhum objeto é construído).
+			T *temp = allocate( new_cap );
+
+			// Passo 2: realocar os dados da memória antiga para a nova (memcpy, move ou cópia).
+			try {
+				uninitialized_relocate( m_data, m_data + m_size, temp );
+			}
+			catch( ... ) {
+				deallocate( temp, new_cap );
+				throw;
+			}
+
+			// Passo 3: liberar a memória antiga.
+			deallocate( m_data, m_capacity );
+
+			// Passo 4: Redirecionar ponteiro para a nova (maior) memória.
+			m_data = temp;
+
+			// Passo 5: Atualizações internas.
+			note_growth( cause, m_capacity, new_cap, m_size, false );
+			m_capacity = new_cap;
+		}
+
+		//=== [IX] Instrumentation (no code unless Instrument::enabled).
+
+		/**
+		 * reports a new block of new_cap elements replacing one of old_cap, moved elements relocated into it.
+		*/
+		SC_CONSTEXPR20 void note_growth( growth_cause cause, size_t old_cap, size_t new_cap, size_t moved, bool in_place )
+		{
+			if constexpr ( Instrument::enabled )
+			{
+				if( new_cap != 0 )
+					m_instr.on_growth( growth_event{ cause, sizeof(T), m_size, old_cap, new_cap, moved * sizeof(T), in_place, nullptr } );
+			}
+		}
+
+		/**
+		 * reports elements moved to another slot of the same block.
+		*/
+		SC_CONSTEXPR20 void note_shift( size_t elements )
+		{
+			if constexpr ( Instrument::enabled )
+			{
+				if( elements != 0 )
+					m_instr.on_shift( elements );
+			}
+		}
+
+		/**
+		 * reports elements copied from another list.
+		*/
+		SC_CONSTEXPR20 void note_copy( size_t elements )
+		{
+			if constexpr ( Instrument::enabled )
+				m_instr.on_copy( elements * sizeof(T) );
+		}
 };
 
       /**
-       * Checks if the contents of lhs and rhs are equal, that is, whether lhs.size() == rhs.size() and each element in lhs compares equal with the element in rhs at the same position. 
+       * removes from v every element for which pred returns true, compacting the list in one pass (see vector::erase_if).
+       *  @return the number of elements removed.
+      */
+      template< typename T, typename Alloc, typename Growth, typename Instr, typename Pred >
+      SC_CONSTEXPR20 std::size_t erase_if( sc::vector<T, Alloc, Growth, Instr>& v, Pred pred, bool shrink = false )
+      { return v.erase_if( pred, shrink ); }
+
+      /**
+       * removes from v every element equal to value, compacting the list in one pass.
+       *  @return the number of elements removed.
       */
-      template< typename T>
-      bool operator==( const sc::vector<T>& lhs, const sc::vector<T>& rhs )
+      template< typename T, typename Alloc, typename Growth, typename Instr, typename U >
+      SC_CONSTEXPR20 std::size_t erase( sc::vector<T, Alloc, Growth, Instr>& v, const U& value, bool shrink = false )
+      { return v.erase_if( [&value]( const T& elem ) { return elem == value; }, shrink ); }
+
+      /**
+       * Checks if the contents of lhs and rhs are equal, that is, whether lhs.size() == rhs.size() and each element in lhs compares equal with the element in rhs at the same position.
+       * Arithmetic element types are compared with the vector kernels of simd.h (memcmp for integers).
+      */
+      template< typename T, typename Alloc, typename Growth, typename Instr >
+      SC_CONSTEXPR20 bool operator==( const sc::vector<T, Alloc, Growth, Instr>& lhs, const sc::vector<T, Alloc, Growth, Instr>& rhs )
       {
          if( lhs.size() != rhs.size() )
             return false;
-         auto l_it = lhs.cbegin();
-         auto r_it = rhs.cbegin();
-         while( l_it != lhs.cend() )
-         {
-            if( *l_it != *r_it )
-               return false;
-            l_it++;
-            r_it++;
-         }
-         return true;
+         if( sc::is_constant_evaluated() )
+            return std::equal( lhs.data(), lhs.data() + lhs.size(), rhs.data() );
+         return sc::simd::equal( lhs.data(), rhs.data(), lhs.size() );
       }
 
       /**
        * Similar to the previous operator, but the opposite result.
       */
-      template< typename T>
-      bool operator!=( const sc::vector<T>& lhs, const sc::vector<T>& rhs )
+      template< typename T, typename Alloc, typename Growth, typename Instr >
+      SC_CONSTEXPR20 bool operator!=( const sc::vector<T, Alloc, Growth, Instr>& lhs, const sc::vector<T, Alloc, Growth, Instr>& rhs )
+      { return !( lhs == rhs ); }
+
+      /**
+       * Compares the contents of lhs and rhs lexicographically.
+      */
+      template< typename T, typename Alloc, typename Growth, typename Instr >
+      SC_CONSTEXPR20 bool operator<( const sc::vector<T, Alloc, Growth, Instr>& lhs, const sc::vector<T, Alloc, Growth, Instr>& rhs )
       {
-         if( lhs.size() != rhs.size() )
-            return true;
-         auto l_it = lhs.cbegin();
-         auto r_it = rhs.cbegin();
-         while( l_it != lhs.cend() )
-         {
-            if( *l_it != *r_it )
-               return true;
-            l_it++;
-            r_it++;
-         }
-         return false;
+         if( sc::is_constant_evaluated() )
+            return std::lexicographical_compare( lhs.data(), lhs.data() + lhs.size(), rhs.data(), rhs.data() + rhs.size() );
+         return sc::simd::lexicographical_compare( lhs.data(), lhs.size(), rhs.data(), rhs.size() );
       }
+
+      /**
+       * Compares the contents of lhs and rhs lexicographically.
+      */
+      template< typename T, typename Alloc, typename Growth, typename Instr >
+      SC_CONSTEXPR20 bool operator>( const sc::vector<T, Alloc, Growth, Instr>& lhs, const sc::vector<T, Alloc, Growth, Instr>& rhs )
+      { return rhs < lhs; }
+
+      /**
+       * Compares the contents of lhs and rhs lexicographically.
+      */
+      template< typename T, typename Alloc, typename Growth, typename Instr >
+      SC_CONSTEXPR20 bool operator<=( const sc::vector<T, Alloc, Growth, Instr>& lhs, const sc::vector<T, Alloc, Growth, Instr>& rhs )
+      { return !( rhs < lhs ); }
+
+      /**
+       * Compares the contents of lhs and rhs lexicographically.
+      */
+      template< typename T, typename Alloc, typename Growth, typename Instr >
+      SC_CONSTEXPR20 bool operator>=( const sc::vector<T, Alloc, Growth, Instr>& lhs, const sc::vector<T, Alloc, Growth, Instr>& rhs )
+      { return !( lhs < rhs ); }
 }//namespace
 
-#endif
\ No newline at end of file
+#endif